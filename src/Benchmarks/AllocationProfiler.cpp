@@ -0,0 +1,459 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifdef MESHBORN_ALLOC_PROFILE
+  #include <cxxabi.h>
+  #include <dlfcn.h>
+  #include <execinfo.h>
+  #include <malloc.h>
+#endif
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <new>
+#include <thread>   // NOLINT
+#include <utility>
+#include "AllocationProfiler.h"
+
+#ifdef MESHBORN_ALLOC_PROFILE
+
+namespace {
+
+// Stages tracked, including the one for allocations outside any stage.
+const size_t MAX_STAGES = 64;
+
+// Depth of the open stages followed on the profiling thread.
+const size_t MAX_OPEN_STAGES = 32;
+
+// Frames recorded per allocation, enough to get past the standard
+// library's containers to the function using them.
+const size_t STACK_DEPTH = 12;
+
+// Distinct call stacks counted. Further stacks are only counted in the
+// stage totals.
+const size_t SITE_TABLE_SIZE = 1 << 16;
+
+struct StageCounters {
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> peakLiveBytes;
+};
+
+/**
+ * Allocations from one call stack. The slot is claimed by setting key,
+ * after which the claiming thread fills in the frames.
+ */
+struct SiteEntry {
+    std::atomic<uint64_t> key;
+    std::atomic<int> depth;
+    void *frames[STACK_DEPTH];
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> bytes;
+};
+
+std::atomic<bool> profiling(false);
+std::atomic<int64_t> liveBytes(0);
+std::atomic<size_t> currentStage(0);
+
+StageCounters stages[MAX_STAGES];
+const char *stageNames[MAX_STAGES];
+size_t stageCount = 0;
+
+// Only touched by the profiling thread, from the trace listener.
+std::thread::id profilingThread;
+size_t openStages[MAX_OPEN_STAGES];
+size_t openStageCount = 0;
+
+SiteEntry siteTable[SITE_TABLE_SIZE];
+
+// Set while recording a stack, as backtrace() may itself allocate.
+thread_local bool inHook = false;
+
+void UpdatePeak(std::atomic<uint64_t> *peak, uint64_t value) {
+    uint64_t current = peak->load(std::memory_order_relaxed);
+
+    while (current < value &&
+           !peak->compare_exchange_weak(current, value,
+                                        std::memory_order_relaxed)) {
+    }
+}
+
+void RecordSite(size_t size) {
+    void *frames[STACK_DEPTH];
+    inHook = true;
+    const int depth = backtrace(frames, STACK_DEPTH);
+    inHook = false;
+
+    // FNV-1a over the return addresses.
+    uint64_t key = 1469598103934665603ull;
+
+    for (int i = 0; i < depth; ++i) {
+        key = (key ^ reinterpret_cast<uintptr_t>(frames[i])) *
+              1099511628211ull;
+    }
+
+    key |= 1;
+
+    for (size_t probe = 0; probe < SITE_TABLE_SIZE; ++probe) {
+        SiteEntry& entry = siteTable[(key + probe) & (SITE_TABLE_SIZE - 1)];
+        uint64_t existing = entry.key.load(std::memory_order_acquire);
+
+        if (existing == 0 &&
+            entry.key.compare_exchange_strong(existing, key,
+                                              std::memory_order_acq_rel)) {
+            std::copy(frames, frames + depth, entry.frames);
+            entry.depth.store(depth, std::memory_order_release);
+            existing = key;
+        }
+
+        if (existing == key) {
+            entry.allocations.fetch_add(1, std::memory_order_relaxed);
+            entry.bytes.fetch_add(size, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+void RecordAllocation(void *pointer) {
+    const size_t size = malloc_usable_size(pointer);
+    const uint64_t live = static_cast<uint64_t>(
+        liveBytes.fetch_add(static_cast<int64_t>(size),
+                            std::memory_order_relaxed) + size);
+
+    if (!profiling.load(std::memory_order_relaxed) || inHook) {
+        return;
+    }
+
+    StageCounters& stage = stages[currentStage.load(
+        std::memory_order_relaxed)];
+    stage.allocations.fetch_add(1, std::memory_order_relaxed);
+    stage.bytes.fetch_add(size, std::memory_order_relaxed);
+    UpdatePeak(&stage.peakLiveBytes, live);
+    RecordSite(size);
+}
+
+void RecordFree(void *pointer) {
+    if (pointer) {
+        liveBytes.fetch_sub(
+            static_cast<int64_t>(malloc_usable_size(pointer)),
+            std::memory_order_relaxed);
+    }
+}
+
+void *Allocate(size_t size, size_t alignment) {
+    void *pointer;
+
+    if (alignment <= alignof(std::max_align_t)) {
+        pointer = std::malloc(size ? size : 1);
+    } else {
+        pointer = std::aligned_alloc(
+            alignment, (size + alignment - 1) / alignment * alignment);
+    }
+
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+
+    RecordAllocation(pointer);
+    return pointer;
+}
+
+void Free(void *pointer) {
+    RecordFree(pointer);
+    std::free(pointer);
+}
+
+/**
+ * Name of the function containing a return address.
+ */
+std::string GetFunctionName(void *address, bool *standardLibrary) {
+    Dl_info info;
+    *standardLibrary = false;
+
+    if (!dladdr(address, &info)) {
+        return "??";
+    }
+
+    if (info.dli_fname && strstr(info.dli_fname, "libstdc++")) {
+        *standardLibrary = true;
+    }
+
+    if (!info.dli_sname) {
+        const char *file = info.dli_fname ? info.dli_fname : "??";
+        const char *slash = strrchr(file, '/');
+        return std::string(slash ? slash + 1 : file) + "+" +
+               std::to_string(reinterpret_cast<uintptr_t>(address) -
+                              reinterpret_cast<uintptr_t>(info.dli_fbase));
+    }
+
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr,
+                                          &status);
+    std::string name = status == 0 ? demangled : info.dli_sname;
+    std::free(demangled);
+
+    // Template instances are attributed to the library that uses them, so
+    // recognise the standard library by name, ignoring the parameters.
+    const std::string qualifiedName = name.substr(0, name.find('('));
+
+    if (qualifiedName.starts_with("decltype") ||
+        qualifiedName.find("std::") != std::string::npos ||
+        qualifiedName.find("__gnu_cxx::") != std::string::npos ||
+        qualifiedName.find("operator new") != std::string::npos) {
+        *standardLibrary = true;
+    }
+
+    return name;
+}
+
+}   // namespace
+
+void *operator new(size_t size) {
+    return Allocate(size, 0);
+}
+
+void *operator new[](size_t size) {
+    return Allocate(size, 0);
+}
+
+void *operator new(size_t size, std::align_val_t alignment) {
+    return Allocate(size, static_cast<size_t>(alignment));
+}
+
+void *operator new[](size_t size, std::align_val_t alignment) {
+    return Allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void *pointer) noexcept {
+    Free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    Free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+    Free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept {
+    Free(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept {
+    Free(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept {
+    Free(pointer);
+}
+
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept {
+    Free(pointer);
+}
+
+void operator delete[](void *pointer, size_t, std::align_val_t) noexcept {
+    Free(pointer);
+}
+
+AllocationProfiler::AllocationProfiler() {
+    for (auto& stage : stages) {
+        stage.allocations = 0;
+        stage.bytes = 0;
+        stage.peakLiveBytes = 0;
+    }
+
+    for (auto& entry : siteTable) {
+        entry.key = 0;
+        entry.depth = 0;
+        entry.allocations = 0;
+        entry.bytes = 0;
+    }
+
+    stageNames[0] = "(outside stages)";
+    stageCount = 1;
+    openStageCount = 0;
+    currentStage = 0;
+    profilingThread = std::this_thread::get_id();
+
+    // The first backtrace() loads the unwinder, which allocates.
+    void *frames[STACK_DEPTH];
+    backtrace(frames, STACK_DEPTH);
+
+    profiling = true;
+}
+
+AllocationProfiler::~AllocationProfiler() {
+    Stop();
+}
+
+void AllocationProfiler::Stop() {
+    profiling = false;
+}
+
+bool AllocationProfiler::IsAvailable() {
+    return true;
+}
+
+void AllocationProfiler::OnSpanBegin(const char *name,
+                                     const char *category) {
+    if (std::this_thread::get_id() != profilingThread ||
+        strcmp(category, "parallel") == 0) {
+        return;
+    }
+
+    size_t index = 0;
+
+    while (index < stageCount && strcmp(stageNames[index], name) != 0) {
+        ++index;
+    }
+
+    if (index == stageCount) {
+        if (stageCount == MAX_STAGES) {
+            index = 0;
+        } else {
+            stageNames[stageCount++] = name;
+        }
+    }
+
+    if (openStageCount < MAX_OPEN_STAGES) {
+        openStages[openStageCount++] = index;
+        currentStage = index;
+    }
+}
+
+void AllocationProfiler::OnSpanEnd(const char *, const char *category) {
+    if (std::this_thread::get_id() != profilingThread ||
+        strcmp(category, "parallel") == 0 || openStageCount == 0) {
+        return;
+    }
+
+    openStageCount--;
+    currentStage = openStageCount ? openStages[openStageCount - 1] : 0;
+}
+
+std::vector<StageAllocations> AllocationProfiler::GetStages() const {
+    std::vector<StageAllocations> result;
+
+    for (size_t i = 0; i < stageCount; ++i) {
+        result.push_back({stageNames[i], stages[i].allocations.load(),
+                          stages[i].bytes.load(),
+                          stages[i].peakLiveBytes.load()});
+    }
+
+    return result;
+}
+
+/**
+ * Groups the recorded call stacks by the first function outside the
+ * standard library and returns those making the most allocations.
+ */
+std::vector<AllocationSite> AllocationProfiler::GetTopSites(
+    size_t count) const {
+    std::map<std::pair<std::string, std::string>, AllocationSite> sites;
+
+    for (const auto& entry : siteTable) {
+        const int depth = entry.depth.load(std::memory_order_acquire);
+
+        if (!entry.key.load() || !depth) {
+            continue;
+        }
+
+        std::string function = "(standard library)";
+        std::string via;
+        int first = 1;
+
+        // Skip this file's hook, up to the replaced operator new.
+        for (int i = 0; i < std::min(depth, 6); ++i) {
+            bool standardLibrary;
+
+            if (GetFunctionName(entry.frames[i], &standardLibrary)
+                    .starts_with("operator new")) {
+                first = i + 1;
+            }
+        }
+
+        for (int i = first; i < depth; ++i) {
+            bool standardLibrary;
+            std::string name = GetFunctionName(entry.frames[i],
+                                               &standardLibrary);
+
+            if (!standardLibrary) {
+                function = name;
+                break;
+            }
+
+            via = name.substr(0, name.find('('));
+        }
+
+        AllocationSite& site = sites[{function, via}];
+        site.function = function;
+        site.via = via;
+        site.allocations += entry.allocations.load();
+        site.bytes += entry.bytes.load();
+    }
+
+    std::vector<AllocationSite> result;
+
+    for (auto& site : sites) {
+        result.push_back(std::move(site.second));
+    }
+
+    std::sort(result.begin(), result.end(),
+              [](const AllocationSite& a, const AllocationSite& b) {
+                  return a.allocations > b.allocations;
+              });
+
+    if (result.size() > count) {
+        result.resize(count);
+    }
+
+    return result;
+}
+
+#else
+
+AllocationProfiler::AllocationProfiler() {
+}
+
+AllocationProfiler::~AllocationProfiler() {
+}
+
+void AllocationProfiler::Stop() {
+}
+
+bool AllocationProfiler::IsAvailable() {
+    return false;
+}
+
+void AllocationProfiler::OnSpanBegin(const char *, const char *) {
+}
+
+void AllocationProfiler::OnSpanEnd(const char *, const char *) {
+}
+
+std::vector<StageAllocations> AllocationProfiler::GetStages() const {
+    return {};
+}
+
+std::vector<AllocationSite> AllocationProfiler::GetTopSites(size_t) const {
+    return {};
+}
+
+#endif
@@ -0,0 +1,86 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef ALLOCATIONPROFILER_H_
+#define ALLOCATIONPROFILER_H_
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Trace.h"
+
+/**
+ * Heap allocations made while one stage of a load was the innermost open
+ * stage, by any thread.
+ */
+struct StageAllocations {
+    std::string name;
+    uint64_t allocations;
+    uint64_t bytes;
+
+    // Highest total of live heap bytes reached during the stage.
+    uint64_t peakLiveBytes;
+};
+
+/**
+ * Allocations made from one function of the library or benchmark, the
+ * first caller outside the standard library.
+ */
+struct AllocationSite {
+    AllocationSite() : allocations(0), bytes(0) {}
+
+    std::string function;
+
+    // Standard library function the allocation was made through, if any.
+    std::string via;
+
+    uint64_t allocations;
+    uint64_t bytes;
+};
+
+/**
+ * Counts the heap allocations made through operator new during each stage
+ * of a load, using the trace spans reported on the thread that created
+ * it to follow the stages.
+ *
+ * Only functional when the benchmarks are built with
+ * MESHBORN_ALLOC_PROFILE (configure --enable-alloc-profile), which
+ * replaces the global operator new and delete. Recording call stacks
+ * makes allocation expensive, so loads run far slower while profiling.
+ */
+class AllocationProfiler : public Meshborn::ITraceListener {
+ public:
+    AllocationProfiler();
+
+    ~AllocationProfiler() override;
+
+    static bool IsAvailable();
+
+    // Stops counting, so that reporting does not count itself.
+    void Stop();
+
+    void OnSpanBegin(const char *name, const char *category) override;
+
+    void OnSpanEnd(const char *name, const char *category) override;
+
+    // Totals of each stage, the first being allocations made outside any.
+    std::vector<StageAllocations> GetStages() const;
+
+    std::vector<AllocationSite> GetTopSites(size_t count) const;
+};
+
+#endif  // ALLOCATIONPROFILER_H_
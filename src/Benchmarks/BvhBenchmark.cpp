@@ -0,0 +1,254 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>   // NOLINT
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>   // NOLINT
+#include <vector>
+#include "BoundingVolumeHierarchy.h"
+#include "WaveFrontObjParser.h"
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Builds a deterministic height field of roughly the requested number of
+ * triangles, used when no .obj file is given.
+ */
+std::unique_ptr<Meshborn::Model> CreateHeightField(size_t triangles) {
+    auto model = std::make_unique<Meshborn::Model>();
+    size_t size = std::max<size_t>(1, static_cast<size_t>(
+        std::sqrt(static_cast<double>(triangles) / 2.0)));
+
+    Meshborn::Mesh mesh;
+    mesh.name = "heightfield";
+
+    auto height = [](size_t x, size_t z) {
+        return 0.5f * std::sin(x * 0.11f) * std::cos(z * 0.07f) +
+               0.1f * std::sin(x * 0.53f + z * 0.29f);
+    };
+
+    auto addCorner = [&](size_t x, size_t z) {
+        Meshborn::Vertex vertex;
+        vertex.position = Meshborn::Point4D(
+            static_cast<float>(x) / size, height(x, z),
+            static_cast<float>(z) / size, 1.0f);
+        mesh.vertices.push_back(vertex);
+
+        Meshborn::PolygonalFaceElement element;
+        element.vertex = static_cast<int>(z * (size + 1) + x + 1);
+        return element;
+    };
+
+    for (size_t z = 0; z < size; ++z) {
+        for (size_t x = 0; x < size; ++x) {
+            Meshborn::PolygonalFace first;
+            first.elements.push_back(addCorner(x, z));
+            first.elements.push_back(addCorner(x + 1, z));
+            first.elements.push_back(addCorner(x + 1, z + 1));
+            mesh.faces.push_back(first);
+
+            Meshborn::PolygonalFace second;
+            second.elements.push_back(addCorner(x, z));
+            second.elements.push_back(addCorner(x + 1, z + 1));
+            second.elements.push_back(addCorner(x, z + 1));
+            mesh.faces.push_back(second);
+        }
+    }
+
+    mesh.UpdateBounds();
+    model->meshes.push_back(std::move(mesh));
+    model->totalMeshes = model->meshes.size();
+    model->UpdateBounds();
+    return model;
+}
+
+/**
+ * Generates rays from points around the model's bounding sphere towards
+ * random points inside its bounding box, so that most rays hit geometry.
+ */
+std::vector<Meshborn::Ray> CreateRays(const Meshborn::Model& model,
+                                      size_t count) {
+    std::mt19937 generator(1977);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+
+    const auto& box = model.boundingBox;
+    const auto& sphere = model.boundingSphere;
+    std::vector<Meshborn::Ray> rays;
+    rays.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        float dx = normal(generator);
+        float dy = normal(generator);
+        float dz = normal(generator);
+        float length = std::max(1e-6f, std::sqrt(dx * dx + dy * dy + dz * dz));
+        float distance = 2.0f * std::max(sphere.radius, 1e-3f) / length;
+
+        Meshborn::Point3D origin(sphere.centre.x + dx * distance,
+                                 sphere.centre.y + dy * distance,
+                                 sphere.centre.z + dz * distance);
+        Meshborn::Point3D target(
+            box.min.x + (box.max.x - box.min.x) * unit(generator),
+            box.min.y + (box.max.y - box.min.y) * unit(generator),
+            box.min.z + (box.max.z - box.min.z) * unit(generator));
+
+        rays.emplace_back(origin, Meshborn::Point3D(target.x - origin.x,
+                                                    target.y - origin.y,
+                                                    target.z - origin.z));
+    }
+
+    return rays;
+}
+
+/**
+ * Traces every ray on the given number of threads and reports the number
+ * of rays traced per second.
+ */
+double MeasureQueries(const Meshborn::BoundingVolumeHierarchy& bvh,
+                      const std::vector<Meshborn::Ray>& rays,
+                      unsigned int threads, bool occlusion, size_t *hits) {
+    std::atomic<size_t> totalHits = 0;
+    std::vector<std::thread> workers;
+    const size_t chunk = (rays.size() + threads - 1) / threads;
+
+    auto start = Clock::now();
+
+    for (unsigned int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            size_t localHits = 0;
+            size_t end = std::min(rays.size(), (t + 1) * chunk);
+
+            for (size_t i = t * chunk; i < end; ++i) {
+                Meshborn::RayHit hit;
+                if (occlusion ? bvh.IsOccluded(rays[i])
+                              : bvh.Intersect(rays[i], &hit)) {
+                    localHits++;
+                }
+            }
+
+            totalHits += localHits;
+        });
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    *hits = totalHits;
+    return rays.size() / elapsed.count();
+}
+
+int main(int argc, char** argv) {
+    std::string filename;
+    size_t triangles = 1000000;
+    size_t rayCount = 1000000;
+    unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+    int repetitions = 3;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if ((arg == "-f" || arg == "--file") && i + 1 < argc) {
+            filename = argv[++i];
+        } else if (arg == "--triangles" && i + 1 < argc) {
+            triangles = std::stoul(argv[++i]);
+        } else if (arg == "--rays" && i + 1 < argc) {
+            rayCount = std::stoul(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            repetitions = std::max(1, std::stoi(argv[++i]));
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [-f <filename>] "
+                      << "[--triangles <count>] [--rays <count>] "
+                      << "[--threads <count>] [--repetitions <count>]\n";
+            return 1;
+        }
+    }
+
+    std::unique_ptr<Meshborn::Model> model;
+
+    try {
+        model = filename.empty() ? CreateHeightField(triangles)
+                                 : Meshborn::WaveFrontObjParser().ParseObj(
+                                       filename);
+    }
+    catch (const std::runtime_error& ex) {
+        std::cerr << "[EXCEPTION] " << ex.what() << "\n";
+        return 1;
+    }
+
+    if (!model) {
+        std::cerr << "Failed to load '" << filename << "'\n";
+        return 1;
+    }
+
+    Meshborn::BvhBuildOptions options;
+    options.threadCount = threads;
+    Meshborn::BoundingVolumeHierarchy bvh(options);
+
+    double bestBuild = 0.0;
+    for (int i = 0; i < repetitions; ++i) {
+        auto start = Clock::now();
+        if (!bvh.Build(*model)) {
+            std::cerr << "Failed to build BVH\n";
+            return 1;
+        }
+        std::chrono::duration<double, std::milli> elapsed =
+            Clock::now() - start;
+        bestBuild = i ? std::min(bestBuild, elapsed.count())
+                      : elapsed.count();
+    }
+
+    std::cout << "triangles:        " << bvh.GetTriangleCount() << "\n"
+              << "nodes:            " << bvh.GetNodes().size() << "\n"
+              << "build (ms):       " << bestBuild << "\n"
+              << "build (Mtri/s):   "
+              << bvh.GetTriangleCount() / bestBuild / 1000.0 << "\n";
+
+    auto rays = CreateRays(*model, rayCount);
+
+    for (unsigned int threadCount : { 1u, threads }) {
+        for (bool occlusion : { false, true }) {
+            size_t hits = 0;
+            double best = 0.0;
+
+            for (int i = 0; i < repetitions; ++i) {
+                best = std::max(best, MeasureQueries(bvh, rays, threadCount,
+                                                     occlusion, &hits));
+            }
+
+            std::cout << (occlusion ? "occlusion" : "closest hit")
+                      << " x" << threadCount << " (Mrays/s): "
+                      << best / 1e6 << "  [hits " << hits << "/"
+                      << rays.size() << "]\n";
+        }
+
+        if (threads == 1) {
+            break;
+        }
+    }
+
+    return 0;
+}
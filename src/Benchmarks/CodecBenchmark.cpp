@@ -0,0 +1,220 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <chrono>   // NOLINT
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "GeometryCodec.h"
+#include "VertexEncoder.h"
+#include "WaveFrontObjParser.h"
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Builds a consolidated height field of roughly the requested number of
+ * vertices, used when no .obj file is given.
+ */
+std::unique_ptr<Meshborn::Model> CreateHeightField(size_t vertices) {
+    auto model = std::make_unique<Meshborn::Model>();
+    size_t size = std::max<size_t>(2, static_cast<size_t>(
+        std::sqrt(static_cast<double>(vertices))));
+
+    for (size_t z = 0; z < size; ++z) {
+        for (size_t x = 0; x < size; ++x) {
+            float fx = static_cast<float>(x) / size;
+            float fz = static_cast<float>(z) / size;
+            float dx = 0.055f * std::cos(x * 0.11f) * std::cos(z * 0.07f);
+            float dz = -0.035f * std::sin(x * 0.11f) * std::sin(z * 0.07f);
+            float length = std::sqrt(dx * dx + 1.0f + dz * dz);
+
+            Meshborn::Vertex vertex;
+            vertex.position = Meshborn::Point4D(
+                fx, 0.5f * std::sin(x * 0.11f) * std::cos(z * 0.07f), fz,
+                1.0f);
+            vertex.normal = Meshborn::Point3D(-dx / length, 1.0f / length,
+                                              -dz / length);
+            vertex.textureCoordinates = Meshborn::TextureCoordinates(
+                fx * 4.0f, fz * 4.0f, 0.0f);
+            model->vertexBuffer.push_back(vertex);
+        }
+    }
+
+    for (size_t z = 0; z + 1 < size; ++z) {
+        for (size_t x = 0; x + 1 < size; ++x) {
+            uint32_t a = static_cast<uint32_t>(z * size + x);
+            uint32_t b = a + 1;
+            uint32_t c = a + static_cast<uint32_t>(size) + 1;
+            uint32_t d = a + static_cast<uint32_t>(size);
+            model->indexBuffer.insert(model->indexBuffer.end(),
+                                      { a, b, c, a, c, d });
+        }
+    }
+
+    Meshborn::Mesh mesh;
+    mesh.name = "heightfield";
+    mesh.vertexCount = model->vertexBuffer.size();
+    mesh.indexCount = model->indexBuffer.size();
+    model->meshes.push_back(std::move(mesh));
+    model->totalMeshes = model->meshes.size();
+    model->consolidated = true;
+    return model;
+}
+
+/**
+ * Encodes and decodes one stream, checks that it survives the round trip
+ * and reports its compression ratio and decode throughput.
+ */
+template <typename EncodeFunction, typename DecodeFunction>
+bool MeasureStream(const std::string& name, const void *raw, size_t rawSize,
+                   int repetitions, EncodeFunction encode,
+                   DecodeFunction decode) {
+    std::vector<uint8_t> encoded;
+
+    auto start = Clock::now();
+    if (!encode(&encoded)) {
+        std::cerr << "Failed to encode " << name << "\n";
+        return false;
+    }
+    std::chrono::duration<double> encodeTime = Clock::now() - start;
+
+    std::vector<uint8_t> decoded(rawSize);
+    double bestDecode = 0.0;
+
+    for (int i = 0; i < repetitions; ++i) {
+        start = Clock::now();
+        if (!decode(encoded, decoded.data())) {
+            std::cerr << "Failed to decode " << name << "\n";
+            return false;
+        }
+        std::chrono::duration<double> elapsed = Clock::now() - start;
+        bestDecode = i ? std::min(bestDecode, elapsed.count())
+                       : elapsed.count();
+    }
+
+    if (rawSize > 0 && std::memcmp(raw, decoded.data(), rawSize) != 0) {
+        std::cerr << name << " did not survive the round trip\n";
+        return false;
+    }
+
+    const double megabytes = rawSize / 1e6;
+    std::cout << name << ": " << rawSize << " -> " << encoded.size()
+              << " bytes (x"
+              << static_cast<double>(rawSize) /
+                 std::max<size_t>(1, encoded.size())
+              << ")  encode " << megabytes / encodeTime.count() << " MB/s"
+              << "  decode " << megabytes / bestDecode << " MB/s\n";
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::string filename;
+    size_t vertices = 1000000;
+    int repetitions = 5;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if ((arg == "-f" || arg == "--file") && i + 1 < argc) {
+            filename = argv[++i];
+        } else if (arg == "--vertices" && i + 1 < argc) {
+            vertices = std::stoul(argv[++i]);
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            repetitions = std::max(1, std::stoi(argv[++i]));
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [-f <filename>] "
+                      << "[--vertices <count>] [--repetitions <count>]\n";
+            return 1;
+        }
+    }
+
+    std::unique_ptr<Meshborn::Model> model;
+
+    try {
+        Meshborn::ParseOptions options;
+        options.consolidateBuffers = true;
+        model = filename.empty() ? CreateHeightField(vertices)
+                                 : Meshborn::WaveFrontObjParser(options)
+                                       .ParseObj(filename);
+    }
+    catch (const std::runtime_error& ex) {
+        std::cerr << "[EXCEPTION] " << ex.what() << "\n";
+        return 1;
+    }
+
+    if (!model) {
+        std::cerr << "Failed to load '" << filename << "'\n";
+        return 1;
+    }
+
+    const auto& indices = model->indexBuffer;
+    const auto& raw = model->vertexBuffer;
+
+    Meshborn::EncodedVertexBuffer packed;
+    if (!Meshborn::VertexEncoder().Encode(*model, &packed)) {
+        std::cerr << "Failed to pack vertices\n";
+        return 1;
+    }
+
+    bool ok = MeasureStream(
+        "indices", indices.data(), indices.size() * sizeof(uint32_t),
+        repetitions,
+        [&](std::vector<uint8_t> *output) {
+            Meshborn::GeometryCodec::EncodeIndices(indices.data(),
+                                                   indices.size(), output);
+            return true;
+        },
+        [&](const std::vector<uint8_t>& input, uint8_t *output) {
+            return Meshborn::GeometryCodec::DecodeIndices(
+                input.data(), input.size(),
+                reinterpret_cast<uint32_t *>(output), indices.size());
+        });
+
+    ok = ok && MeasureStream(
+        "vertices (float)", raw.data(), raw.size() * sizeof(Meshborn::Vertex),
+        repetitions,
+        [&](std::vector<uint8_t> *output) {
+            return Meshborn::GeometryCodec::EncodeVertices(
+                raw.data(), raw.size(), sizeof(Meshborn::Vertex), output);
+        },
+        [&](const std::vector<uint8_t>& input, uint8_t *output) {
+            return Meshborn::GeometryCodec::DecodeVertices(
+                input.data(), input.size(), output, raw.size(),
+                sizeof(Meshborn::Vertex));
+        });
+
+    const size_t stride = packed.layout.stride;
+    const size_t packedCount = packed.data.size() / stride;
+
+    ok = ok && MeasureStream(
+        "vertices (packed)", packed.data.data(), packed.data.size(),
+        repetitions,
+        [&](std::vector<uint8_t> *output) {
+            return Meshborn::GeometryCodec::EncodeVertices(
+                packed.data.data(), packedCount, stride, output);
+        },
+        [&](const std::vector<uint8_t>& input, uint8_t *output) {
+            return Meshborn::GeometryCodec::DecodeVertices(
+                input.data(), input.size(), output, packedCount, stride);
+        });
+
+    return ok ? 0 : 1;
+}
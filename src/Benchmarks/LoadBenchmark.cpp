@@ -0,0 +1,658 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <sys/resource.h>
+#include <algorithm>
+#include <chrono>   // NOLINT
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>   // NOLINT
+#include <utility>
+#include <vector>
+#include "AllocationProfiler.h"
+#include "GzipDecoder.h"
+#include "ObjGenerator.h"
+#include "PerfCounters.h"
+#include "Trace.h"
+#include "WaveFrontObjParser.h"
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Prints the phase timings and counters of the last run.
+ */
+void PrintParseStats(const Meshborn::ParseStats& stats) {
+    std::cout << "Phases (last run):\n";
+
+    for (size_t i = 0; i < Meshborn::PARSE_PHASE_COUNT; ++i) {
+        if (stats.phaseSeconds[i] > 0.0) {
+            std::cout << "  " << Meshborn::ParseStats::GetPhaseName(
+                             static_cast<Meshborn::ParsePhase>(i))
+                      << ": " << stats.phaseSeconds[i] * 1000.0 << " ms\n";
+        }
+    }
+
+    std::cout << "Lines (last run):\n";
+
+    for (size_t i = 0; i < Meshborn::PARSE_KEYWORD_COUNT; ++i) {
+        if (stats.lines[i]) {
+            std::cout << "  " << Meshborn::ParseStats::GetKeywordName(
+                             static_cast<Meshborn::ParseKeyword>(i))
+                      << ": " << stats.lines[i] << " lines, "
+                      << stats.lineSeconds[i] * 1e9 / stats.lines[i]
+                      << " ns/line\n";
+        }
+    }
+
+    std::cout << "Faces: " << stats.faces[0] << " triangles, "
+              << stats.faces[1] << " quads, " << stats.faces[2]
+              << " n-gons\n"
+              << "Meshes: " << stats.meshesCreated << ", materials: "
+              << stats.materialsCreated << "\n"
+              << "Bytes read: " << stats.bytesRead << ", allocated: "
+              << stats.bytesAllocated << "\n";
+}
+
+/**
+ * Counter totals of one stage of the load, summed over the runs.
+ */
+struct StageCounters {
+    std::string name;
+    PerfSample sample;
+};
+
+/**
+ * Reads the perf counters around each stage of a load, using the trace
+ * spans the library reports on the benchmark's own thread. Worker threads
+ * are counted within the stage that started them, as the counters are
+ * inherited by threads created after they were opened.
+ */
+class StageCounterListener : public Meshborn::ITraceListener {
+ public:
+    explicit StageCounterListener(const PerfCounters& counters)
+        : counters_(counters), thread_(std::this_thread::get_id()) {}
+
+    void OnSpanBegin(const char *name, const char *category) override {
+        if (!IsStage(category)) {
+            return;
+        }
+
+        size_t index = 0;
+
+        while (index < stages_.size() && stages_[index].name != name) {
+            ++index;
+        }
+
+        if (index == stages_.size()) {
+            stages_.push_back({name, PerfSample()});
+        }
+
+        open_.push_back({index, counters_.Read()});
+    }
+
+    void OnSpanEnd(const char *, const char *category) override {
+        if (!IsStage(category) || open_.empty()) {
+            return;
+        }
+
+        const PerfSample end = counters_.Read();
+        stages_[open_.back().first].sample += end - open_.back().second;
+        open_.pop_back();
+    }
+
+    const std::vector<StageCounters>& GetStages() const {
+        return stages_;
+    }
+
+ private:
+    bool IsStage(const char *category) const {
+        return std::this_thread::get_id() == thread_ &&
+               strcmp(category, "parallel") != 0;
+    }
+
+    const PerfCounters& counters_;
+    std::thread::id thread_;
+    std::vector<StageCounters> stages_;
+    std::vector<std::pair<size_t, PerfSample>> open_;
+};
+
+/**
+ * Prints the memory held by the loaded model, by category, before and
+ * after Model::Compact().
+ */
+void PrintMemoryUsage(const Meshborn::ModelMemoryUsage& loaded,
+                      const Meshborn::ModelMemoryUsage& compacted) {
+    const std::pair<const char *,
+                    Meshborn::MemoryUsage Meshborn::ModelMemoryUsage::*>
+        categories[] = {
+        {"meshes", &Meshborn::ModelMemoryUsage::meshes},
+        {"faces", &Meshborn::ModelMemoryUsage::faces},
+        {"vertices", &Meshborn::ModelMemoryUsage::vertices},
+        {"buffers", &Meshborn::ModelMemoryUsage::buffers},
+        {"strings", &Meshborn::ModelMemoryUsage::strings},
+        {"materials", &Meshborn::ModelMemoryUsage::materials},
+        {"instances", &Meshborn::ModelMemoryUsage::instances}
+    };
+
+    std::printf("%-22s %12s %12s %16s\n", "Model memory", "used MB",
+                "reserved MB", "compacted MB");
+
+    for (const auto& [name, member] : categories) {
+        std::printf("%-22s %12.3f %12.3f %16.3f\n", name,
+                    (loaded.*member).usedBytes / 1e6,
+                    (loaded.*member).reservedBytes / 1e6,
+                    (compacted.*member).reservedBytes / 1e6);
+    }
+
+    std::printf("%-22s %12.3f %12.3f %16.3f\n", "total",
+                loaded.GetTotal().usedBytes / 1e6,
+                loaded.GetTotal().reservedBytes / 1e6,
+                compacted.GetTotal().reservedBytes / 1e6);
+}
+
+/**
+ * Passes the library's trace spans on to each of the benchmark's
+ * listeners, which it does not own.
+ */
+class TraceListenerGroup : public Meshborn::ITraceListener {
+ public:
+    void Add(Meshborn::ITraceListener *listener) {
+        listeners_.push_back(listener);
+    }
+
+    bool IsEmpty() const {
+        return listeners_.empty();
+    }
+
+    void OnSpanBegin(const char *name, const char *category) override {
+        for (auto *listener : listeners_) {
+            listener->OnSpanBegin(name, category);
+        }
+    }
+
+    void OnSpanEnd(const char *name, const char *category) override {
+        for (auto it = listeners_.rbegin(); it != listeners_.rend(); ++it) {
+            (*it)->OnSpanEnd(name, category);
+        }
+    }
+
+ private:
+    std::vector<Meshborn::ITraceListener *> listeners_;
+};
+
+/**
+ * Prints the heap allocations of each stage and the sites making the most
+ * allocations, per run.
+ */
+void PrintAllocations(const std::vector<StageAllocations>& stages,
+                      const std::vector<AllocationSite>& sites,
+                      int runs, size_t faces) {
+    std::printf("%-22s %14s %12s %14s %12s\n", "Allocations per run",
+                "allocations", "MB", "peak live MB", "per face");
+
+    for (const auto& stage : stages) {
+        const double allocations =
+            stage.allocations / static_cast<double>(runs);
+
+        std::printf("%-22s %14.0f %12.3f %14.3f %12.3f\n",
+                    stage.name.c_str(), allocations,
+                    stage.bytes / 1e6 / runs, stage.peakLiveBytes / 1e6,
+                    faces ? allocations / faces : 0.0);
+    }
+
+    std::printf("Top allocation sites per run:\n");
+
+    for (const auto& site : sites) {
+        std::string function = site.function;
+
+        if (function.size() > 90) {
+            function = function.substr(0, 87) + "...";
+        }
+
+        std::printf("%12.0f %12.3f MB  %s\n",
+                    site.allocations / static_cast<double>(runs),
+                    site.bytes / 1e6 / runs, function.c_str());
+
+        if (!site.via.empty()) {
+            std::printf("%29s via %s\n", "",
+                        site.via.substr(0, 90).c_str());
+        }
+    }
+}
+
+/**
+ * Prints the counters of each stage per run, normalised per byte of text,
+ * after decompression, and per face emitted.
+ */
+void PrintStageCounters(const PerfCounters& counters,
+                        const std::vector<StageCounters>& stages,
+                        int runs, double bytes, size_t faces) {
+    auto value = [&](const StageCounters& stage, PerfCounter counter) {
+        return stage.sample.values[static_cast<size_t>(counter)] /
+               static_cast<double>(runs);
+    };
+    auto print = [&](const StageCounters& stage, PerfCounter counter,
+                     double divisor) {
+        if (counters.IsAvailable(counter) && divisor > 0.0) {
+            std::printf(" %12.3f", value(stage, counter) / divisor);
+        } else {
+            std::printf(" %12s", "n/a");
+        }
+    };
+
+    std::printf("%-22s %12s %12s %12s %12s %12s %12s %12s\n",
+                "Counters per run", "cpu ms", "IPC", "cycles/B",
+                "instr/B", "cycles/face", "brmiss/face", "LLCmiss/face");
+
+    for (const auto& stage : stages) {
+        const double cycles = value(stage, PerfCounter::CYCLES);
+
+        std::printf("%-22s", stage.name.c_str());
+        print(stage, PerfCounter::TASK_CLOCK, 1e6);
+        print(stage, PerfCounter::INSTRUCTIONS, cycles);
+        print(stage, PerfCounter::CYCLES, bytes);
+        print(stage, PerfCounter::INSTRUCTIONS, bytes);
+        print(stage, PerfCounter::CYCLES, static_cast<double>(faces));
+        print(stage, PerfCounter::BRANCH_MISSES,
+              static_cast<double>(faces));
+        print(stage, PerfCounter::LLC_MISSES, static_cast<double>(faces));
+        std::printf("\n");
+    }
+}
+
+/**
+ * Returns the peak resident set size of the process so far in megabytes.
+ */
+double GetPeakResidentMegabytes() {
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+
+#ifdef __APPLE__
+    // Reported in bytes on macOS and in kilobytes elsewhere.
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    return usage.ru_maxrss / 1024.0;
+#endif
+}
+
+/**
+ * Returns the size in bytes of the text the parser reads from a file,
+ * inflating it first when it is gzip compressed, so that throughput is
+ * measured against the same bytes for plain and compressed files.
+ */
+bool GetTextBytes(const std::string& filename, uint64_t *bytes) {
+    std::ifstream file(filename, std::ios::binary);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)),
+                              std::istreambuf_iterator<char>());
+
+    if (!Meshborn::GzipDecoder::IsGzip(data.data(), data.size())) {
+        *bytes = data.size();
+        return true;
+    }
+
+    uint64_t inflated = 0;
+    Meshborn::GzipDecoder decoder;
+    const bool decoded = decoder.Decode(data.data(), data.size(),
+        [&inflated](const char *, size_t size) {
+            inflated += size;
+            return true;
+        });
+
+    *bytes = inflated;
+    return decoded;
+}
+
+bool ParseFaceMix(const std::string& mix, ObjGeneratorOptions *options) {
+    unsigned int weights[3];
+
+    if (std::sscanf(mix.c_str(), "%u,%u,%u", &weights[0], &weights[1],
+                    &weights[2]) != 3) {
+        return false;
+    }
+
+    options->triangleWeight = weights[0];
+    options->quadWeight = weights[1];
+    options->polygonWeight = weights[2];
+    return true;
+}
+
+bool ParseFaceFormat(const std::string& format, ObjFaceFormat *faceFormat) {
+    if (format == "v") {
+        *faceFormat = ObjFaceFormat::POSITION;
+    } else if (format == "vt") {
+        *faceFormat = ObjFaceFormat::POSITION_TEXTURE;
+    } else if (format == "vn") {
+        *faceFormat = ObjFaceFormat::POSITION_NORMAL;
+    } else if (format == "vtvn") {
+        *faceFormat = ObjFaceFormat::POSITION_TEXTURE_NORMAL;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+bool EnableStep(const std::string& step, Meshborn::ParseOptions *options) {
+    if (step == "coalesce") {
+        options->coalesceMeshes = true;
+    } else if (step == "weld") {
+        options->weldVertices = true;
+    } else if (step == "clean") {
+        options->cleanMeshes = true;
+    } else if (step == "instances") {
+        options->detectInstances = true;
+    } else if (step == "sort") {
+        options->spatialSort = true;
+    } else if (step == "normals") {
+        options->generateNormals = true;
+    } else if (step == "tangents") {
+        options->generateTangents = true;
+    } else if (step == "consolidate") {
+        options->consolidateBuffers = true;
+    } else if (step == "split") {
+        options->splitMeshes = true;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+void PrintUsage(const char *program) {
+    std::cerr << "Usage: " << program << " [-f <filename>] "
+              << "[--faces <count>] [--mix <triangles,quads,polygons>] "
+              << "[--format v|vt|vn|vtvn] [--groups <count>] "
+              << "[--materials <count>] [--seed <value>] "
+              << "[--directory <path>] [--keep] "
+              << "[--step coalesce|weld|clean|instances|sort|normals|"
+              << "tangents|consolidate|split] [--repetitions <count>] "
+              << "[--trace <filename>] [--counters] [--allocations] "
+              << "[--reuse-parser]\n";
+}
+
+int main(int argc, char** argv) {
+    std::string filename;
+    std::filesystem::path directory =
+        std::filesystem::temp_directory_path();
+    ObjGeneratorOptions generatorOptions;
+    Meshborn::ParseOptions parseOptions;
+    std::string traceFilename;
+    bool keepFiles = false;
+    bool readCounters = false;
+    bool profileAllocations = false;
+    bool reuseParser = false;
+    int repetitions = 3;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if ((arg == "-f" || arg == "--file") && i + 1 < argc) {
+            filename = argv[++i];
+        } else if (arg == "--faces" && i + 1 < argc) {
+            generatorOptions.faces = std::stoul(argv[++i]);
+        } else if (arg == "--mix" && i + 1 < argc &&
+                   ParseFaceMix(argv[i + 1], &generatorOptions)) {
+            ++i;
+        } else if (arg == "--format" && i + 1 < argc &&
+                   ParseFaceFormat(argv[i + 1], &generatorOptions.format)) {
+            ++i;
+        } else if (arg == "--groups" && i + 1 < argc) {
+            generatorOptions.groups = std::stoul(argv[++i]);
+        } else if (arg == "--materials" && i + 1 < argc) {
+            generatorOptions.materials = std::stoul(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            generatorOptions.seed = static_cast<uint32_t>(
+                std::stoul(argv[++i]));
+        } else if (arg == "--directory" && i + 1 < argc) {
+            directory = argv[++i];
+        } else if (arg == "--keep") {
+            keepFiles = true;
+        } else if (arg == "--step" && i + 1 < argc &&
+                   EnableStep(argv[i + 1], &parseOptions)) {
+            ++i;
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            repetitions = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--trace" && i + 1 < argc) {
+            traceFilename = argv[++i];
+        } else if (arg == "--counters") {
+            readCounters = true;
+        } else if (arg == "--allocations") {
+            profileAllocations = true;
+        } else if (arg == "--reuse-parser") {
+            reuseParser = true;
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (profileAllocations && !AllocationProfiler::IsAvailable()) {
+        std::cerr << "Allocation profiling needs the benchmarks to be "
+                  << "configured with --enable-alloc-profile\n";
+        return 1;
+    }
+
+    const bool generated = filename.empty();
+    std::string mtlFilename;
+
+    if (generated) {
+        filename = (directory / "meshborn_benchmark.obj").string();
+        mtlFilename = (directory / "meshborn_benchmark.mtl").string();
+
+        auto start = Clock::now();
+        if (!ObjGenerator(generatorOptions).Write(filename, mtlFilename)) {
+            std::cerr << "Failed to write '" << filename << "'\n";
+            return 1;
+        }
+        std::chrono::duration<double> elapsed = Clock::now() - start;
+
+        std::cout << "Generated " << generatorOptions.faces << " faces in "
+                  << elapsed.count() * 1000.0 << " ms\n";
+    }
+
+    std::error_code error;
+    const double megabytes = std::filesystem::file_size(filename, error) /
+                             1e6;
+    uint64_t textBytes = 0;
+
+    if (error || !GetTextBytes(filename, &textBytes)) {
+        std::cerr << "Cannot read '" << filename << "'\n";
+        return 1;
+    }
+
+    const double textMegabytes = textBytes / 1e6;
+
+    const double baselineRss = GetPeakResidentMegabytes();
+
+    // Opened before the runs so that the parser's threads inherit them.
+    std::unique_ptr<PerfCounters> counters;
+    std::unique_ptr<StageCounterListener> counterListener;
+    std::unique_ptr<AllocationProfiler> allocationProfiler;
+    auto listeners = std::make_unique<TraceListenerGroup>();
+
+    if (readCounters) {
+        counters = std::make_unique<PerfCounters>();
+        bool available = false;
+
+        for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i) {
+            available |= counters->IsAvailable(static_cast<PerfCounter>(i));
+        }
+
+        if (!counters->GetError().empty()) {
+            std::cout << "Some counters are unavailable ("
+                      << counters->GetError() << ")\n";
+        }
+
+        if (available) {
+            counterListener =
+                std::make_unique<StageCounterListener>(*counters);
+            listeners->Add(counterListener.get());
+        }
+    }
+
+    // Counts allocations from here on, so it is created last.
+    if (profileAllocations) {
+        allocationProfiler = std::make_unique<AllocationProfiler>();
+        listeners->Add(allocationProfiler.get());
+    }
+
+    if (!listeners->IsEmpty()) {
+        Meshborn::SetTraceListener(std::move(listeners));
+    }
+
+    // Every run is traced, so the timings include the tracing overhead.
+    if (!traceFilename.empty()) {
+        Meshborn::StartTrace();
+    }
+    std::vector<double> times;
+    size_t faces = 0;
+    size_t uniqueFaces = 0;
+    size_t meshes = 0;
+    size_t instances = 0;
+    Meshborn::ParseStats stats;
+    Meshborn::ModelMemoryUsage loadedMemory;
+    Meshborn::ModelMemoryUsage compactedMemory;
+    bool ok = true;
+
+    // With --reuse-parser every run after the first starts with the
+    // buffers kept by the parser from the one before.
+    Meshborn::WaveFrontObjParser reusedParser(parseOptions);
+
+    for (int i = 0; i < repetitions && ok; ++i) {
+        try {
+            Meshborn::WaveFrontObjParser newParser(parseOptions);
+            Meshborn::WaveFrontObjParser& parser =
+                reuseParser ? reusedParser : newParser;
+            auto start = Clock::now();
+            auto model = parser.ParseObj(filename);
+            std::chrono::duration<double> elapsed = Clock::now() - start;
+            stats = parser.GetStats();
+
+            if (!model) {
+                std::cerr << "Failed to load '" << filename << "'\n";
+                ok = false;
+                break;
+            }
+
+            times.push_back(elapsed.count());
+            uniqueFaces = 0;
+            meshes = model->meshes.size();
+            instances = model->instances.size();
+
+            for (const auto& mesh : model->meshes) {
+                uniqueFaces += mesh.faces.size();
+            }
+
+            // Faces placed by instances are loaded as much as the meshes
+            // they share, so they count towards the faces emitted.
+            faces = uniqueFaces;
+
+            for (const auto& instance : model->instances) {
+                if (instance.mesh < model->meshes.size()) {
+                    faces += model->meshes[instance.mesh].faces.size();
+                }
+            }
+
+            // Measured after the timed load, on the last run only.
+            if (i == repetitions - 1) {
+                loadedMemory = model->GetMemoryUsage();
+                model->Compact();
+                compactedMemory = model->GetMemoryUsage();
+            }
+        }
+        catch (const std::runtime_error& ex) {
+            std::cerr << "[EXCEPTION] " << ex.what() << "\n";
+            ok = false;
+        }
+    }
+
+    Meshborn::SetTraceListener(nullptr);
+
+    if (allocationProfiler) {
+        allocationProfiler->Stop();
+    }
+
+    if (!traceFilename.empty()) {
+        Meshborn::StopTrace();
+
+        if (!Meshborn::WriteTrace(traceFilename)) {
+            std::cerr << "Failed to write '" << traceFilename << "'\n";
+            ok = false;
+        }
+    }
+
+    if (generated && !keepFiles) {
+        std::filesystem::remove(filename, error);
+        std::filesystem::remove(mtlFilename, error);
+    }
+
+    if (!ok) {
+        return 1;
+    }
+
+    std::sort(times.begin(), times.end());
+    const double best = times.front();
+    const double median = times[times.size() / 2];
+
+    std::cout << "File: " << filename << " (" << megabytes
+              << " MB on disk, " << textMegabytes << " MB of text)\n"
+              << "Model: " << faces << " faces emitted, " << uniqueFaces
+              << " unique in " << meshes << " meshes, " << instances
+              << " instances\n"
+              << "ParseObj: best " << best * 1000.0 << " ms, median "
+              << median * 1000.0 << " ms over " << times.size()
+              << " runs\n"
+              << "Throughput: " << textMegabytes / best
+              << " MB/s of text, " << faces / best / 1e6
+              << " Mfaces/s emitted\n"
+              << "Peak RSS: " << GetPeakResidentMegabytes() << " MB ("
+              << baselineRss << " MB before parsing)\n";
+
+    PrintMemoryUsage(loadedMemory, compactedMemory);
+
+    if (Meshborn::IsParseStatsEnabled()) {
+        PrintParseStats(stats);
+    }
+
+    if (counterListener) {
+        PrintStageCounters(*counters, counterListener->GetStages(),
+                           static_cast<int>(times.size()),
+                           static_cast<double>(textBytes), faces);
+    }
+
+    if (allocationProfiler) {
+        PrintAllocations(allocationProfiler->GetStages(),
+                         allocationProfiler->GetTopSites(20),
+                         static_cast<int>(times.size()), faces);
+    }
+
+    return 0;
+}
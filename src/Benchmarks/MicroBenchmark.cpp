@@ -0,0 +1,438 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <chrono>   // NOLINT
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ObjGenerator.h"
+#include "WaveFrontObjParser.h"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Results are folded into this so the compiler cannot discard the work.
+volatile uint64_t benchmarkSink = 0;
+
+/**
+ * Timing of one benchmark, in nanoseconds per item for each repetition.
+ */
+struct BenchmarkResult {
+    std::string name;
+    size_t items;
+    std::vector<double> nanoseconds;
+
+    double Percentile(double fraction) const {
+        const size_t index = static_cast<size_t>(
+            fraction * (nanoseconds.size() - 1) + 0.5);
+        return nanoseconds[index];
+    }
+
+    double Mean() const {
+        double total = 0.0;
+
+        for (double value : nanoseconds) {
+            total += value;
+        }
+
+        return total / nanoseconds.size();
+    }
+};
+
+/**
+ * Settings shared by every benchmark.
+ */
+struct HarnessOptions {
+    HarnessOptions() : warmup(3), repetitions(30) {}
+
+    int warmup;
+    int repetitions;
+    std::string filter;
+};
+
+/**
+ * Runs a benchmark body, which processes a fixed set of items each call,
+ * for the warmup and then the timed repetitions. The optional setup runs
+ * untimed before every call, to give each one the same starting state.
+ */
+bool RunBenchmark(const HarnessOptions& options, const std::string& name,
+                  size_t items, const std::function<uint64_t()>& body,
+                  std::vector<BenchmarkResult> *results,
+                  const std::function<void()>& setup = nullptr) {
+    if (!options.filter.empty() &&
+        name.find(options.filter) == std::string::npos) {
+        return false;
+    }
+
+    for (int i = 0; i < options.warmup; ++i) {
+        if (setup) {
+            setup();
+        }
+
+        benchmarkSink = benchmarkSink + body();
+    }
+
+    BenchmarkResult result;
+    result.name = name;
+    result.items = items;
+
+    for (int i = 0; i < options.repetitions; ++i) {
+        if (setup) {
+            setup();
+        }
+
+        auto start = Clock::now();
+        benchmarkSink = benchmarkSink + body();
+        std::chrono::duration<double, std::nano> elapsed =
+            Clock::now() - start;
+        result.nanoseconds.push_back(elapsed.count() /
+                                     std::max<size_t>(1, items));
+    }
+
+    std::sort(result.nanoseconds.begin(), result.nanoseconds.end());
+    results->push_back(std::move(result));
+    return true;
+}
+
+void WriteCsv(const std::vector<BenchmarkResult>& results) {
+    std::cout << "benchmark,items,repetitions,min_ns,p50_ns,p90_ns,p99_ns,"
+              << "max_ns,mean_ns,items_per_second\n";
+
+    for (const auto& result : results) {
+        std::cout << result.name << ',' << result.items << ','
+                  << result.nanoseconds.size() << ','
+                  << result.nanoseconds.front() << ','
+                  << result.Percentile(0.5) << ','
+                  << result.Percentile(0.9) << ','
+                  << result.Percentile(0.99) << ','
+                  << result.nanoseconds.back() << ','
+                  << result.Mean() << ','
+                  << 1e9 / result.Percentile(0.5) << '\n';
+    }
+}
+
+void WriteJson(const std::vector<BenchmarkResult>& results) {
+    std::cout << "{\n  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& result = results[i];
+        std::cout << (i ? ",\n" : "\n")
+                  << "    { \"name\": \"" << result.name << "\""
+                  << ", \"items\": " << result.items
+                  << ", \"repetitions\": " << result.nanoseconds.size()
+                  << ", \"min_ns\": " << result.nanoseconds.front()
+                  << ", \"p50_ns\": " << result.Percentile(0.5)
+                  << ", \"p90_ns\": " << result.Percentile(0.9)
+                  << ", \"p99_ns\": " << result.Percentile(0.99)
+                  << ", \"max_ns\": " << result.nanoseconds.back()
+                  << ", \"mean_ns\": " << result.Mean()
+                  << ", \"items_per_second\": "
+                  << 1e9 / result.Percentile(0.5) << " }";
+    }
+
+    std::cout << "\n  ]\n}\n";
+}
+
+/**
+ * Lines of a generated file, grouped by record type.
+ */
+struct LineSet {
+    std::vector<std::string> all;
+    std::vector<std::string> positions;
+    std::vector<std::string> textureCoordinates;
+    std::vector<std::string> normals;
+    std::vector<std::string> faces;
+};
+
+bool ReadLines(const std::string& filename, LineSet *lines) {
+    std::ifstream file(filename);
+    std::string line;
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        if (line.starts_with("v ")) {
+            lines->positions.push_back(line);
+        } else if (line.starts_with("vt ")) {
+            lines->textureCoordinates.push_back(line);
+        } else if (line.starts_with("vn ")) {
+            lines->normals.push_back(line);
+        } else if (line.starts_with("f ")) {
+            lines->faces.push_back(line);
+        }
+
+        lines->all.push_back(std::move(line));
+    }
+
+    return true;
+}
+
+}   // namespace
+
+namespace Meshborn {
+
+/**
+ * Runs the parser's private functions over the lines of a generated file,
+ * in the mix in which the parser meets them.
+ */
+class ParserMicroBenchmark {
+ public:
+    explicit ParserMicroBenchmark(const LineSet& lines) : lines_(lines) {
+        for (const auto& line : lines_.all) {
+            auto words = parser_.SplitElementString(line);
+
+            if (line.starts_with("f ")) {
+                for (size_t i = 1; i < words.size(); ++i) {
+                    SplitIndices(words[i]);
+                }
+            } else if (line.starts_with("v")) {
+                floats_.insert(floats_.end(), words.begin() + 1,
+                               words.end());
+            }
+        }
+    }
+
+    void Run(const HarnessOptions& options,
+             std::vector<BenchmarkResult> *results);
+
+ private:
+    void SplitIndices(const std::string& element) {
+        size_t begin = 0;
+
+        while (begin <= element.size()) {
+            size_t end = element.find('/', begin);
+            end = end == std::string::npos ? element.size() : end;
+
+            if (end > begin) {
+                ints_.push_back(element.substr(begin, end - begin));
+            }
+
+            begin = end + 1;
+        }
+    }
+
+    const LineSet& lines_;
+    WaveFrontObjParser parser_;
+    std::vector<std::string> floats_;
+    std::vector<std::string> ints_;
+};
+
+void ParserMicroBenchmark::Run(const HarnessOptions& options,
+                               std::vector<BenchmarkResult> *results) {
+    RunBenchmark(options, "SplitElementString", lines_.all.size(), [&]() {
+        uint64_t words = 0;
+
+        for (const auto& line : lines_.all) {
+            words += parser_.SplitElementString(line).size();
+        }
+
+        return words;
+    }, results);
+
+    RunBenchmark(options, "ParseFloat", floats_.size(), [&]() {
+        uint64_t total = 0;
+
+        for (const auto& text : floats_) {
+            float value;
+            total += parser_.ParseFloat(text.c_str(), &value) &&
+                     value > 0.0f;
+        }
+
+        return total;
+    }, results);
+
+    RunBenchmark(options, "ParseInt", ints_.size(), [&]() {
+        uint64_t total = 0;
+
+        for (const auto& text : ints_) {
+            int value;
+            total += parser_.ParseInt(text.c_str(), &value) ? value : 0;
+        }
+
+        return total;
+    }, results);
+
+    // Tests each line against the keywords in the order ParseObj does, with
+    // the std::string_view::starts_with it uses.
+    static const std::string_view keywords[] = {
+        "g ", "o ", "f ", "v ", "vn ", "vt ", "usemtl ", "s ", "mtllib "
+    };
+
+    RunBenchmark(options, "KeywordDispatch", lines_.all.size(), [&]() {
+        uint64_t total = 0;
+
+        for (const auto& line : lines_.all) {
+            const std::string_view view(line);
+
+            for (const auto& keyword : keywords) {
+                if (view.starts_with(keyword)) {
+                    total += keyword.size();
+                    break;
+                }
+            }
+        }
+
+        return total;
+    }, results);
+
+    RunBenchmark(options, "ParsePolygonalFaceElement", lines_.faces.size(),
+                 [&]() {
+        uint64_t total = 0;
+
+        for (const auto& line : lines_.faces) {
+            PolygonalFace face;
+            parser_.ParsePolygonalFaceElement(line, &face);
+            total += face.elements.size();
+        }
+
+        return total;
+    }, results);
+
+    RunBenchmark(options, "ParseVectorElement", lines_.positions.size(),
+                 [&]() {
+        uint64_t total = 0;
+
+        for (const auto& line : lines_.positions) {
+            Point4D position;
+            parser_.ParseVectorElement(line, &position);
+            total += position.x > 0.0f;
+        }
+
+        return total;
+    }, results);
+
+    // Finalisation needs the parsed pools and faces, built once up front.
+    Point4DList positions;
+    Point3DList normals;
+    TextureCoordinatesList textureCoordinates;
+    Mesh mesh;
+
+    for (const auto& line : lines_.positions) {
+        Point4D position;
+        parser_.ParseVectorElement(line, &position);
+        positions.push_back(position);
+    }
+
+    for (const auto& line : lines_.normals) {
+        Point3D normal;
+        parser_.ParseVertexNormalElement(line, &normal);
+        normals.push_back(normal);
+    }
+
+    for (const auto& line : lines_.textureCoordinates) {
+        TextureCoordinates coordinates;
+        parser_.ParseTextureCoordinate(line, &coordinates);
+        textureCoordinates.push_back(coordinates);
+    }
+
+    for (const auto& line : lines_.faces) {
+        PolygonalFace face;
+        parser_.ParsePolygonalFaceElement(line, &face);
+        mesh.faces.push_back(std::move(face));
+    }
+
+    // The vertices are freed before each call, untimed, so that it grows
+    // them from empty as a parse does rather than reusing the last call's.
+    RunBenchmark(options, "FinaliseVertices", mesh.faces.size(), [&]() {
+        parser_.FinaliseVertices(&mesh, positions, normals,
+                                 textureCoordinates);
+        return static_cast<uint64_t>(mesh.vertices.size());
+    }, results, [&]() {
+        std::vector<Vertex>().swap(mesh.vertices);
+    });
+}
+
+}   // namespace Meshborn
+
+int main(int argc, char** argv) {
+    ObjGeneratorOptions generatorOptions;
+    HarnessOptions harnessOptions;
+    bool json = false;
+
+    generatorOptions.faces = 100000;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--faces" && i + 1 < argc) {
+            generatorOptions.faces = std::stoul(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            generatorOptions.seed = static_cast<uint32_t>(
+                std::stoul(argv[++i]));
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            harnessOptions.warmup = std::max(0, std::stoi(argv[++i]));
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            harnessOptions.repetitions = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--filter" && i + 1 < argc) {
+            harnessOptions.filter = argv[++i];
+        } else if (arg == "--json") {
+            json = true;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--faces <count>] "
+                      << "[--seed <value>] [--warmup <count>] "
+                      << "[--repetitions <count>] [--filter <name>] "
+                      << "[--json]\n";
+            return 1;
+        }
+    }
+
+    // The default generator mix gives the line distribution of a textured
+    // model: shared v/vt/vn pools and mostly triangle and quad faces.
+    const auto directory = std::filesystem::temp_directory_path();
+    const std::string objFilename =
+        (directory / "meshborn_microbenchmark.obj").string();
+    const std::string mtlFilename =
+        (directory / "meshborn_microbenchmark.mtl").string();
+    LineSet lines;
+
+    const bool written = ObjGenerator(generatorOptions).Write(objFilename,
+                                                              mtlFilename);
+    const bool read = written && ReadLines(objFilename, &lines);
+
+    std::error_code error;
+    std::filesystem::remove(objFilename, error);
+    std::filesystem::remove(mtlFilename, error);
+
+    if (!read) {
+        std::cerr << "Failed to generate benchmark input\n";
+        return 1;
+    }
+
+    std::vector<BenchmarkResult> results;
+    Meshborn::ParserMicroBenchmark(lines).Run(harnessOptions, &results);
+
+    if (json) {
+        WriteJson(results);
+    } else {
+        WriteCsv(results);
+    }
+
+    return 0;
+}
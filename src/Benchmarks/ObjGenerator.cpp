@@ -0,0 +1,333 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <string>
+#include "ObjGenerator.h"
+
+namespace {
+
+// Size of the buffer collected before each write to the file.
+const size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+/**
+ * Collects lines of text and writes them to a file in large blocks.
+ */
+class LineWriter {
+ public:
+    explicit LineWriter(const std::string& filename)
+        : file_(filename, std::ios::binary) {
+        buffer_.reserve(WRITE_BUFFER_SIZE + 256);
+    }
+
+    ~LineWriter() { Flush(); }
+
+    bool IsOpen() const { return file_.is_open(); }
+
+    bool Good() { Flush(); return file_.good(); }
+
+    LineWriter& operator<<(const char *text) {
+        buffer_ += text;
+        return *this;
+    }
+
+    LineWriter& operator<<(const std::string& text) {
+        buffer_ += text;
+        return *this;
+    }
+
+    LineWriter& operator<<(char character) {
+        buffer_ += character;
+        return *this;
+    }
+
+    LineWriter& operator<<(size_t value) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        buffer_.append(digits, result.ptr);
+        return *this;
+    }
+
+    LineWriter& operator<<(float value) {
+        char digits[48];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value,
+                                    std::chars_format::fixed, 6);
+        buffer_.append(digits, result.ptr);
+        return *this;
+    }
+
+    void EndLine() {
+        buffer_ += '\n';
+
+        if (buffer_.size() >= WRITE_BUFFER_SIZE) {
+            Flush();
+        }
+    }
+
+ private:
+    void Flush() {
+        file_.write(buffer_.data(), buffer_.size());
+        buffer_.clear();
+    }
+
+    std::ofstream file_;
+    std::string buffer_;
+};
+
+float Height(float x, float z) {
+    return 0.25f * std::sin(x * 0.05f) * std::cos(z * 0.07f);
+}
+
+}   // namespace
+
+ObjGenerator::ObjGenerator(const ObjGeneratorOptions& options)
+    : options_(options) {
+}
+
+/**
+ * Writes the .obj file and, if it uses materials, the .mtl file.
+ *
+ * @param objFilename Path of the .obj file to write.
+ * @param mtlFilename Path of the .mtl file to write. It is referenced from
+ *        the .obj file as given, so must not contain spaces.
+ * @return true on success, false if either file cannot be written.
+ */
+bool ObjGenerator::Write(const std::string& objFilename,
+                         const std::string& mtlFilename) const {
+    const bool hasTextures =
+        options_.format == ObjFaceFormat::POSITION_TEXTURE ||
+        options_.format == ObjFaceFormat::POSITION_TEXTURE_NORMAL;
+    const bool hasNormals =
+        options_.format == ObjFaceFormat::POSITION_NORMAL ||
+        options_.format == ObjFaceFormat::POSITION_TEXTURE_NORMAL;
+    const unsigned int totalWeight = std::max(1u, options_.triangleWeight +
+                                                  options_.quadWeight +
+                                                  options_.polygonWeight);
+
+    if (options_.materials && !WriteMaterials(mtlFilename)) {
+        return false;
+    }
+
+    LineWriter out(objFilename);
+
+    if (!out.IsOpen()) {
+        return false;
+    }
+
+    // Size the grid for the expected number of cells, plus six standard
+    // deviations of the random face mix; a triangle uses half a cell and a
+    // quad or polygon a whole one. Should the grid still run out, faces
+    // wrap around to its start.
+    const double cellsPerFace =
+        (0.5 * options_.triangleWeight + options_.quadWeight +
+         options_.polygonWeight) / totalWeight;
+    const size_t cells = std::max<size_t>(1, static_cast<size_t>(
+        std::ceil(options_.faces * cellsPerFace +
+                  1.5 * std::sqrt(static_cast<double>(options_.faces)))) +
+        16);
+    const size_t width = std::max<size_t>(1, static_cast<size_t>(
+        std::ceil(std::sqrt(static_cast<double>(cells)))));
+    const size_t depth = (cells + width - 1) / width;
+    const size_t stride = width + 1;
+
+    out << "# Meshborn synthetic benchmark model";
+    out.EndLine();
+
+    if (options_.materials) {
+        out << "mtllib " << mtlFilename;
+        out.EndLine();
+    }
+
+    for (size_t z = 0; z <= depth; ++z) {
+        for (size_t x = 0; x <= width; ++x) {
+            const float fx = static_cast<float>(x);
+            const float fz = static_cast<float>(z);
+            out << "v " << fx << ' ' << Height(fx, fz) << ' ' << fz;
+            out.EndLine();
+        }
+    }
+
+    if (hasTextures) {
+        for (size_t z = 0; z <= depth; ++z) {
+            for (size_t x = 0; x <= width; ++x) {
+                out << "vt " << static_cast<float>(x) / width << ' '
+                    << static_cast<float>(z) / depth << ' ' << 0.0f;
+                out.EndLine();
+            }
+        }
+    }
+
+    if (hasNormals) {
+        for (size_t z = 0; z <= depth; ++z) {
+            for (size_t x = 0; x <= width; ++x) {
+                const float fx = static_cast<float>(x);
+                const float fz = static_cast<float>(z);
+                const float dx = 0.0125f * std::cos(fx * 0.05f) *
+                                 std::cos(fz * 0.07f);
+                const float dz = -0.0175f * std::sin(fx * 0.05f) *
+                                 std::sin(fz * 0.07f);
+                const float length = std::sqrt(dx * dx + 1.0f + dz * dz);
+                out << "vn " << -dx / length << ' ' << 1.0f / length << ' '
+                    << -dz / length;
+                out.EndLine();
+            }
+        }
+    }
+
+    // Polygons append their own positions and texture coordinates after
+    // the grid's.
+    size_t positionCount = stride * (depth + 1);
+    size_t textureCount = hasTextures ? positionCount : 0;
+
+    const auto writeCorner = [&](size_t position, size_t texture,
+                                 size_t normal) {
+        out << ' ' << position;
+
+        if (hasTextures) {
+            out << '/' << texture;
+        }
+
+        if (hasNormals) {
+            out << (hasTextures ? "/" : "//") << normal;
+        }
+    };
+
+    const auto writeGridFace = [&](const size_t *corners, size_t count) {
+        out << 'f';
+
+        for (size_t i = 0; i < count; ++i) {
+            writeCorner(corners[i], corners[i], corners[i]);
+        }
+
+        out.EndLine();
+    };
+
+    std::mt19937 random(options_.seed);
+    const size_t facesPerGroup = options_.groups ?
+        (options_.faces + options_.groups - 1) / options_.groups : 0;
+    size_t cell = 0;
+    bool halfCell = false;
+
+    for (size_t face = 0; face < options_.faces; ++face) {
+        if (facesPerGroup && face % facesPerGroup == 0) {
+            out << "g group_" << face / facesPerGroup;
+            out.EndLine();
+
+            if (options_.materials) {
+                out << "usemtl material_"
+                    << static_cast<size_t>(random() % options_.materials);
+                out.EndLine();
+            }
+        }
+
+        const unsigned int choice = random() % totalWeight;
+        const bool triangle = choice < options_.triangleWeight;
+
+        // Quads and polygons need a whole cell.
+        if (!triangle && halfCell) {
+            halfCell = false;
+            ++cell;
+        }
+
+        const size_t cellX = cell % width;
+        const size_t cellZ = (cell / width) % depth;
+        const size_t a = cellZ * stride + cellX + 1;
+        const size_t corners[4] = { a, a + 1, a + stride + 1, a + stride };
+
+        if (triangle) {
+            // Two triangles share each cell.
+            const size_t half[3] = { corners[0], corners[halfCell ? 2 : 1],
+                                     corners[halfCell ? 3 : 2] };
+            writeGridFace(half, 3);
+            cell += halfCell ? 1 : 0;
+            halfCell = !halfCell;
+            continue;
+        }
+
+        if (choice < options_.triangleWeight + options_.quadWeight) {
+            writeGridFace(corners, 4);
+        } else {
+            // A ring of 5 to 8 new positions inside the cell.
+            const size_t sides = 5 + random() % 4;
+
+            for (size_t i = 0; i < sides; ++i) {
+                const float angle = 6.2831853f * i / sides;
+                const float x = cellX + 0.5f + 0.4f * std::cos(angle);
+                const float z = cellZ + 0.5f + 0.4f * std::sin(angle);
+                out << "v " << x << ' ' << Height(x, z) << ' ' << z;
+                out.EndLine();
+
+                if (hasTextures) {
+                    out << "vt " << x / width << ' ' << z / depth << ' '
+                        << 0.0f;
+                    out.EndLine();
+                }
+            }
+
+            out << 'f';
+
+            for (size_t i = 0; i < sides; ++i) {
+                writeCorner(positionCount + i + 1, textureCount + i + 1, a);
+            }
+
+            out.EndLine();
+            positionCount += sides;
+            textureCount += hasTextures ? sides : 0;
+        }
+
+        ++cell;
+    }
+
+    return out.Good();
+}
+
+bool ObjGenerator::WriteMaterials(const std::string& filename) const {
+    LineWriter out(filename);
+
+    if (!out.IsOpen()) {
+        return false;
+    }
+
+    std::mt19937 random(options_.seed);
+
+    for (size_t i = 0; i < options_.materials; ++i) {
+        const float red = (random() % 256) / 255.0f;
+        const float green = (random() % 256) / 255.0f;
+        const float blue = (random() % 256) / 255.0f;
+
+        out << "newmtl material_" << i;
+        out.EndLine();
+        out << "Ka " << 0.1f << ' ' << 0.1f << ' ' << 0.1f;
+        out.EndLine();
+        out << "Kd " << red << ' ' << green << ' ' << blue;
+        out.EndLine();
+        out << "Ks " << 0.5f << ' ' << 0.5f << ' ' << 0.5f;
+        out.EndLine();
+        out << "Ns " << 32.0f;
+        out.EndLine();
+        out << "d " << 1.0f;
+        out.EndLine();
+        out << "illum 2";
+        out.EndLine();
+    }
+
+    return out.Good();
+}
@@ -0,0 +1,89 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OBJGENERATOR_H_
+#define OBJGENERATOR_H_
+#include <cstdint>
+#include <string>
+
+/**
+ * Attributes referenced by each face corner of a generated file.
+ */
+enum class ObjFaceFormat {
+    // f v
+    POSITION,
+
+    // f v/vt
+    POSITION_TEXTURE,
+
+    // f v//vn
+    POSITION_NORMAL,
+
+    // f v/vt/vn
+    POSITION_TEXTURE_NORMAL
+};
+
+/**
+ * Shape and size of a generated file.
+ */
+struct ObjGeneratorOptions {
+    ObjGeneratorOptions() : faces(250000), triangleWeight(6),
+                            quadWeight(3), polygonWeight(1),
+                            format(ObjFaceFormat::POSITION_TEXTURE_NORMAL),
+                            groups(16), materials(4), seed(1) {}
+
+    // Number of faces to write.
+    size_t faces;
+
+    // Relative share of triangles, quads and 5 to 8 sided polygons.
+    unsigned int triangleWeight;
+    unsigned int quadWeight;
+    unsigned int polygonWeight;
+
+    ObjFaceFormat format;
+
+    // Number of 'g' groups the faces are spread over, each starting with a
+    // 'usemtl' for one of the materials. 0 writes neither.
+    size_t groups;
+    size_t materials;
+
+    // Seed for the face type and material choices. The same options always
+    // produce the same file.
+    uint32_t seed;
+};
+
+/**
+ * Writes deterministic synthetic .obj and .mtl files for benchmarking.
+ *
+ * Faces tile a gently curved height field in rows, so positions, texture
+ * coordinates and normals are shared between neighbouring faces as they
+ * are in exported models. Polygons use their own ring of positions.
+ */
+class ObjGenerator {
+ public:
+    explicit ObjGenerator(const ObjGeneratorOptions& options);
+
+    bool Write(const std::string& objFilename,
+               const std::string& mtlFilename) const;
+
+ private:
+    bool WriteMaterials(const std::string& filename) const;
+
+    ObjGeneratorOptions options_;
+};
+
+#endif  // OBJGENERATOR_H_
@@ -0,0 +1,171 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifdef __linux__
+  #include <linux/perf_event.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+#include <cerrno>
+#include <cstring>
+#include "PerfCounters.h"
+
+namespace {
+
+const char* const COUNTER_NAMES[PERF_COUNTER_COUNT] = {
+    "task-clock",
+    "cycles",
+    "instructions",
+    "branch-misses",
+    "LLC-misses"
+};
+
+#ifdef __linux__
+/**
+ * Opens one counter for the calling thread, returning -1 on failure.
+ */
+int OpenCounter(PerfCounter counter) {
+    struct perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                             PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attributes.inherit = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+
+    switch (counter) {
+        case PerfCounter::TASK_CLOCK:
+            attributes.type = PERF_TYPE_SOFTWARE;
+            attributes.config = PERF_COUNT_SW_TASK_CLOCK;
+            break;
+
+        case PerfCounter::CYCLES:
+            attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+
+        case PerfCounter::INSTRUCTIONS:
+            attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+
+        case PerfCounter::BRANCH_MISSES:
+            attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+
+        default:
+            attributes.type = PERF_TYPE_HW_CACHE;
+            attributes.config = PERF_COUNT_HW_CACHE_LL |
+                (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+    }
+
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0,
+                                    -1, -1, 0));
+}
+#endif
+
+}   // namespace
+
+PerfSample::PerfSample() {
+    for (auto& value : values) {
+        value = 0;
+    }
+}
+
+PerfSample& PerfSample::operator+=(const PerfSample& other) {
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i) {
+        values[i] += other.values[i];
+    }
+
+    return *this;
+}
+
+PerfSample PerfSample::operator-(const PerfSample& other) const {
+    PerfSample difference;
+
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i) {
+        difference.values[i] = values[i] - other.values[i];
+    }
+
+    return difference;
+}
+
+PerfCounters::PerfCounters() {
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i) {
+#ifdef __linux__
+        descriptors_[i] = OpenCounter(static_cast<PerfCounter>(i));
+
+        if (descriptors_[i] < 0 && error_.empty()) {
+            error_ = std::string(COUNTER_NAMES[i]) + ": " +
+                     strerror(errno);
+        }
+#else
+        descriptors_[i] = -1;
+        error_ = "perf_event_open is only available on Linux";
+#endif
+    }
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int descriptor : descriptors_) {
+        if (descriptor >= 0) {
+            close(descriptor);
+        }
+    }
+#endif
+}
+
+bool PerfCounters::IsAvailable(PerfCounter counter) const {
+    return descriptors_[static_cast<size_t>(counter)] >= 0;
+}
+
+/**
+ * Reads every available counter.
+ */
+PerfSample PerfCounters::Read() const {
+    PerfSample sample;
+
+#ifdef __linux__
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i) {
+        // value, time enabled, time running
+        uint64_t data[3];
+
+        if (descriptors_[i] < 0 ||
+            read(descriptors_[i], data, sizeof(data)) !=
+                static_cast<ssize_t>(sizeof(data))) {
+            continue;
+        }
+
+        if (data[2] && data[2] < data[1]) {
+            data[0] = static_cast<uint64_t>(
+                static_cast<double>(data[0]) * data[1] / data[2]);
+        }
+
+        sample.values[i] = data[0];
+    }
+#endif
+
+    return sample;
+}
+
+const char* PerfCounters::GetName(PerfCounter counter) {
+    const size_t index = static_cast<size_t>(counter);
+    return index < PERF_COUNTER_COUNT ? COUNTER_NAMES[index] : "";
+}
@@ -0,0 +1,89 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef PERFCOUNTERS_H_
+#define PERFCOUNTERS_H_
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Counters read by PerfCounters.
+ */
+enum class PerfCounter {
+    // CPU time in nanoseconds. A software counter, so it is usually
+    // available even where the hardware counters are not.
+    TASK_CLOCK,
+
+    CYCLES,
+    INSTRUCTIONS,
+    BRANCH_MISSES,
+
+    // Last level cache read misses.
+    LLC_MISSES,
+
+    COUNT
+};
+
+const size_t PERF_COUNTER_COUNT = static_cast<size_t>(PerfCounter::COUNT);
+
+/**
+ * Values of every counter at one point, 0 for those unavailable.
+ */
+struct PerfSample {
+    PerfSample();
+
+    PerfSample& operator+=(const PerfSample& other);
+
+    PerfSample operator-(const PerfSample& other) const;
+
+    uint64_t values[PERF_COUNTER_COUNT];
+};
+
+/**
+ * Linux perf_event_open counters for the calling thread and the threads
+ * it creates afterwards, counted in user space only.
+ *
+ * Counters the kernel or hardware does not provide, e.g. in virtual
+ * machines or with a restrictive perf_event_paranoid setting, are left
+ * unavailable and read as 0. Elsewhere than Linux none are available.
+ * Counters multiplexed by the kernel are scaled to their full run time.
+ */
+class PerfCounters {
+ public:
+    PerfCounters();
+
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool IsAvailable(PerfCounter counter) const;
+
+    // Reason the first unavailable counter could not be opened.
+    const std::string& GetError() const { return error_; }
+
+    PerfSample Read() const;
+
+    static const char* GetName(PerfCounter counter);
+
+ private:
+    int descriptors_[PERF_COUNTER_COUNT];
+    std::string error_;
+};
+
+#endif  // PERFCOUNTERS_H_
@@ -0,0 +1,165 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <format>
+#include <utility>
+#include "AsyncLogger.h"
+
+namespace Meshborn {
+namespace Logger {
+
+/*
+ * The ring is a bounded multi-producer queue: each slot's sequence number
+ * says whether it is free for the producer at a position or holds a message
+ * for the consumer there, so producers claim slots with a single
+ * compare-exchange and never wait on each other or on the sink.
+ */
+
+AsyncLogger::AsyncLogger(std::unique_ptr<ILogger> sink, size_t capacity)
+    : sink_(std::move(sink)), enqueuePos_(0), dequeuePos_(0), dropped_(0),
+      droppedReported_(0), wakeups_(0), stopping_(false) {
+    size_t size = 2;
+
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    slots_ = std::make_unique<Slot[]>(size);
+    mask_ = size - 1;
+
+    for (size_t i = 0; i < size; i++) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    thread_ = std::thread(&AsyncLogger::Run, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+    stopping_.store(true, std::memory_order_release);
+    wakeups_.fetch_add(1, std::memory_order_release);
+    wakeups_.notify_one();
+    thread_.join();
+}
+
+void AsyncLogger::Log(LogLevel level, const std::string& message) {
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Slot *slot;
+
+    for (;;) {
+        slot = &slots_[pos & mask_];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) -
+                        static_cast<intptr_t>(pos);
+
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1,
+                    std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Full: the consumer has not yet freed the slot.
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->level = level;
+    slot->message = message;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+
+    wakeups_.fetch_add(1, std::memory_order_release);
+    wakeups_.notify_one();
+}
+
+void AsyncLogger::Flush() {
+    size_t target = enqueuePos_.load(std::memory_order_acquire);
+    size_t done = dequeuePos_.load(std::memory_order_acquire);
+
+    while (done < target) {
+        dequeuePos_.wait(done, std::memory_order_acquire);
+        done = dequeuePos_.load(std::memory_order_acquire);
+    }
+}
+
+uint64_t AsyncLogger::GetDroppedCount() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+void AsyncLogger::Run() {
+    for (;;) {
+        uint32_t seen = wakeups_.load(std::memory_order_acquire);
+
+        Drain();
+
+        if (stopping_.load(std::memory_order_acquire)) {
+            // Messages whose slots were claimed before stopping are
+            // published shortly after, so drain until none are pending.
+            while (dequeuePos_.load(std::memory_order_relaxed) !=
+                   enqueuePos_.load(std::memory_order_acquire)) {
+                if (!Drain()) {
+                    std::this_thread::yield();
+                }
+            }
+            return;
+        }
+
+        wakeups_.wait(seen, std::memory_order_acquire);
+    }
+}
+
+/**
+ * Passes every published message to the sink, in order.
+ *
+ * @return The number of messages passed on.
+ */
+size_t AsyncLogger::Drain() {
+    size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+    size_t count = 0;
+
+    for (;;) {
+        Slot& slot = slots_[pos & mask_];
+
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+            break;
+        }
+
+        sink_->Log(slot.level, slot.message);
+        slot.message.clear();
+        slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+        pos++;
+        count++;
+
+        dequeuePos_.store(pos, std::memory_order_release);
+        dequeuePos_.notify_all();
+    }
+
+    uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+
+    if (dropped != droppedReported_) {
+        sink_->Log(LogLevel::Warning,
+                   std::format("{} log messages dropped, the async log "
+                               "buffer was full", dropped - droppedReported_));
+        droppedReported_ = dropped;
+    }
+
+    return count;
+}
+
+}   // namespace Logger
+}   // namespace Meshborn
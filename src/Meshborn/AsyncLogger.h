@@ -0,0 +1,100 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef ASYNCLOGGER_H_
+#define ASYNCLOGGER_H_
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>   // NOLINT
+#include <vector>
+#include "Logger.h"
+
+namespace Meshborn {
+namespace Logger {
+
+/**
+ * Logger that queues messages in a fixed-size ring buffer and passes them
+ * to another logger on a background thread, so a slow sink such as a file
+ * or console never holds up the thread that logged.
+ *
+ * Log() never blocks: if the ring is full the message is dropped and
+ * counted, and the sink is told how many were lost once it catches up.
+ */
+class AsyncLogger : public ILogger {
+ public:
+    /**
+     * @param sink The logger messages are passed to, on the background
+     *             thread.
+     * @param capacity Number of messages the ring can hold, rounded up to
+     *                 a power of two.
+     */
+    explicit AsyncLogger(std::unique_ptr<ILogger> sink,
+                         size_t capacity = 4096);
+
+    /**
+     * Passes any queued messages to the sink and stops the thread.
+     */
+    ~AsyncLogger() override;
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    void Log(LogLevel level, const std::string& message) override;
+
+    /**
+     * Waits until every message queued before the call has been passed to
+     * the sink.
+     */
+    void Flush();
+
+    /**
+     * @return Number of messages dropped because the ring was full.
+     */
+    uint64_t GetDroppedCount() const;
+
+ private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        LogLevel level;
+        std::string message;
+    };
+
+    void Run();
+    size_t Drain();
+
+    std::unique_ptr<ILogger> sink_;
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_;
+
+    std::atomic<size_t> enqueuePos_;
+    std::atomic<size_t> dequeuePos_;
+    std::atomic<uint64_t> dropped_;
+    uint64_t droppedReported_;
+
+    // Bumped after each message is queued, and waited on by the thread.
+    std::atomic<uint32_t> wakeups_;
+    std::atomic<bool> stopping_;
+    std::thread thread_;
+};
+
+}   // namespace Logger
+}   // namespace Meshborn
+
+#endif  // ASYNCLOGGER_H_
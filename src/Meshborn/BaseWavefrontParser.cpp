@@ -16,14 +16,245 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <cctype>   // for std::isspace
+#include <climits>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
 #include <fstream>
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>   // NOLINT
 #include <utility>
 #include "BaseWavefrontParser.h"
+#include "GzipDecoder.h"
+#include "TraceRecorder.h"
 
 namespace Meshborn {
 
+namespace {
+
+// Decoded chunks that may be waiting for the line splitter before the
+// inflate thread blocks, bounding memory use to a few megabytes.
+const size_t MAX_QUEUED_CHUNKS = 8;
+
+/**
+ * Bounded queue handing decoded chunks from the inflate thread to the
+ * thread splitting them into lines.
+ */
+class ChunkQueue {
+ public:
+    ChunkQueue() : closed_(false), cancelled_(false) {}
+
+    // Returns false once the queue is cancelled, to stop the producer.
+    bool Push(std::string&& chunk) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [this]() {
+            return chunks_.size() < MAX_QUEUED_CHUNKS || cancelled_;
+        });
+
+        if (cancelled_) {
+            return false;
+        }
+
+        chunks_.push_back(std::move(chunk));
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    void Close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        notEmpty_.notify_all();
+    }
+
+    // Drops queued chunks and wakes a producer waiting for room, for when
+    // the consumer stops early.
+    void Cancel() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cancelled_ = true;
+        closed_ = true;
+        chunks_.clear();
+        notFull_.notify_all();
+        notEmpty_.notify_all();
+    }
+
+    bool Pop(std::string *chunk) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [this]() {
+            return !chunks_.empty() || closed_;
+        });
+
+        if (chunks_.empty()) {
+            return false;
+        }
+
+        *chunk = std::move(chunks_.front());
+        chunks_.pop_front();
+        notFull_.notify_one();
+        return true;
+    }
+
+ private:
+    std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    std::deque<std::string> chunks_;
+    bool closed_;
+    bool cancelled_;
+};
+
+/**
+ * Joins the inflate thread if the splitter leaves without doing so, e.g.
+ * when adding a line throws. The queue is cancelled first so that an
+ * inflater waiting for room exits, letting the exception propagate rather
+ * than the thread's destructor terminating the process.
+ */
+class InflaterJoinGuard {
+ public:
+    InflaterJoinGuard(std::thread *thread, ChunkQueue *queue)
+        : thread_(thread), queue_(queue) {}
+
+    ~InflaterJoinGuard() {
+        if (thread_->joinable()) {
+            queue_->Cancel();
+            thread_->join();
+        }
+    }
+
+    InflaterJoinGuard(const InflaterJoinGuard&) = delete;
+    InflaterJoinGuard& operator=(const InflaterJoinGuard&) = delete;
+
+ private:
+    std::thread *thread_;
+    ChunkQueue *queue_;
+};
+
+/**
+ * Stores the lines of a file in a vector, overwriting the strings already
+ * in it so that their memory is reused when the vector is kept from one
+ * file to the next.
+ */
+class LineWriter {
+ public:
+    explicit LineWriter(std::vector<std::string> *lines)
+        : lines_(lines), count_(0) {}
+
+    // Keeps a line unless it is empty or a comment, stripping any Windows
+    // carriage return.
+    void Add(std::string_view line) {
+        if (line.empty() || line.starts_with("#")) {
+            return;
+        }
+
+        if (line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+
+        if (count_ < lines_->size()) {
+            (*lines_)[count_].assign(line);
+        } else {
+            lines_->emplace_back(line);
+        }
+
+        count_++;
+    }
+
+    // Lines stored so far. Strings past them are left from a longer file
+    // and keep their memory for the next one.
+    size_t GetCount() const {
+        return count_;
+    }
+
+ private:
+    std::vector<std::string> *lines_;
+    size_t count_;
+};
+
+/**
+ * Splits a gzip compressed file into lines.
+ *
+ * The file is inflated on a background thread while this thread splits
+ * each decoded chunk into lines, so decompression overlaps with the line
+ * handling rather than preceding it. It does not overlap with parsing:
+ * the compressed file is read in full first, and the parser only starts
+ * once every line has been split.
+ *
+ * @return The number of bytes the file inflated to.
+ */
+uint64_t ReadCompressedLines(const std::vector<uint8_t>& data,
+                             const std::string& filename,
+                             LineWriter *lines) {
+    ChunkQueue queue;
+    GzipDecoder decoder;
+    bool decoded = false;
+    std::exception_ptr inflateError;
+
+    std::thread inflater([&]() {
+        TRACE_SCOPE("Inflate", "io");
+
+        // Errors such as a failed allocation are passed to the splitter,
+        // as an exception leaving the thread would end the process.
+        try {
+            decoded = decoder.Decode(data.data(), data.size(),
+                [&queue](const char *chunk, size_t size) {
+                    return queue.Push(std::string(chunk, size));
+                });
+        }
+        catch (...) {
+            inflateError = std::current_exception();
+        }
+
+        queue.Close();
+    });
+    InflaterJoinGuard joinGuard(&inflater, &queue);
+
+    std::string partial;
+    std::string chunk;
+    uint64_t inflated = 0;
+
+    while (queue.Pop(&chunk)) {
+        TRACE_SCOPE("SplitChunk", "io");
+        inflated += chunk.size();
+        size_t start = 0;
+        size_t end;
+
+        while ((end = chunk.find('\n', start)) != std::string::npos) {
+            if (partial.empty()) {
+                lines->Add(std::string_view(chunk).substr(start,
+                                                          end - start));
+            } else {
+                partial.append(chunk, start, end - start);
+                lines->Add(partial);
+                partial.clear();
+            }
+
+            start = end + 1;
+        }
+
+        partial.append(chunk, start, std::string::npos);
+    }
+
+    inflater.join();
+
+    if (inflateError) {
+        std::rethrow_exception(inflateError);
+    }
+
+    if (!decoded) {
+        throw std::runtime_error("Failed to decompress file: " + filename +
+                                 " (" + decoder.GetError() + ")");
+    }
+
+    lines->Add(partial);
+    return inflated;
+}
+
+}   // namespace
+
 /**
  * Splits a space-delimited string into individual tokens.
  *
@@ -34,7 +265,7 @@ namespace Meshborn {
  * @return A vector of strings containing each token in the original string.
  */
 std::vector<std::string> BaseWavefrontParser::SplitElementString(
-    const std::string& str) {
+    const std::string& str) const {
     std::vector<std::string> tokens;
     std::istringstream iss(str);
     std::string token;
@@ -52,35 +283,83 @@ std::vector<std::string> BaseWavefrontParser::SplitElementString(
  * This function opens the specified file and reads its contents line by line.
  * It ignores lines that are empty or begin with the comment character '#'.
  * On Windows systems, it also removes any carriage return characters ('\r')
- * from the end of each line.
+ * from the end of each line. Files starting with the gzip magic number are
+ * decompressed as they are split into lines, whatever their extension; all
+ * lines are returned before any of them is parsed.
  *
  * @param filename The path to the file to read.
  * @return A vector of strings, each representing a relevant line from the file.
- * @throws std::runtime_error if the file cannot be opened.
+ * @throws std::runtime_error if the file cannot be opened or decompressed.
  */
 std::vector<std::string> BaseWavefrontParser::ReadFile(
-    const std::string& filename) {
+    const std::string& filename) const {
     std::vector<std::string> lines;
-    std::ifstream file(filename);
+    lines.resize(ReadFile(filename, &lines));
+    return lines;
+}
+
+/**
+ * Reads a text file line by line as ReadFile(filename) does, into a vector
+ * that may hold the lines of an earlier file.
+ *
+ * The strings already in the vector are overwritten rather than replaced,
+ * so a vector kept between files only allocates when a line is longer
+ * than any read before at its position. The vector is never shrunk: when
+ * the file has fewer lines than it holds, the strings past the returned
+ * count are left as they are for the next file to reuse.
+ *
+ * @param filename The path to the file to read.
+ * @param lines Receives the relevant lines of the file.
+ * @param bytesRead When not null, receives the size of the file's text,
+ *        after decompression, including the comments, blank lines and
+ *        line endings that are not kept.
+ * @return The number of lines of the file at the start of lines.
+ * @throws std::runtime_error if the file cannot be opened or decompressed.
+ */
+size_t BaseWavefrontParser::ReadFile(const std::string& filename,
+                                     std::vector<std::string> *lines,
+                                     uint64_t *bytesRead) const {
+    TRACE_SCOPE("ReadFile", "io");
+    LineWriter writer(lines);
+    std::ifstream file(filename, std::ios::binary);
 
     if (!file.is_open()) {
         throw std::runtime_error("Failed to open file: " + filename);
     }
 
+    uint8_t magic[2] = {};
+    file.read(reinterpret_cast<char *>(magic), sizeof(magic));
+
+    if (GzipDecoder::IsGzip(magic, static_cast<size_t>(file.gcount()))) {
+        file.seekg(0, std::ios::end);
+        std::vector<uint8_t> data(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(data.data()), data.size());
+        const uint64_t inflated = ReadCompressedLines(data, filename,
+                                                      &writer);
+        if (bytesRead) {
+            *bytesRead = inflated;
+        }
+
+        return writer.GetCount();
+    }
+
+    file.clear();
+
+    if (bytesRead) {
+        file.seekg(0, std::ios::end);
+        *bytesRead = static_cast<uint64_t>(file.tellg());
+    }
+
+    file.seekg(0);
+
     std::string line;
     while (std::getline(file, line)) {
         // Only keep the line if it's not empty or not a comment.
-        if (!line.empty() && !line.starts_with("#")) {
-            // Strip Windows carriage return
-            if (line.back() == '\r') {
-                line.pop_back();
-            }
-
-            lines.push_back(std::move(line));
-        }
+        writer.Add(line);
     }
 
-    return lines;
+    return writer.GetCount();
 }
 
 /**
@@ -98,7 +377,7 @@ std::vector<std::string> BaseWavefrontParser::ReadFile(
  *         false otherwise.
  */
 bool BaseWavefrontParser::StartsWith(const std::string& line,
-                                     const std::string& prefix) {
+                                     const std::string& prefix) const {
     size_t i = 0;
     while (i < line.size() &&
            std::isspace(static_cast<unsigned char>(line[i]))) {
@@ -121,7 +400,7 @@ bool BaseWavefrontParser::StartsWith(const std::string& line,
  * @param out A pointer to a float where the parsed result will be stored if successful.
  * @return true if the string was successfully parsed into a valid float, false otherwise.
  */
-bool BaseWavefrontParser::ParseFloat(const char* str, float *out) {
+bool BaseWavefrontParser::ParseFloat(const char* str, float *out) const {
     errno = 0;
     char* end;
     float value = strtof(str, &end);
@@ -146,7 +425,7 @@ bool BaseWavefrontParser::ParseFloat(const char* str, float *out) {
  * @return true if the string was successfully parsed into a valid integer,
  *         false otherwise.
  */
-bool BaseWavefrontParser::ParseInt(const char* str, int* out) {
+bool BaseWavefrontParser::ParseInt(const char* str, int* out) const {
     errno = 0;
     char* end;
 
@@ -17,6 +17,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #ifndef BASEWAVEFRONTPARSER_H_
 #define BASEWAVEFRONTPARSER_H_
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -24,15 +26,19 @@ namespace Meshborn {
 
 class BaseWavefrontParser {
  protected:
-    std::vector<std::string> ReadFile(const std::string& filename);
+    std::vector<std::string> ReadFile(const std::string& filename) const;
 
-    std::vector<std::string> SplitElementString(const std::string& str);
+    size_t ReadFile(const std::string& filename,
+                    std::vector<std::string> *lines,
+                    uint64_t *bytesRead = nullptr) const;
 
-    bool StartsWith(const std::string& line, const std::string& prefix);
+    std::vector<std::string> SplitElementString(const std::string& str) const;
 
-    bool ParseFloat(const char* str, float *out);
+    bool StartsWith(const std::string& line, const std::string& prefix) const;
 
-    bool ParseInt(const char* str, int *out);
+    bool ParseFloat(const char* str, float *out) const;
+
+    bool ParseInt(const char* str, int *out) const;
 };
 
 }   // namespace Meshborn
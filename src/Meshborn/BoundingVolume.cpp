@@ -0,0 +1,180 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include "BoundingVolume.h"
+#include "Simd.h"
+
+namespace Meshborn {
+
+static_assert(sizeof(Point4D) == 4 * sizeof(float),
+              "Point4D must be four packed floats to be loaded as a vector");
+
+AxisAlignedBoundingBox::AxisAlignedBoundingBox()
+    : min(FLT_MAX, FLT_MAX, FLT_MAX), max(-FLT_MAX, -FLT_MAX, -FLT_MAX) {
+}
+
+bool AxisAlignedBoundingBox::IsEmpty() const {
+    return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
+Point3D AxisAlignedBoundingBox::Centre() const {
+    return Point3D(0.5f * (min.x + max.x),
+                   0.5f * (min.y + max.y),
+                   0.5f * (min.z + max.z));
+}
+
+/**
+ * Grows the box so that it also encloses another box.
+ *
+ * @param other The box to enclose; merging an empty box has no effect.
+ */
+void AxisAlignedBoundingBox::Merge(const AxisAlignedBoundingBox& other) {
+    min = Point3D(std::min(min.x, other.min.x),
+                  std::min(min.y, other.min.y),
+                  std::min(min.z, other.min.z));
+    max = Point3D(std::max(max.x, other.max.x),
+                  std::max(max.y, other.max.y),
+                  std::max(max.z, other.max.z));
+}
+
+/**
+ * Computes the axis-aligned bounding box of a list of vertex positions.
+ *
+ * Where SSE2 is available each position is loaded as a single vector and
+ * folded into running minimum and maximum registers, using two pairs of
+ * accumulators to hide the latency of the min/max instructions.
+ *
+ * @param vertices The vertices to bound; the w component is ignored.
+ * @return The bounding box, empty if there are no vertices.
+ */
+AxisAlignedBoundingBox ComputeBoundingBox(
+    const std::vector<Vertex>& vertices) {
+    return ComputeBoundingBox(vertices.data(), vertices.size());
+}
+
+/**
+ * Computes the axis-aligned bounding box of a range of vertex positions,
+ * such as one mesh's range of a consolidated vertex buffer.
+ *
+ * @param vertices The first vertex to bound; the w component is ignored.
+ * @param count The number of vertices to bound.
+ * @return The bounding box, empty if there are no vertices.
+ */
+AxisAlignedBoundingBox ComputeBoundingBox(const Vertex *vertices,
+                                          size_t count) {
+    AxisAlignedBoundingBox box;
+
+    if (count == 0) {
+        return box;
+    }
+
+#ifdef MESHBORN_SSE2
+    __m128 min0 = _mm_set1_ps(FLT_MAX);
+    __m128 max0 = _mm_set1_ps(-FLT_MAX);
+    __m128 min1 = min0;
+    __m128 max1 = max0;
+
+    size_t i = 0;
+
+    for (; i + 1 < count; i += 2) {
+        __m128 a = _mm_loadu_ps(&vertices[i].position.x);
+        __m128 b = _mm_loadu_ps(&vertices[i + 1].position.x);
+        min0 = _mm_min_ps(min0, a);
+        max0 = _mm_max_ps(max0, a);
+        min1 = _mm_min_ps(min1, b);
+        max1 = _mm_max_ps(max1, b);
+    }
+
+    if (i < count) {
+        __m128 a = _mm_loadu_ps(&vertices[i].position.x);
+        min0 = _mm_min_ps(min0, a);
+        max0 = _mm_max_ps(max0, a);
+    }
+
+    float lo[4];
+    float hi[4];
+    _mm_storeu_ps(lo, _mm_min_ps(min0, min1));
+    _mm_storeu_ps(hi, _mm_max_ps(max0, max1));
+
+    box.min = Point3D(lo[0], lo[1], lo[2]);
+    box.max = Point3D(hi[0], hi[1], hi[2]);
+#else
+    for (size_t i = 0; i < count; ++i) {
+        const Point4D& p = vertices[i].position;
+        box.min = Point3D(std::min(box.min.x, p.x),
+                          std::min(box.min.y, p.y),
+                          std::min(box.min.z, p.z));
+        box.max = Point3D(std::max(box.max.x, p.x),
+                          std::max(box.max.y, p.y),
+                          std::max(box.max.z, p.z));
+    }
+#endif
+
+    return box;
+}
+
+/**
+ * Computes a bounding sphere centred on a bounding box.
+ *
+ * The radius is the distance to the furthest vertex rather than half the
+ * box diagonal, which gives a noticeably tighter sphere for most meshes.
+ *
+ * @param vertices The vertices to bound; the w component is ignored.
+ * @param box The bounding box of the same vertices.
+ * @return The bounding sphere, empty if there are no vertices.
+ */
+BoundingSphere ComputeBoundingSphere(const std::vector<Vertex>& vertices,
+                                     const AxisAlignedBoundingBox& box) {
+    return ComputeBoundingSphere(vertices.data(), vertices.size(), box);
+}
+
+/**
+ * Computes a bounding sphere for a range of vertices centred on their
+ * bounding box.
+ *
+ * @param vertices The first vertex to bound; the w component is ignored.
+ * @param count The number of vertices to bound.
+ * @param box The bounding box of the same vertices.
+ * @return The bounding sphere, empty if there are no vertices.
+ */
+BoundingSphere ComputeBoundingSphere(const Vertex *vertices, size_t count,
+                                     const AxisAlignedBoundingBox& box) {
+    BoundingSphere sphere;
+
+    if (count == 0 || box.IsEmpty()) {
+        return sphere;
+    }
+
+    sphere.centre = box.Centre();
+
+    float radiusSquared = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        const Vertex& vertex = vertices[i];
+        float dx = vertex.position.x - sphere.centre.x;
+        float dy = vertex.position.y - sphere.centre.y;
+        float dz = vertex.position.z - sphere.centre.z;
+        radiusSquared = std::max(radiusSquared, dx * dx + dy * dy + dz * dz);
+    }
+
+    sphere.radius = std::sqrt(radiusSquared);
+    return sphere;
+}
+
+}   // namespace Meshborn
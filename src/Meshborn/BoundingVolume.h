@@ -0,0 +1,68 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BOUNDINGVOLUME_H_
+#define BOUNDINGVOLUME_H_
+#include <vector>
+#include "Structures.h"
+
+namespace Meshborn {
+
+/**
+ * Axis-aligned bounding box. A default constructed box is empty, with its
+ * minimum greater than its maximum, so that merging it has no effect.
+ */
+struct AxisAlignedBoundingBox {
+    AxisAlignedBoundingBox();
+
+    bool IsEmpty() const;
+
+    Point3D Centre() const;
+
+    void Merge(const AxisAlignedBoundingBox& other);
+
+    Point3D min;
+    Point3D max;
+};
+
+/**
+ * Bounding sphere. A default constructed sphere is empty, which is flagged
+ * by a negative radius.
+ */
+struct BoundingSphere {
+    BoundingSphere() : radius(-1.0f) {}
+
+    bool IsEmpty() const { return radius < 0.0f; }
+
+    Point3D centre;
+    float radius;
+};
+
+AxisAlignedBoundingBox ComputeBoundingBox(const std::vector<Vertex>& vertices);
+
+AxisAlignedBoundingBox ComputeBoundingBox(const Vertex *vertices,
+                                          size_t count);
+
+BoundingSphere ComputeBoundingSphere(const std::vector<Vertex>& vertices,
+                                     const AxisAlignedBoundingBox& box);
+
+BoundingSphere ComputeBoundingSphere(const Vertex *vertices, size_t count,
+                                     const AxisAlignedBoundingBox& box);
+
+}   // namespace Meshborn
+
+#endif  // BOUNDINGVOLUME_H_
@@ -0,0 +1,728 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <format>
+#include <mutex>    // NOLINT
+#include <numeric>
+#include <thread>   // NOLINT
+#include <vector>
+#include "BoundingVolumeHierarchy.h"
+#include "LoggerManager.h"
+#include "Parallel.h"
+#include "Simd.h"
+
+namespace Meshborn {
+
+namespace {
+
+// Leaves are forced at this depth so that traversal can use a fixed size
+// stack.
+const int BVH_MAX_DEPTH = 64;
+
+// Node ranges at least this large have their bounds and bins computed on
+// several threads.
+const size_t BVH_PARALLEL_BIN_THRESHOLD = 65536;
+
+// Subtrees at least this large may be built on a thread of their own.
+const size_t BVH_PARALLEL_SUBTREE_THRESHOLD = 16384;
+
+float GetAxis(const Point3D& point, int axis) {
+    return axis == 0 ? point.x : (axis == 1 ? point.y : point.z);
+}
+
+void Grow(AxisAlignedBoundingBox *box, const Point3D& point) {
+    box->min = Point3D(std::min(box->min.x, point.x),
+                       std::min(box->min.y, point.y),
+                       std::min(box->min.z, point.z));
+    box->max = Point3D(std::max(box->max.x, point.x),
+                       std::max(box->max.y, point.y),
+                       std::max(box->max.z, point.z));
+}
+
+// Inline equivalent of AxisAlignedBoundingBox::Merge for the binning loops.
+void Grow(AxisAlignedBoundingBox *box, const AxisAlignedBoundingBox& other) {
+    box->min = Point3D(std::min(box->min.x, other.min.x),
+                       std::min(box->min.y, other.min.y),
+                       std::min(box->min.z, other.min.z));
+    box->max = Point3D(std::max(box->max.x, other.max.x),
+                       std::max(box->max.y, other.max.y),
+                       std::max(box->max.z, other.max.z));
+}
+
+float SurfaceArea(const AxisAlignedBoundingBox& box) {
+    if (box.IsEmpty()) {
+        return 0.0f;
+    }
+
+    float dx = box.max.x - box.min.x;
+    float dy = box.max.y - box.min.y;
+    float dz = box.max.z - box.min.z;
+    return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+struct Bin {
+    Bin() : count(0) {}
+
+    AxisAlignedBoundingBox bounds;
+    uint32_t count;
+};
+
+/**
+ * Top down binned SAH builder. Nodes are written into a preallocated array,
+ * with sibling pairs allocated through an atomic counter so that subtrees
+ * can be built concurrently.
+ */
+class Builder {
+ public:
+    Builder(const std::vector<AxisAlignedBoundingBox>& bounds,
+            const std::vector<Point3D>& centroids,
+            std::vector<uint32_t> *order,
+            std::vector<BvhNode> *nodes,
+            const BvhBuildOptions& options)
+        : bounds_(bounds), centroids_(centroids), order_(*order),
+          nodes_(*nodes), options_(options), nodeCount_(1),
+          spareThreads_(ResolveThreadCount(options.threadCount) - 1) {
+        binCount_ = std::max(2u, options.binCount);
+    }
+
+    void BuildNode(uint32_t nodeIndex, uint32_t start, uint32_t count,
+                   int depth);
+
+    uint32_t GetNodeCount() const { return nodeCount_; }
+
+ private:
+    void ComputeRangeBounds(uint32_t start, uint32_t count,
+                            AxisAlignedBoundingBox *box,
+                            AxisAlignedBoundingBox *centroidBox);
+
+    void FillBins(uint32_t start, uint32_t count,
+                  const AxisAlignedBoundingBox& centroidBox,
+                  std::vector<Bin> *bins);
+
+    uint32_t GetBinIndex(float centroid, float min, float scale) const {
+        float bin = (centroid - min) * scale;
+        return std::min(binCount_ - 1,
+                        static_cast<uint32_t>(std::max(bin, 0.0f)));
+    }
+
+    bool TryReserveThread();
+
+    const std::vector<AxisAlignedBoundingBox>& bounds_;
+    const std::vector<Point3D>& centroids_;
+    std::vector<uint32_t>& order_;
+    std::vector<BvhNode>& nodes_;
+    const BvhBuildOptions& options_;
+    uint32_t binCount_;
+    std::atomic<uint32_t> nodeCount_;
+    std::atomic<int> spareThreads_;
+};
+
+bool Builder::TryReserveThread() {
+    int spare = spareThreads_.load();
+    while (spare > 0) {
+        if (spareThreads_.compare_exchange_weak(spare, spare - 1)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Builder::ComputeRangeBounds(uint32_t start, uint32_t count,
+                                 AxisAlignedBoundingBox *box,
+                                 AxisAlignedBoundingBox *centroidBox) {
+    std::mutex mutex;
+
+    auto body = [&](size_t begin, size_t end) {
+        AxisAlignedBoundingBox localBox;
+        AxisAlignedBoundingBox localCentroids;
+
+        for (size_t i = start + begin; i < start + end; ++i) {
+            Grow(&localBox, bounds_[order_[i]]);
+            Grow(&localCentroids, centroids_[order_[i]]);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        box->Merge(localBox);
+        centroidBox->Merge(localCentroids);
+    };
+
+    if (count >= BVH_PARALLEL_BIN_THRESHOLD) {
+        ParallelFor(count, BVH_PARALLEL_BIN_THRESHOLD / 4, body,
+                    options_.threadCount);
+    } else {
+        body(0, count);
+    }
+}
+
+void Builder::FillBins(uint32_t start, uint32_t count,
+                       const AxisAlignedBoundingBox& centroidBox,
+                       std::vector<Bin> *bins) {
+    std::mutex mutex;
+    float scale[3];
+
+    for (int axis = 0; axis < 3; ++axis) {
+        float extent = GetAxis(centroidBox.max, axis) -
+                       GetAxis(centroidBox.min, axis);
+        scale[axis] = extent > 0.0f ? binCount_ / extent : 0.0f;
+    }
+
+    auto fill = [&](size_t begin, size_t end, std::vector<Bin> *target) {
+        for (size_t i = start + begin; i < start + end; ++i) {
+            const uint32_t triangle = order_[i];
+
+            for (int axis = 0; axis < 3; ++axis) {
+                Bin& bin = (*target)[axis * binCount_ + GetBinIndex(
+                    GetAxis(centroids_[triangle], axis),
+                    GetAxis(centroidBox.min, axis), scale[axis])];
+                Grow(&bin.bounds, bounds_[triangle]);
+                bin.count++;
+            }
+        }
+    };
+
+    if (count < BVH_PARALLEL_BIN_THRESHOLD) {
+        fill(0, count, bins);
+        return;
+    }
+
+    ParallelFor(count, BVH_PARALLEL_BIN_THRESHOLD / 4,
+        [&](size_t begin, size_t end) {
+        std::vector<Bin> local(bins->size());
+        fill(begin, end, &local);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < local.size(); ++i) {
+            (*bins)[i].bounds.Merge(local[i].bounds);
+            (*bins)[i].count += local[i].count;
+        }
+    }, options_.threadCount);
+}
+
+/**
+ * Builds the node at nodeIndex over order_[start, start + count).
+ *
+ * Each axis is split into equal bins over the centroid bounds and the bin
+ * boundary with the lowest surface area cost is chosen. A node becomes a
+ * leaf when it is small enough and no split is cheaper than intersecting
+ * its triangles directly.
+ */
+void Builder::BuildNode(uint32_t nodeIndex, uint32_t start, uint32_t count,
+                        int depth) {
+    AxisAlignedBoundingBox box;
+    AxisAlignedBoundingBox centroidBox;
+    ComputeRangeBounds(start, count, &box, &centroidBox);
+
+    BvhNode& node = nodes_[nodeIndex];
+    node.min[0] = box.min.x;
+    node.min[1] = box.min.y;
+    node.min[2] = box.min.z;
+    node.max[0] = box.max.x;
+    node.max[1] = box.max.y;
+    node.max[2] = box.max.z;
+    node.firstChildOrTriangle = start;
+    node.triangleCount = count;
+
+    if (count <= 1 || depth >= BVH_MAX_DEPTH) {
+        return;
+    }
+
+    std::vector<Bin> bins(3 * binCount_);
+    FillBins(start, count, centroidBox, &bins);
+
+    int bestAxis = -1;
+    uint32_t bestSplit = 0;
+    float bestCost = FLT_MAX;
+    std::vector<float> leftArea(binCount_);
+    std::vector<uint32_t> leftCount(binCount_);
+
+    for (int axis = 0; axis < 3; ++axis) {
+        if (GetAxis(centroidBox.max, axis) <= GetAxis(centroidBox.min, axis)) {
+            continue;
+        }
+
+        const Bin *axisBins = &bins[axis * binCount_];
+        AxisAlignedBoundingBox accumulated;
+        uint32_t accumulatedCount = 0;
+
+        for (uint32_t i = 0; i < binCount_; ++i) {
+            Grow(&accumulated, axisBins[i].bounds);
+            accumulatedCount += axisBins[i].count;
+            leftArea[i] = SurfaceArea(accumulated);
+            leftCount[i] = accumulatedCount;
+        }
+
+        accumulated = AxisAlignedBoundingBox();
+        accumulatedCount = 0;
+
+        // Split i puts bins [0, i) on the left and [i, binCount) right.
+        for (uint32_t i = binCount_ - 1; i > 0; --i) {
+            Grow(&accumulated, axisBins[i].bounds);
+            accumulatedCount += axisBins[i].count;
+
+            if (!leftCount[i - 1] || !accumulatedCount) {
+                continue;
+            }
+
+            float cost = leftArea[i - 1] * leftCount[i - 1] +
+                         SurfaceArea(accumulated) * accumulatedCount;
+
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = i;
+            }
+        }
+    }
+
+    // Cost of a leaf against an interior node, taking a traversal step to
+    // cost the same as a triangle test.
+    const float area = SurfaceArea(box);
+    const bool smallEnough = count <= options_.maxLeafTriangles;
+
+    if (smallEnough && (bestAxis < 0 || bestCost + area >= area * count)) {
+        return;
+    }
+
+    uint32_t leftTriangles;
+
+    if (bestAxis >= 0) {
+        const float min = GetAxis(centroidBox.min, bestAxis);
+        const float scale = binCount_ / (GetAxis(centroidBox.max, bestAxis) -
+                                         min);
+        auto first = order_.begin() + start;
+        auto middle = std::partition(first, first + count,
+            [&](uint32_t triangle) {
+                return GetBinIndex(GetAxis(centroids_[triangle], bestAxis),
+                                   min, scale) < bestSplit;
+            });
+        leftTriangles = static_cast<uint32_t>(middle - first);
+    } else {
+        // Every centroid is in the same place, so no split is better than
+        // any other; halve the range to keep leaves small.
+        leftTriangles = count / 2;
+    }
+
+    const uint32_t left = nodeCount_.fetch_add(2);
+    node.firstChildOrTriangle = left;
+    node.triangleCount = 0;
+
+    if (count >= BVH_PARALLEL_SUBTREE_THRESHOLD && TryReserveThread()) {
+        std::thread worker(&Builder::BuildNode, this, left, start,
+                           leftTriangles, depth + 1);
+        BuildNode(left + 1, start + leftTriangles, count - leftTriangles,
+                  depth + 1);
+        worker.join();
+        spareThreads_++;
+    } else {
+        BuildNode(left, start, leftTriangles, depth + 1);
+        BuildNode(left + 1, start + leftTriangles, count - leftTriangles,
+                  depth + 1);
+    }
+}
+
+/**
+ * Slab test of a ray against the box of a BvhNode. With SSE2 the three
+ * axes are tested at once by loading the node minimum and maximum as
+ * vectors; the fourth lane holds the node's index fields and is ignored.
+ */
+class RayBoxTester {
+ public:
+    explicit RayBoxTester(const Ray& ray) {
+        float inverse[3] = { 1.0f / ray.direction.x,
+                             1.0f / ray.direction.y,
+                             1.0f / ray.direction.z };
+#ifdef MESHBORN_SSE2
+        origin_ = _mm_setr_ps(ray.origin.x, ray.origin.y, ray.origin.z, 0.0f);
+        inverse_ = _mm_setr_ps(inverse[0], inverse[1], inverse[2], 0.0f);
+#else
+        origin_[0] = ray.origin.x;
+        origin_[1] = ray.origin.y;
+        origin_[2] = ray.origin.z;
+        std::copy(inverse, inverse + 3, inverse_);
+#endif
+    }
+
+    bool Test(const BvhNode& node, float minDistance, float maxDistance,
+              float *entry) const {
+#ifdef MESHBORN_SSE2
+        __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.min), origin_),
+                               inverse_);
+        __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.max), origin_),
+                               inverse_);
+        __m128 entries = _mm_min_ps(t1, t2);
+        __m128 exits = _mm_max_ps(t1, t2);
+
+        entries = _mm_max_ss(entries, _mm_shuffle_ps(
+            entries, entries, _MM_SHUFFLE(1, 1, 1, 1)));
+        entries = _mm_max_ss(entries, _mm_shuffle_ps(
+            entries, entries, _MM_SHUFFLE(2, 2, 2, 2)));
+        exits = _mm_min_ss(exits, _mm_shuffle_ps(
+            exits, exits, _MM_SHUFFLE(1, 1, 1, 1)));
+        exits = _mm_min_ss(exits, _mm_shuffle_ps(
+            exits, exits, _MM_SHUFFLE(2, 2, 2, 2)));
+
+        float tNear = std::max(_mm_cvtss_f32(entries), minDistance);
+        float tFar = std::min(_mm_cvtss_f32(exits), maxDistance);
+#else
+        float tNear = minDistance;
+        float tFar = maxDistance;
+
+        for (int axis = 0; axis < 3; ++axis) {
+            float t1 = (node.min[axis] - origin_[axis]) * inverse_[axis];
+            float t2 = (node.max[axis] - origin_[axis]) * inverse_[axis];
+            tNear = std::max(tNear, std::min(t1, t2));
+            tFar = std::min(tFar, std::max(t1, t2));
+        }
+#endif
+        *entry = tNear;
+        return tNear <= tFar;
+    }
+
+ private:
+#ifdef MESHBORN_SSE2
+    __m128 origin_;
+    __m128 inverse_;
+#else
+    float origin_[3];
+    float inverse_[3];
+#endif
+};
+
+}   // namespace
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy() {
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(
+    const BvhBuildOptions& options) : options_(options) {
+}
+
+/**
+ * Builds the hierarchy over every triangle in a model.
+ *
+ * Triangle bounds and centroids are gathered per mesh in parallel before the
+ * tree is built. Once built the triangles are reordered to match the
+ * leaves, so a leaf covers a contiguous run of triangles.
+ *
+ * @param model The model to build over; its meshes must be finalised, or
+ *              the model consolidated.
+ * @return true on success, false if the model cannot be processed.
+ */
+bool BoundingVolumeHierarchy::Build(const Model& model) {
+    nodes_.clear();
+    triangles_.clear();
+
+    const size_t meshCount = model.meshes.size();
+    std::vector<size_t> meshOffsets(meshCount + 1, 0);
+
+    for (size_t m = 0; m < meshCount; ++m) {
+        const Mesh& mesh = model.meshes[m];
+        size_t corners = 0;
+        size_t triangles = 0;
+
+        for (const auto& face : mesh.faces) {
+            corners += face.elements.size();
+            if (face.elements.size() >= 3) {
+                triangles += face.elements.size() - 2;
+            }
+        }
+
+        if (model.consolidated) {
+            const size_t indexBufferSize =
+                model.indexFormat == IndexFormat::UINT16 ?
+                model.indexBuffer16.size() : model.indexBuffer.size();
+
+            if (mesh.indexCount != triangles * 3 ||
+                mesh.indexOffset + mesh.indexCount > indexBufferSize) {
+                LOG(Logger::LogLevel::Critical, std::format(
+                    "Mesh '{}' does not match its index range, unable to "
+                    "build BVH", mesh.name));
+                return false;
+            }
+        } else if (corners != mesh.vertices.size()) {
+            LOG(Logger::LogLevel::Critical, std::format(
+                "Mesh '{}' has not been finalised, unable to build BVH",
+                mesh.name));
+            return false;
+        }
+
+        meshOffsets[m + 1] = meshOffsets[m] + triangles;
+    }
+
+    const size_t triangleCount = meshOffsets.back();
+
+    if (triangleCount == 0) {
+        return true;
+    }
+
+    if (triangleCount > UINT32_MAX / 2) {
+        LOG(Logger::LogLevel::Critical, std::format(
+            "Too many triangles ({}) to build a BVH", triangleCount));
+        return false;
+    }
+
+    std::vector<Triangle> triangles(triangleCount);
+    std::vector<AxisAlignedBoundingBox> bounds(triangleCount);
+    std::vector<Point3D> centroids(triangleCount);
+
+    ParallelFor(meshCount, 1, [&](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; ++m) {
+            const Mesh& mesh = model.meshes[m];
+            const Vertex *vertices = model.consolidated ?
+                model.vertexBuffer.data() + mesh.vertexOffset :
+                mesh.vertices.data();
+            const bool shortIndices =
+                model.indexFormat == IndexFormat::UINT16;
+            const uint32_t *indices = model.indexBuffer.data() +
+                                      mesh.indexOffset;
+            const uint16_t *indices16 = model.indexBuffer16.data() +
+                                        mesh.indexOffset;
+            size_t triangle = meshOffsets[m];
+            size_t corner = 0;
+
+            for (size_t f = 0; f < mesh.faces.size(); ++f) {
+                const size_t count = mesh.faces[f].elements.size();
+
+                for (size_t i = 1; i + 1 < count; ++i, ++triangle) {
+                    // Consolidated meshes hold the same fans, in face order,
+                    // in their index range.
+                    size_t ia = corner;
+                    size_t ib = corner + i;
+                    size_t ic = corner + i + 1;
+
+                    if (model.consolidated) {
+                        const size_t local = (triangle - meshOffsets[m]) * 3;
+                        ia = shortIndices ? indices16[local] : indices[local];
+                        ib = shortIndices ? indices16[local + 1]
+                                          : indices[local + 1];
+                        ic = shortIndices ? indices16[local + 2]
+                                          : indices[local + 2];
+                    }
+
+                    const Point4D& a = vertices[ia].position;
+                    const Point4D& b = vertices[ib].position;
+                    const Point4D& c = vertices[ic].position;
+
+                    Triangle& t = triangles[triangle];
+                    t.vertex = Point3D(a.x, a.y, a.z);
+                    t.edge1 = Point3D(b.x - a.x, b.y - a.y, b.z - a.z);
+                    t.edge2 = Point3D(c.x - a.x, c.y - a.y, c.z - a.z);
+                    t.mesh = static_cast<uint32_t>(m);
+                    t.face = static_cast<uint32_t>(f);
+
+                    AxisAlignedBoundingBox& box = bounds[triangle];
+                    Grow(&box, Point3D(a.x, a.y, a.z));
+                    Grow(&box, Point3D(b.x, b.y, b.z));
+                    Grow(&box, Point3D(c.x, c.y, c.z));
+                    centroids[triangle] = box.Centre();
+                }
+
+                corner += count;
+            }
+        }
+    }, options_.threadCount);
+
+    std::vector<uint32_t> order(triangleCount);
+    std::iota(order.begin(), order.end(), 0u);
+
+    nodes_.resize(2 * triangleCount - 1);
+
+    Builder builder(bounds, centroids, &order, &nodes_, options_);
+    builder.BuildNode(0, 0, static_cast<uint32_t>(triangleCount), 0);
+    nodes_.resize(builder.GetNodeCount());
+    nodes_.shrink_to_fit();
+
+    triangles_.resize(triangleCount);
+    ParallelFor(triangleCount, 65536, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            triangles_[i] = triangles[order[i]];
+        }
+    }, options_.threadCount);
+
+    LOG(Logger::LogLevel::Debug, std::format(
+        "BVH built => triangles: {} | nodes: {}",
+        triangleCount, nodes_.size()));
+
+    return true;
+}
+
+/**
+ * Finds the closest intersection of a ray with the model.
+ *
+ * @param ray The ray to trace.
+ * @param hit Receives the closest hit if one is found.
+ * @return true if the ray hits a triangle within its distance range.
+ */
+bool BoundingVolumeHierarchy::Intersect(const Ray& ray, RayHit *hit) const {
+    return Traverse(ray, false, hit);
+}
+
+/**
+ * Tests whether a ray hits anything, stopping at the first hit found. This
+ * is cheaper than Intersect for visibility queries.
+ *
+ * @param ray The ray to trace.
+ * @return true if the ray hits a triangle within its distance range.
+ */
+bool BoundingVolumeHierarchy::IsOccluded(const Ray& ray) const {
+    RayHit hit;
+    return Traverse(ray, true, &hit);
+}
+
+/**
+ * Walks the hierarchy front to back with an explicit stack, always
+ * descending into the nearer child first and skipping stacked nodes that
+ * are further away than the closest hit found so far.
+ */
+bool BoundingVolumeHierarchy::Traverse(const Ray& ray, bool anyHit,
+                                       RayHit *hit) const {
+    if (nodes_.empty()) {
+        return false;
+    }
+
+    struct StackEntry {
+        uint32_t node;
+        float entry;
+    };
+
+    const RayBoxTester tester(ray);
+    StackEntry stack[BVH_MAX_DEPTH + 1];
+    int stackSize = 0;
+    float closest = ray.maxDistance;
+    bool found = false;
+    float entry;
+
+    if (!tester.Test(nodes_[0], ray.minDistance, closest, &entry)) {
+        return false;
+    }
+
+    stack[stackSize++] = { 0, entry };
+
+    while (stackSize > 0) {
+        const StackEntry current = stack[--stackSize];
+
+        if (current.entry > closest) {
+            continue;
+        }
+
+        uint32_t nodeIndex = current.node;
+
+        while (true) {
+            const BvhNode& node = nodes_[nodeIndex];
+
+            if (node.triangleCount) {
+                const uint32_t first = node.firstChildOrTriangle;
+
+                for (uint32_t i = first; i < first + node.triangleCount; ++i) {
+                    if (IntersectTriangle(triangles_[i], ray, closest, hit)) {
+                        closest = hit->distance;
+                        found = true;
+
+                        if (anyHit) {
+                            return true;
+                        }
+                    }
+                }
+                break;
+            }
+
+            const uint32_t left = node.firstChildOrTriangle;
+            float leftEntry;
+            float rightEntry;
+            bool hitLeft = tester.Test(nodes_[left], ray.minDistance,
+                                       closest, &leftEntry);
+            bool hitRight = tester.Test(nodes_[left + 1], ray.minDistance,
+                                        closest, &rightEntry);
+
+            if (hitLeft && hitRight) {
+                if (rightEntry < leftEntry) {
+                    stack[stackSize++] = { left, leftEntry };
+                    nodeIndex = left + 1;
+                } else {
+                    stack[stackSize++] = { left + 1, rightEntry };
+                    nodeIndex = left;
+                }
+            } else if (hitLeft) {
+                nodeIndex = left;
+            } else if (hitRight) {
+                nodeIndex = left + 1;
+            } else {
+                break;
+            }
+        }
+    }
+
+    return found;
+}
+
+/**
+ * Moller-Trumbore ray/triangle intersection.
+ */
+bool BoundingVolumeHierarchy::IntersectTriangle(const Triangle& triangle,
+                                                const Ray& ray,
+                                                float maxDistance,
+                                                RayHit *hit) const {
+    const Point3D& d = ray.direction;
+    const Point3D& e1 = triangle.edge1;
+    const Point3D& e2 = triangle.edge2;
+
+    float px = d.y * e2.z - d.z * e2.y;
+    float py = d.z * e2.x - d.x * e2.z;
+    float pz = d.x * e2.y - d.y * e2.x;
+    float determinant = e1.x * px + e1.y * py + e1.z * pz;
+
+    if (determinant == 0.0f) {
+        return false;
+    }
+
+    float inverse = 1.0f / determinant;
+    float sx = ray.origin.x - triangle.vertex.x;
+    float sy = ray.origin.y - triangle.vertex.y;
+    float sz = ray.origin.z - triangle.vertex.z;
+
+    float u = (sx * px + sy * py + sz * pz) * inverse;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+
+    float qx = sy * e1.z - sz * e1.y;
+    float qy = sz * e1.x - sx * e1.z;
+    float qz = sx * e1.y - sy * e1.x;
+
+    float v = (d.x * qx + d.y * qy + d.z * qz) * inverse;
+    if (v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+
+    float t = (e2.x * qx + e2.y * qy + e2.z * qz) * inverse;
+    if (t < ray.minDistance || t >= maxDistance) {
+        return false;
+    }
+
+    hit->distance = t;
+    hit->u = u;
+    hit->v = v;
+    hit->mesh = triangle.mesh;
+    hit->face = triangle.face;
+    return true;
+}
+
+}   // namespace Meshborn
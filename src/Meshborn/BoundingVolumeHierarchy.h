@@ -0,0 +1,139 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BOUNDINGVOLUMEHIERARCHY_H_
+#define BOUNDINGVOLUMEHIERARCHY_H_
+#include <cfloat>
+#include <cstdint>
+#include <vector>
+#include "Model.h"
+#include "Structures.h"
+
+namespace Meshborn {
+
+/**
+ * A ray for BVH queries. The direction does not need to be normalised;
+ * distances are measured in multiples of it.
+ */
+struct Ray {
+    Ray() : minDistance(0.0f), maxDistance(FLT_MAX) {}
+    Ray(Point3D origin, Point3D direction)
+        : origin(origin), direction(direction), minDistance(0.0f),
+          maxDistance(FLT_MAX) {}
+
+    Point3D origin;
+    Point3D direction;
+    float minDistance;
+    float maxDistance;
+};
+
+/**
+ * The closest intersection found by a ray query.
+ */
+struct RayHit {
+    RayHit() : distance(FLT_MAX), u(0.0f), v(0.0f), mesh(UINT32_MAX),
+               face(UINT32_MAX) {}
+
+    // Distance along the ray, in multiples of the ray direction.
+    float distance;
+
+    // Barycentric coordinates within the hit triangle.
+    float u;
+    float v;
+
+    // Index of the mesh in Model::meshes and the face in Mesh::faces.
+    uint32_t mesh;
+    uint32_t face;
+};
+
+/**
+ * A 32 byte BVH node. Interior nodes have a triangle count of 0 and store
+ * the index of their left child, with the right child immediately after it.
+ * Leaf nodes store the index of their first triangle.
+ */
+struct BvhNode {
+    float min[3];
+    uint32_t firstChildOrTriangle;
+    float max[3];
+    uint32_t triangleCount;
+};
+
+/**
+ * Settings controlling how the BVH is built.
+ */
+struct BvhBuildOptions {
+    BvhBuildOptions() : binCount(16), maxLeafTriangles(4), threadCount(0) {}
+
+    // Number of bins used to evaluate the surface area heuristic per axis.
+    unsigned int binCount;
+
+    // Nodes with more triangles than this are always split where possible.
+    unsigned int maxLeafTriangles;
+
+    // Maximum worker threads, 0 selects the hardware default.
+    unsigned int threadCount;
+};
+
+/**
+ * Bounding volume hierarchy over the triangles of a Model.
+ *
+ * The hierarchy is built top down with a binned surface area heuristic,
+ * building large subtrees on separate threads, and is stored as a flat
+ * array of BvhNode with triangles reordered to match the leaves. Polygonal
+ * faces are split into triangle fans. Only the meshes are included, not
+ * their instances, so the hierarchy can be shared by every placement.
+ */
+class BoundingVolumeHierarchy {
+ public:
+    BoundingVolumeHierarchy();
+
+    explicit BoundingVolumeHierarchy(const BvhBuildOptions& options);
+
+    bool Build(const Model& model);
+
+    bool Intersect(const Ray& ray, RayHit *hit) const;
+
+    bool IsOccluded(const Ray& ray) const;
+
+    const std::vector<BvhNode>& GetNodes() const { return nodes_; }
+
+    size_t GetTriangleCount() const { return triangles_.size(); }
+
+ private:
+    // Triangle stored as a vertex and two edges, ready for the
+    // Moller-Trumbore intersection test.
+    struct Triangle {
+        Point3D vertex;
+        Point3D edge1;
+        Point3D edge2;
+        uint32_t mesh;
+        uint32_t face;
+    };
+
+    bool Traverse(const Ray& ray, bool anyHit, RayHit *hit) const;
+
+    bool IntersectTriangle(const Triangle& triangle, const Ray& ray,
+                           float maxDistance, RayHit *hit) const;
+
+    BvhBuildOptions options_;
+    std::vector<BvhNode> nodes_;
+    std::vector<Triangle> triangles_;
+};
+
+}   // namespace Meshborn
+
+#endif  // BOUNDINGVOLUMEHIERARCHY_H_
@@ -0,0 +1,264 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <utility>
+#include <vector>
+#include "BufferConsolidator.h"
+#include "LoggerManager.h"
+#include "Parallel.h"
+
+namespace Meshborn {
+
+namespace {
+
+const uint32_t EMPTY_SLOT = UINT32_MAX;
+
+/**
+ * Vertices and triangle indices of one mesh, with the vertices given as the
+ * first corner that produced each unique vertex.
+ */
+struct MeshRanges {
+    std::vector<uint32_t> corners;
+    std::vector<uint32_t> indices;
+};
+
+uint64_t HashBytes(const void *data, size_t size, uint64_t hash) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+
+    return hash;
+}
+
+/**
+ * Finds the unique vertices of a finalised mesh and triangulates its faces.
+ *
+ * Corners are matched on every byte of the vertex, plus the tangent when the
+ * mesh has them, using an open addressing table so that a mesh only needs
+ * a single allocation however many corners it has.
+ */
+bool BuildMeshRanges(const Mesh& mesh, MeshRanges *ranges) {
+    const auto& vertices = mesh.vertices;
+    const bool hasTangents = mesh.tangents.size() == vertices.size() &&
+                             !vertices.empty();
+    size_t cornerCount = 0;
+    size_t triangleCount = 0;
+
+    for (const auto& face : mesh.faces) {
+        cornerCount += face.elements.size();
+        if (face.elements.size() >= 3) {
+            triangleCount += face.elements.size() - 2;
+        }
+    }
+
+    if (cornerCount != vertices.size()) {
+        LOG(Logger::LogLevel::Critical, std::format(
+            "Mesh '{}' has not been finalised, unable to consolidate it",
+            mesh.name));
+        return false;
+    }
+
+    if (cornerCount >= EMPTY_SLOT) {
+        LOG(Logger::LogLevel::Critical, std::format(
+            "Mesh '{}' has too many vertices ({}) to consolidate",
+            mesh.name, cornerCount));
+        return false;
+    }
+
+    size_t tableSize = 16;
+    while (tableSize < cornerCount * 2) {
+        tableSize *= 2;
+    }
+
+    std::vector<uint32_t> table(tableSize, EMPTY_SLOT);
+    std::vector<uint32_t> remap(cornerCount);
+
+    ranges->corners.clear();
+    ranges->corners.reserve(cornerCount);
+
+    for (size_t corner = 0; corner < cornerCount; ++corner) {
+        uint64_t hash = HashBytes(&vertices[corner], sizeof(Vertex),
+                                  1469598103934665603ull);
+        if (hasTangents) {
+            hash = HashBytes(&mesh.tangents[corner], sizeof(Point4D), hash);
+        }
+
+        size_t slot = static_cast<size_t>(hash ^ (hash >> 32)) &
+                      (tableSize - 1);
+
+        while (true) {
+            uint32_t unique = table[slot];
+
+            if (unique == EMPTY_SLOT) {
+                unique = static_cast<uint32_t>(ranges->corners.size());
+                table[slot] = unique;
+                ranges->corners.push_back(static_cast<uint32_t>(corner));
+                remap[corner] = unique;
+                break;
+            }
+
+            const uint32_t other = ranges->corners[unique];
+            if (std::memcmp(&vertices[corner], &vertices[other],
+                            sizeof(Vertex)) == 0 &&
+                (!hasTangents ||
+                 std::memcmp(&mesh.tangents[corner], &mesh.tangents[other],
+                             sizeof(Point4D)) == 0)) {
+                remap[corner] = unique;
+                break;
+            }
+
+            slot = (slot + 1) & (tableSize - 1);
+        }
+    }
+
+    ranges->indices.clear();
+    ranges->indices.reserve(triangleCount * 3);
+
+    size_t first = 0;
+    for (const auto& face : mesh.faces) {
+        const size_t count = face.elements.size();
+
+        for (size_t i = 1; i + 1 < count; ++i) {
+            ranges->indices.push_back(remap[first]);
+            ranges->indices.push_back(remap[first + i]);
+            ranges->indices.push_back(remap[first + i + 1]);
+        }
+
+        first += count;
+    }
+
+    return true;
+}
+
+}   // namespace
+
+BufferConsolidator::BufferConsolidator() {
+}
+
+BufferConsolidator::BufferConsolidator(
+    const BufferConsolidationOptions& options) : options_(options) {
+}
+
+/**
+ * Consolidates the vertices of every mesh in a model into shared buffers.
+ *
+ * Meshes are deduplicated and triangulated in parallel, their ranges are
+ * laid out in mesh order and then copied into the shared buffers, again in
+ * parallel. Indices are relative to the mesh's vertexOffset, which is the
+ * base vertex to draw with. Triangles are emitted face by face as fans, so
+ * a face of n corners owns the next n - 2 triangles of its mesh's range.
+ *
+ * The per-mesh vertex and tangent lists are released once copied; faces are
+ * kept. A tangent buffer parallel to the vertex buffer is only filled when
+ * some mesh has tangents, in which case meshes without them get zero
+ * tangents.
+ *
+ * @param model Pointer to the model to consolidate; its meshes must have
+ *              been finalised.
+ * @return true on success, false if any mesh could not be processed.
+ */
+bool BufferConsolidator::Consolidate(Model *model) {
+    if (!model) {
+        LOG(Logger::LogLevel::Critical,
+            "Invalid model passed to BufferConsolidator");
+        return false;
+    }
+
+    if (model->consolidated) {
+        return true;
+    }
+
+    const size_t meshCount = model->meshes.size();
+    std::vector<MeshRanges> ranges(meshCount);
+    std::atomic<bool> status = true;
+
+    ParallelFor(meshCount, 1, [&](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; ++m) {
+            if (!BuildMeshRanges(model->meshes[m], &ranges[m])) {
+                status = false;
+            }
+        }
+    }, options_.threadCount);
+
+    if (!status) {
+        return false;
+    }
+
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    bool hasTangents = false;
+
+    for (size_t m = 0; m < meshCount; ++m) {
+        Mesh& mesh = model->meshes[m];
+
+        mesh.vertexOffset = vertexCount;
+        mesh.vertexCount = ranges[m].corners.size();
+        mesh.indexOffset = indexCount;
+        mesh.indexCount = ranges[m].indices.size();
+
+        vertexCount += mesh.vertexCount;
+        indexCount += mesh.indexCount;
+        hasTangents = hasTangents || !mesh.tangents.empty();
+    }
+
+    model->vertexBuffer.resize(vertexCount);
+    model->indexBuffer.resize(indexCount);
+    model->tangentBuffer.assign(hasTangents ? vertexCount : 0,
+                                Point4D(0.0f, 0.0f, 0.0f, 0.0f));
+
+    ParallelFor(meshCount, 1, [&](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; ++m) {
+            Mesh& mesh = model->meshes[m];
+            const MeshRanges& range = ranges[m];
+            const bool copyTangents = hasTangents &&
+                mesh.tangents.size() == mesh.vertices.size();
+
+            for (size_t i = 0; i < range.corners.size(); ++i) {
+                model->vertexBuffer[mesh.vertexOffset + i] =
+                    mesh.vertices[range.corners[i]];
+
+                if (copyTangents) {
+                    model->tangentBuffer[mesh.vertexOffset + i] =
+                        mesh.tangents[range.corners[i]];
+                }
+            }
+
+            std::copy(range.indices.begin(), range.indices.end(),
+                      model->indexBuffer.begin() + mesh.indexOffset);
+
+            std::vector<Vertex>().swap(mesh.vertices);
+            std::vector<Point4D>().swap(mesh.tangents);
+        }
+    }, options_.threadCount);
+
+    model->consolidated = true;
+
+    LOG(Logger::LogLevel::Debug, std::format(
+        "CONSOLIDATED => {} meshes, {} vertices, {} indices",
+        meshCount, vertexCount, indexCount));
+
+    return true;
+}
+
+}   // namespace Meshborn
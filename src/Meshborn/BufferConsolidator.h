@@ -0,0 +1,57 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BUFFERCONSOLIDATOR_H_
+#define BUFFERCONSOLIDATOR_H_
+#include "Model.h"
+
+namespace Meshborn {
+
+/**
+ * Settings controlling buffer consolidation.
+ */
+struct BufferConsolidationOptions {
+    BufferConsolidationOptions() : threadCount(0) {}
+
+    // Maximum worker threads, 0 selects the hardware default.
+    unsigned int threadCount;
+};
+
+/**
+ * Moves the vertices of every mesh in a model into one shared vertex buffer
+ * and one shared triangle index buffer.
+ *
+ * Identical vertices within a mesh are stored once and faces are split into
+ * triangle fans. Each mesh is left describing its range of the shared
+ * buffers, so the whole model can be uploaded in one go and drawn with a
+ * single multi-draw call.
+ */
+class BufferConsolidator {
+ public:
+    BufferConsolidator();
+
+    explicit BufferConsolidator(const BufferConsolidationOptions& options);
+
+    bool Consolidate(Model *model);
+
+ private:
+    BufferConsolidationOptions options_;
+};
+
+}   // namespace Meshborn
+
+#endif  // BUFFERCONSOLIDATOR_H_
@@ -0,0 +1,461 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <vector>
+#include "GeometryCodec.h"
+#include "Simd.h"
+
+namespace Meshborn {
+
+namespace {
+
+const size_t INDEX_BLOCK_SIZE = 128;
+const size_t VERTEX_BLOCK_SIZE = 256;
+
+// Largest vertex stride accepted, which bounds the decoder's scratch space.
+const size_t MAX_VERTEX_STRIDE = 4096;
+
+const size_t INDEX_HEADER_SIZE = 8;
+const size_t VERTEX_HEADER_SIZE = 12;
+
+// Packed blocks are copied into scratch space with this much zero padding
+// so values can be extracted with unaligned 64-bit loads.
+const size_t UNPACK_PADDING = 8;
+
+void WriteLittleEndian(std::vector<uint8_t> *output, uint64_t value,
+                       size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        output->push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+uint64_t ReadLittleEndian(const uint8_t *data, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * Appends values of a fixed bit width to a byte stream, least significant
+ * bit first.
+ */
+class BitWriter {
+ public:
+    explicit BitWriter(std::vector<uint8_t> *output)
+        : output_(output), bits_(0), bitCount_(0) {}
+
+    void Write(uint32_t value, unsigned int width) {
+        bits_ |= static_cast<uint64_t>(value) << bitCount_;
+        bitCount_ += width;
+
+        while (bitCount_ >= 8) {
+            output_->push_back(static_cast<uint8_t>(bits_));
+            bits_ >>= 8;
+            bitCount_ -= 8;
+        }
+    }
+
+    void Flush() {
+        if (bitCount_ > 0) {
+            output_->push_back(static_cast<uint8_t>(bits_));
+        }
+
+        bits_ = 0;
+        bitCount_ = 0;
+    }
+
+ private:
+    std::vector<uint8_t> *output_;
+    uint64_t bits_;
+    unsigned int bitCount_;
+};
+
+size_t PackedSize(size_t count, unsigned int width) {
+    return (count * width + 7) / 8;
+}
+
+// Reads the value at position index from a zero padded packed block using
+// a native 64-bit load, which assumes a little-endian host.
+uint32_t Unpack(const uint8_t *packed, size_t index, unsigned int width,
+                uint32_t mask) {
+    const size_t bit = index * width;
+    uint64_t word;
+    std::memcpy(&word, packed + bit / 8, sizeof(word));
+    return static_cast<uint32_t>(word >> (bit & 7)) & mask;
+}
+
+uint32_t ZigzagEncode(uint32_t delta) {
+    return (delta << 1) ^
+           static_cast<uint32_t>(static_cast<int32_t>(delta) >> 31);
+}
+
+uint32_t ZigzagDecode(uint32_t value) {
+    return (value >> 1) ^ (0u - (value & 1u));
+}
+
+uint8_t ZigzagEncode8(uint8_t delta) {
+    return static_cast<uint8_t>((delta << 1) ^ (delta & 0x80 ? 0xFF : 0x00));
+}
+
+#ifndef MESHBORN_SSE2
+uint8_t ZigzagDecode8(uint8_t value) {
+    return static_cast<uint8_t>((value >> 1) ^ (0u - (value & 1u)));
+}
+#endif
+
+/**
+ * Undoes the zigzag mapping and delta coding of a block of indices.
+ */
+uint32_t RestoreIndices(const uint32_t *values, size_t count,
+                        uint32_t previous, uint32_t *indices) {
+    size_t i = 0;
+
+#ifdef MESHBORN_SSE2
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i carry = _mm_set1_epi32(static_cast<int>(previous));
+
+    for (; i + 4 <= count; i += 4) {
+        __m128i x = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(values + i));
+        x = _mm_xor_si128(_mm_srli_epi32(x, 1),
+                          _mm_sub_epi32(zero, _mm_and_si128(x, one)));
+
+        // Inclusive prefix sum of the four deltas, then add the carry in.
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, carry);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(indices + i), x);
+        carry = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+
+    if (i > 0) {
+        previous = indices[i - 1];
+    }
+#endif
+
+    for (; i < count; ++i) {
+        previous += ZigzagDecode(values[i]);
+        indices[i] = previous;
+    }
+
+    return previous;
+}
+
+/**
+ * Undoes the zigzag mapping and delta coding of one row of vertex bytes,
+ * adding it to the previous row in place. Both rows are padded to a
+ * multiple of 16 bytes.
+ */
+void RestoreRow(const uint8_t *deltas, uint8_t *row, size_t pitch) {
+#ifdef MESHBORN_SSE2
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i low7 = _mm_set1_epi8(0x7F);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (size_t i = 0; i < pitch; i += 16) {
+        __m128i d = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(deltas + i));
+        d = _mm_xor_si128(_mm_and_si128(_mm_srli_epi16(d, 1), low7),
+                          _mm_sub_epi8(zero, _mm_and_si128(d, one)));
+
+        __m128i *target = reinterpret_cast<__m128i *>(row + i);
+        _mm_storeu_si128(target, _mm_add_epi8(_mm_loadu_si128(target), d));
+    }
+#else
+    for (size_t i = 0; i < pitch; ++i) {
+        row[i] = static_cast<uint8_t>(row[i] + ZigzagDecode8(deltas[i]));
+    }
+#endif
+}
+
+}   // namespace
+
+/**
+ * Compresses a stream of indices, appending it to output.
+ *
+ * @param indices The indices to encode.
+ * @param count The number of indices.
+ * @param output Buffer the encoded stream is appended to.
+ */
+void GeometryCodec::EncodeIndices(const uint32_t *indices, size_t count,
+                                  std::vector<uint8_t> *output) {
+    WriteLittleEndian(output, count, INDEX_HEADER_SIZE);
+
+    uint32_t values[INDEX_BLOCK_SIZE];
+    uint32_t previous = 0;
+
+    for (size_t start = 0; start < count; start += INDEX_BLOCK_SIZE) {
+        const size_t blockCount = std::min(INDEX_BLOCK_SIZE, count - start);
+        uint32_t combined = 0;
+
+        for (size_t i = 0; i < blockCount; ++i) {
+            values[i] = ZigzagEncode(indices[start + i] - previous);
+            combined |= values[i];
+            previous = indices[start + i];
+        }
+
+        const unsigned int width = std::bit_width(combined);
+        output->push_back(static_cast<uint8_t>(width));
+
+        BitWriter writer(output);
+        for (size_t i = 0; i < blockCount && width > 0; ++i) {
+            writer.Write(values[i], width);
+        }
+        writer.Flush();
+    }
+}
+
+/**
+ * Reads the number of indices held by an encoded index stream.
+ *
+ * @return true on success, false if the stream is too short.
+ */
+bool GeometryCodec::GetIndexCount(const uint8_t *data, size_t size,
+                                  size_t *count) {
+    if (!data || size < INDEX_HEADER_SIZE) {
+        return false;
+    }
+
+    *count = static_cast<size_t>(ReadLittleEndian(data, INDEX_HEADER_SIZE));
+    return true;
+}
+
+/**
+ * Decompresses an index stream.
+ *
+ * @param data The encoded stream.
+ * @param size The size of the encoded stream in bytes.
+ * @param indices Receives the indices.
+ * @param count The number of indices indices can hold, which must match
+ *              the stream.
+ * @return true on success, false if the stream is corrupt, truncated or
+ *         holds a different number of indices.
+ */
+bool GeometryCodec::DecodeIndices(const uint8_t *data, size_t size,
+                                  uint32_t *indices, size_t count) {
+    size_t streamCount;
+
+    if (!GetIndexCount(data, size, &streamCount) || streamCount != count) {
+        return false;
+    }
+
+    uint8_t packed[INDEX_BLOCK_SIZE * sizeof(uint32_t) + UNPACK_PADDING];
+    uint32_t values[INDEX_BLOCK_SIZE];
+    uint32_t previous = 0;
+    size_t position = INDEX_HEADER_SIZE;
+
+    for (size_t start = 0; start < count; start += INDEX_BLOCK_SIZE) {
+        const size_t blockCount = std::min(INDEX_BLOCK_SIZE, count - start);
+
+        if (position >= size || data[position] > 32) {
+            return false;
+        }
+
+        const unsigned int width = data[position++];
+        const size_t bytes = PackedSize(blockCount, width);
+
+        if (bytes > size - position) {
+            return false;
+        }
+
+        if (width == 0) {
+            std::fill(values, values + blockCount, 0u);
+        } else {
+            const uint32_t mask = width == 32 ? UINT32_MAX
+                                              : (1u << width) - 1;
+            std::memcpy(packed, data + position, bytes);
+            std::memset(packed + bytes, 0, UNPACK_PADDING);
+
+            for (size_t i = 0; i < blockCount; ++i) {
+                values[i] = Unpack(packed, i, width, mask);
+            }
+        }
+
+        position += bytes;
+        previous = RestoreIndices(values, blockCount, previous,
+                                  indices + start);
+    }
+
+    return true;
+}
+
+/**
+ * Compresses a stream of fixed size vertices, appending it to output.
+ *
+ * @param vertices The first vertex to encode.
+ * @param count The number of vertices.
+ * @param stride The size of each vertex in bytes, at most 4096.
+ * @param output Buffer the encoded stream is appended to.
+ * @return true on success, false if the stride is not supported.
+ */
+bool GeometryCodec::EncodeVertices(const void *vertices, size_t count,
+                                   size_t stride,
+                                   std::vector<uint8_t> *output) {
+    if (stride == 0 || stride > MAX_VERTEX_STRIDE) {
+        return false;
+    }
+
+    WriteLittleEndian(output, count, 8);
+    WriteLittleEndian(output, stride, 4);
+
+    const uint8_t *bytes = static_cast<const uint8_t *>(vertices);
+    std::vector<uint8_t> previous(stride, 0);
+    uint8_t deltas[VERTEX_BLOCK_SIZE];
+
+    for (size_t start = 0; start < count; start += VERTEX_BLOCK_SIZE) {
+        const size_t blockCount = std::min(VERTEX_BLOCK_SIZE, count - start);
+
+        for (size_t plane = 0; plane < stride; ++plane) {
+            const uint8_t *column = bytes + start * stride + plane;
+            uint8_t last = previous[plane];
+            uint8_t combined = 0;
+
+            for (size_t i = 0; i < blockCount; ++i) {
+                const uint8_t value = column[i * stride];
+                deltas[i] = ZigzagEncode8(static_cast<uint8_t>(value - last));
+                combined |= deltas[i];
+                last = value;
+            }
+
+            previous[plane] = last;
+
+            const unsigned int width = std::bit_width(combined);
+            output->push_back(static_cast<uint8_t>(width));
+
+            if (width == 8) {
+                output->insert(output->end(), deltas, deltas + blockCount);
+            } else if (width > 0) {
+                BitWriter writer(output);
+                for (size_t i = 0; i < blockCount; ++i) {
+                    writer.Write(deltas[i], width);
+                }
+                writer.Flush();
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Reads the number and size of the vertices held by an encoded vertex
+ * stream.
+ *
+ * @return true on success, false if the stream is too short.
+ */
+bool GeometryCodec::GetVertexCount(const uint8_t *data, size_t size,
+                                   size_t *count, size_t *stride) {
+    if (!data || size < VERTEX_HEADER_SIZE) {
+        return false;
+    }
+
+    *count = static_cast<size_t>(ReadLittleEndian(data, 8));
+    *stride = static_cast<size_t>(ReadLittleEndian(data + 8, 4));
+    return true;
+}
+
+/**
+ * Decompresses a vertex stream.
+ *
+ * Each block's planes are unpacked into rows of zigzag coded deltas, which
+ * transposes them back to vertex order, and each row is then added to the
+ * previous vertex 16 bytes at a time.
+ *
+ * @param data The encoded stream.
+ * @param size The size of the encoded stream in bytes.
+ * @param vertices Receives the vertices.
+ * @param count The number of vertices, which must match the stream.
+ * @param stride The size of each vertex, which must match the stream.
+ * @return true on success, false if the stream is corrupt, truncated or
+ *         does not match count and stride.
+ */
+bool GeometryCodec::DecodeVertices(const uint8_t *data, size_t size,
+                                   void *vertices, size_t count,
+                                   size_t stride) {
+    size_t streamCount;
+    size_t streamStride;
+
+    if (!GetVertexCount(data, size, &streamCount, &streamStride) ||
+        streamCount != count || streamStride != stride ||
+        stride == 0 || stride > MAX_VERTEX_STRIDE) {
+        return false;
+    }
+
+    const size_t pitch = (stride + 15) & ~static_cast<size_t>(15);
+    std::vector<uint8_t> rows(VERTEX_BLOCK_SIZE * pitch, 0);
+    std::vector<uint8_t> previous(pitch, 0);
+    uint8_t packed[VERTEX_BLOCK_SIZE + UNPACK_PADDING];
+    uint8_t *output = static_cast<uint8_t *>(vertices);
+    size_t position = VERTEX_HEADER_SIZE;
+
+    for (size_t start = 0; start < count; start += VERTEX_BLOCK_SIZE) {
+        const size_t blockCount = std::min(VERTEX_BLOCK_SIZE, count - start);
+
+        for (size_t plane = 0; plane < stride; ++plane) {
+            if (position >= size || data[position] > 8) {
+                return false;
+            }
+
+            const unsigned int width = data[position++];
+            const size_t bytes = PackedSize(blockCount, width);
+
+            if (bytes > size - position) {
+                return false;
+            }
+
+            uint8_t *column = rows.data() + plane;
+
+            if (width == 0) {
+                for (size_t i = 0; i < blockCount; ++i) {
+                    column[i * pitch] = 0;
+                }
+            } else if (width == 8) {
+                for (size_t i = 0; i < blockCount; ++i) {
+                    column[i * pitch] = data[position + i];
+                }
+            } else {
+                const uint32_t mask = (1u << width) - 1;
+                std::memcpy(packed, data + position, bytes);
+                std::memset(packed + bytes, 0, UNPACK_PADDING);
+
+                for (size_t i = 0; i < blockCount; ++i) {
+                    column[i * pitch] = static_cast<uint8_t>(
+                        Unpack(packed, i, width, mask));
+                }
+            }
+
+            position += bytes;
+        }
+
+        for (size_t i = 0; i < blockCount; ++i) {
+            RestoreRow(rows.data() + i * pitch, previous.data(), pitch);
+            std::memcpy(output + (start + i) * stride, previous.data(),
+                        stride);
+        }
+    }
+
+    return true;
+}
+
+}   // namespace Meshborn
@@ -0,0 +1,68 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef GEOMETRYCODEC_H_
+#define GEOMETRYCODEC_H_
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Meshborn {
+
+/**
+ * Lossless, dependency free compression for index and vertex streams.
+ *
+ * Indices are delta coded against the previous index, zigzag mapped so that
+ * small negative steps stay small, and bit-packed in blocks of 128 at the
+ * width of the largest value in the block.
+ *
+ * Vertices are treated as rows of raw bytes. Within blocks of 256 rows each
+ * byte column (plane) is delta coded against the row above, zigzag mapped
+ * and bit-packed at its own width, so slowly varying attributes such as the
+ * high bytes of positions cost very few bits. This works on any vertex
+ * layout, including the output of VertexEncoder.
+ *
+ * Encoded streams start with a small little-endian header giving the
+ * element count (and stride for vertices). Decoding checks every read
+ * against the input size and returns false on corrupt or truncated data.
+ * Where SSE2 is available the decoders undo the zigzag mapping and the
+ * deltas with vector prefix sums.
+ */
+class GeometryCodec {
+ public:
+    static void EncodeIndices(const uint32_t *indices, size_t count,
+                              std::vector<uint8_t> *output);
+
+    static bool GetIndexCount(const uint8_t *data, size_t size,
+                              size_t *count);
+
+    static bool DecodeIndices(const uint8_t *data, size_t size,
+                              uint32_t *indices, size_t count);
+
+    static bool EncodeVertices(const void *vertices, size_t count,
+                               size_t stride, std::vector<uint8_t> *output);
+
+    static bool GetVertexCount(const uint8_t *data, size_t size,
+                               size_t *count, size_t *stride);
+
+    static bool DecodeVertices(const uint8_t *data, size_t size,
+                               void *vertices, size_t count, size_t stride);
+};
+
+}   // namespace Meshborn
+
+#endif  // GEOMETRYCODEC_H_
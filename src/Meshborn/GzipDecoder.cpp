@@ -0,0 +1,763 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "GzipDecoder.h"
+
+namespace Meshborn {
+
+namespace {
+
+// DEFLATE back-references reach at most 32 KiB into the output.
+const size_t WINDOW_SIZE = 32768;
+
+// Decoded output is handed to the callback in chunks of about this size.
+const size_t CHUNK_SIZE = 1 << 20;
+
+const size_t MAX_MATCH = 258;
+const unsigned int MAX_CODE_BITS = 15;
+
+// Codes up to this length are decoded with a single table lookup.
+const unsigned int FAST_BITS = 10;
+const uint32_t FAST_MASK = (1u << FAST_BITS) - 1;
+
+const size_t MAX_LITERAL_CODES = 288;
+const size_t MAX_DISTANCE_CODES = 30;
+
+const uint8_t GZIP_MAGIC[2] = { 0x1F, 0x8B };
+const uint8_t GZIP_METHOD_DEFLATE = 8;
+const size_t GZIP_HEADER_SIZE = 10;
+const size_t GZIP_TRAILER_SIZE = 8;
+
+// Gzip header flags.
+const uint8_t FLAG_HEADER_CRC = 0x02;
+const uint8_t FLAG_EXTRA = 0x04;
+const uint8_t FLAG_NAME = 0x08;
+const uint8_t FLAG_COMMENT = 0x10;
+const uint8_t FLAG_RESERVED = 0xE0;
+
+const uint16_t LENGTH_BASE[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59,
+    67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+const uint8_t LENGTH_EXTRA[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4,
+    5, 5, 5, 5, 0
+};
+
+const uint16_t DISTANCE_BASE[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385,
+    513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+
+const uint8_t DISTANCE_EXTRA[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10,
+    11, 11, 12, 12, 13, 13
+};
+
+const uint8_t CODE_LENGTH_ORDER[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+uint32_t ReadLittleEndian32(const uint8_t *data) {
+    return static_cast<uint32_t>(data[0]) |
+           static_cast<uint32_t>(data[1]) << 8 |
+           static_cast<uint32_t>(data[2]) << 16 |
+           static_cast<uint32_t>(data[3]) << 24;
+}
+
+/**
+ * Lookup tables for a slicing-by-8 CRC-32, as used by gzip.
+ */
+struct Crc32Tables {
+    Crc32Tables() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 1u) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+            }
+            table[0][i] = crc;
+        }
+
+        for (uint32_t i = 0; i < 256; ++i) {
+            for (int slice = 1; slice < 8; ++slice) {
+                uint32_t previous = table[slice - 1][i];
+                table[slice][i] = (previous >> 8) ^ table[0][previous & 0xFF];
+            }
+        }
+    }
+
+    uint32_t table[8][256];
+};
+
+uint32_t UpdateCrc32(uint32_t crc, const uint8_t *data, size_t size) {
+    static const Crc32Tables tables;
+    const auto& t = tables.table;
+
+    crc = ~crc;
+
+    for (; size >= 8; size -= 8, data += 8) {
+        const uint32_t low = crc ^ ReadLittleEndian32(data);
+        const uint32_t high = ReadLittleEndian32(data + 4);
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^
+              t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+              t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^
+              t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+    }
+
+    for (; size > 0; --size, ++data) {
+        crc = t[0][(crc ^ *data) & 0xFF] ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
+
+/**
+ * Reads DEFLATE's least significant bit first stream through a 64-bit
+ * buffer.
+ */
+class BitReader {
+ public:
+    BitReader(const uint8_t *data, size_t size)
+        : next_(data), end_(data + size), bits_(0), count_(0) {}
+
+    bool Need(unsigned int count) {
+        if (count_ < count) {
+            while (count_ <= 56 && next_ < end_) {
+                bits_ |= static_cast<uint64_t>(*next_++) << count_;
+                count_ += 8;
+            }
+        }
+        return count_ >= count;
+    }
+
+    uint64_t Peek() const { return bits_; }
+
+    unsigned int Available() const { return count_; }
+
+    void Skip(unsigned int count) {
+        bits_ >>= count;
+        count_ -= count;
+    }
+
+    bool Read(unsigned int count, uint32_t *value) {
+        if (!Need(count)) {
+            return false;
+        }
+
+        *value = static_cast<uint32_t>(bits_ & ((1ull << count) - 1));
+        Skip(count);
+        return true;
+    }
+
+    // Drops the rest of the current byte and returns any whole buffered
+    // bytes to the input, so it can be read directly.
+    void AlignToByte() {
+        Skip(count_ & 7);
+        next_ -= count_ / 8;
+        bits_ = 0;
+        count_ = 0;
+    }
+
+    // Takes count bytes directly from the input; only valid once aligned.
+    const uint8_t *Take(size_t count) {
+        if (static_cast<size_t>(end_ - next_) < count) {
+            return nullptr;
+        }
+
+        const uint8_t *taken = next_;
+        next_ += count;
+        return taken;
+    }
+
+ private:
+    const uint8_t *next_;
+    const uint8_t *end_;
+    uint64_t bits_;
+    unsigned int count_;
+};
+
+/**
+ * A canonical Huffman code. Short codes are resolved through the fast
+ * table, which holds symbol | length << 9 indexed by the next FAST_BITS
+ * input bits; longer codes fall back to a bit at a time walk of the code
+ * lengths.
+ */
+struct HuffmanCode {
+    uint16_t fast[1u << FAST_BITS];
+    uint16_t counts[MAX_CODE_BITS + 1];
+    uint16_t symbols[MAX_LITERAL_CODES];
+};
+
+bool BuildHuffmanCode(const uint8_t *lengths, size_t count,
+                      HuffmanCode *code) {
+    std::fill(std::begin(code->counts), std::end(code->counts), 0);
+    std::fill(std::begin(code->fast), std::end(code->fast), 0);
+
+    for (size_t symbol = 0; symbol < count; ++symbol) {
+        code->counts[lengths[symbol]]++;
+    }
+    code->counts[0] = 0;
+
+    // Reject over-subscribed codes. Incomplete codes are allowed, as a
+    // distance code with a single symbol is legitimately incomplete.
+    int left = 1;
+    for (unsigned int length = 1; length <= MAX_CODE_BITS; ++length) {
+        left = (left << 1) - code->counts[length];
+        if (left < 0) {
+            return false;
+        }
+    }
+
+    uint16_t offsets[MAX_CODE_BITS + 2];
+    uint32_t nextCode[MAX_CODE_BITS + 1];
+    uint32_t value = 0;
+
+    offsets[1] = 0;
+    for (unsigned int length = 1; length <= MAX_CODE_BITS; ++length) {
+        offsets[length + 1] = offsets[length] + code->counts[length];
+        value = (value + code->counts[length - 1]) << 1;
+        nextCode[length] = value;
+    }
+
+    for (size_t symbol = 0; symbol < count; ++symbol) {
+        const unsigned int length = lengths[symbol];
+        if (length == 0) {
+            continue;
+        }
+
+        code->symbols[offsets[length]++] = static_cast<uint16_t>(symbol);
+
+        const uint32_t canonical = nextCode[length]++;
+        if (length > FAST_BITS) {
+            continue;
+        }
+
+        // Codes are sent most significant bit first, so reverse them to
+        // index the table with the bit buffer.
+        uint32_t reversed = 0;
+        for (unsigned int bit = 0; bit < length; ++bit) {
+            reversed |= ((canonical >> bit) & 1u) << (length - 1 - bit);
+        }
+
+        for (uint32_t i = reversed; i <= FAST_MASK; i += 1u << length) {
+            code->fast[i] = static_cast<uint16_t>(symbol | (length << 9));
+        }
+    }
+
+    return true;
+}
+
+int DecodeSymbol(BitReader *input, const HuffmanCode& code) {
+    input->Need(MAX_CODE_BITS);
+
+    const uint16_t entry = code.fast[input->Peek() & FAST_MASK];
+    if (entry != 0) {
+        const unsigned int length = entry >> 9;
+        if (length > input->Available()) {
+            return -1;
+        }
+
+        input->Skip(length);
+        return entry & 0x1FF;
+    }
+
+    int value = 0;
+    int first = 0;
+    int index = 0;
+
+    for (unsigned int length = 1; length <= MAX_CODE_BITS; ++length) {
+        uint32_t bit;
+        if (!input->Read(1, &bit)) {
+            return -1;
+        }
+
+        value |= static_cast<int>(bit);
+        const int count = code.counts[length];
+
+        if (value - count < first) {
+            return code.symbols[index + (value - first)];
+        }
+
+        index += count;
+        first = (first + count) << 1;
+        value <<= 1;
+    }
+
+    return -1;
+}
+
+/**
+ * Decodes raw DEFLATE streams into a sliding output buffer.
+ */
+class Inflater {
+ public:
+    explicit Inflater(const GzipDecoder::ChunkCallback& callback)
+        : callback_(callback),
+          buffer_(WINDOW_SIZE + CHUNK_SIZE + MAX_MATCH),
+          size_(0), emitted_(0), crc_(0), length_(0) {}
+
+    void BeginMember() {
+        size_ = 0;
+        emitted_ = 0;
+        crc_ = 0;
+        length_ = 0;
+    }
+
+    bool Inflate(BitReader *input);
+
+    bool Flush();
+
+    uint32_t GetCrc() const { return crc_; }
+
+    uint32_t GetLength() const { return length_; }
+
+    const std::string& GetError() const { return error_; }
+
+ private:
+    bool Fail(const char *error) {
+        error_ = error;
+        return false;
+    }
+
+    bool MakeRoom();
+
+    bool InflateStored(BitReader *input);
+
+    bool InflateDynamic(BitReader *input);
+
+    bool InflateCodes(BitReader *input, const HuffmanCode& literals,
+                      const HuffmanCode& distances);
+
+    const GzipDecoder::ChunkCallback& callback_;
+    std::vector<uint8_t> buffer_;
+    size_t size_;
+    size_t emitted_;
+    uint32_t crc_;
+    uint32_t length_;
+    std::string error_;
+};
+
+/**
+ * Hands any output not yet emitted to the callback.
+ */
+bool Inflater::Flush() {
+    if (size_ > emitted_) {
+        const size_t count = size_ - emitted_;
+        crc_ = UpdateCrc32(crc_, buffer_.data() + emitted_, count);
+        length_ += static_cast<uint32_t>(count);
+
+        if (!callback_(reinterpret_cast<const char *>(buffer_.data()) +
+                       emitted_, count)) {
+            return Fail("Decoding stopped by the consumer");
+        }
+
+        emitted_ = size_;
+    }
+
+    return true;
+}
+
+/**
+ * Emits a full chunk and slides the window back to the start of the
+ * buffer, keeping the history back-references may still use.
+ */
+bool Inflater::MakeRoom() {
+    if (!Flush()) {
+        return false;
+    }
+
+    if (size_ > WINDOW_SIZE) {
+        std::memmove(buffer_.data(), buffer_.data() + size_ - WINDOW_SIZE,
+                     WINDOW_SIZE);
+        size_ = WINDOW_SIZE;
+        emitted_ = WINDOW_SIZE;
+    }
+
+    return true;
+}
+
+bool Inflater::Inflate(BitReader *input) {
+    uint32_t last = 0;
+
+    while (!last) {
+        uint32_t type;
+
+        if (!input->Read(1, &last) || !input->Read(2, &type)) {
+            return Fail("Compressed data is truncated");
+        }
+
+        bool status;
+
+        if (type == 0) {
+            status = InflateStored(input);
+        } else if (type == 1) {
+            static const struct FixedCodes {
+                FixedCodes() {
+                    uint8_t lengths[MAX_LITERAL_CODES];
+                    std::fill(lengths, lengths + 144, 8);
+                    std::fill(lengths + 144, lengths + 256, 9);
+                    std::fill(lengths + 256, lengths + 280, 7);
+                    std::fill(lengths + 280, lengths + 288, 8);
+                    BuildHuffmanCode(lengths, MAX_LITERAL_CODES, &literals);
+
+                    std::fill(lengths, lengths + MAX_DISTANCE_CODES, 5);
+                    BuildHuffmanCode(lengths, MAX_DISTANCE_CODES, &distances);
+                }
+
+                HuffmanCode literals;
+                HuffmanCode distances;
+            } fixed;
+
+            status = InflateCodes(input, fixed.literals, fixed.distances);
+        } else if (type == 2) {
+            status = InflateDynamic(input);
+        } else {
+            return Fail("Invalid block type");
+        }
+
+        if (!status) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Inflater::InflateStored(BitReader *input) {
+    input->AlignToByte();
+
+    const uint8_t *header = input->Take(4);
+    if (!header) {
+        return Fail("Compressed data is truncated");
+    }
+
+    const uint32_t length = header[0] | header[1] << 8;
+    const uint32_t complement = header[2] | header[3] << 8;
+
+    if (length != (~complement & 0xFFFFu)) {
+        return Fail("Stored block length is invalid");
+    }
+
+    const uint8_t *data = input->Take(length);
+    if (!data) {
+        return Fail("Compressed data is truncated");
+    }
+
+    size_t remaining = length;
+
+    while (remaining > 0) {
+        if (size_ >= WINDOW_SIZE + CHUNK_SIZE && !MakeRoom()) {
+            return false;
+        }
+
+        const size_t count = std::min(remaining, buffer_.size() - size_);
+        std::memcpy(buffer_.data() + size_, data, count);
+        size_ += count;
+        data += count;
+        remaining -= count;
+    }
+
+    return true;
+}
+
+bool Inflater::InflateDynamic(BitReader *input) {
+    uint32_t literalCount;
+    uint32_t distanceCount;
+    uint32_t codeLengthCount;
+
+    if (!input->Read(5, &literalCount) || !input->Read(5, &distanceCount) ||
+        !input->Read(4, &codeLengthCount)) {
+        return Fail("Compressed data is truncated");
+    }
+
+    literalCount += 257;
+    distanceCount += 1;
+    codeLengthCount += 4;
+
+    if (literalCount > 286 || distanceCount > MAX_DISTANCE_CODES) {
+        return Fail("Dynamic block has too many codes");
+    }
+
+    uint8_t lengths[MAX_LITERAL_CODES + MAX_DISTANCE_CODES] = {};
+
+    for (uint32_t i = 0; i < codeLengthCount; ++i) {
+        uint32_t length;
+        if (!input->Read(3, &length)) {
+            return Fail("Compressed data is truncated");
+        }
+        lengths[CODE_LENGTH_ORDER[i]] = static_cast<uint8_t>(length);
+    }
+
+    HuffmanCode lengthCode;
+    if (!BuildHuffmanCode(lengths, 19, &lengthCode)) {
+        return Fail("Code length code is invalid");
+    }
+
+    const uint32_t total = literalCount + distanceCount;
+    uint32_t index = 0;
+
+    while (index < total) {
+        const int symbol = DecodeSymbol(input, lengthCode);
+
+        if (symbol < 0) {
+            return Fail("Code length is invalid");
+        }
+
+        if (symbol < 16) {
+            lengths[index++] = static_cast<uint8_t>(symbol);
+            continue;
+        }
+
+        uint8_t repeated = 0;
+        uint32_t repeat;
+
+        if (symbol == 16) {
+            if (index == 0) {
+                return Fail("Code length repeat has no previous length");
+            }
+            repeated = lengths[index - 1];
+            if (!input->Read(2, &repeat)) {
+                return Fail("Compressed data is truncated");
+            }
+            repeat += 3;
+        } else if (symbol == 17) {
+            if (!input->Read(3, &repeat)) {
+                return Fail("Compressed data is truncated");
+            }
+            repeat += 3;
+        } else {
+            if (!input->Read(7, &repeat)) {
+                return Fail("Compressed data is truncated");
+            }
+            repeat += 11;
+        }
+
+        if (index + repeat > total) {
+            return Fail("Code length repeat is too long");
+        }
+
+        std::fill(lengths + index, lengths + index + repeat, repeated);
+        index += repeat;
+    }
+
+    if (lengths[256] == 0) {
+        return Fail("Dynamic block has no end of block code");
+    }
+
+    HuffmanCode literals;
+    HuffmanCode distances;
+
+    if (!BuildHuffmanCode(lengths, literalCount, &literals) ||
+        !BuildHuffmanCode(lengths + literalCount, distanceCount,
+                          &distances)) {
+        return Fail("Dynamic block code is invalid");
+    }
+
+    return InflateCodes(input, literals, distances);
+}
+
+bool Inflater::InflateCodes(BitReader *input, const HuffmanCode& literals,
+                            const HuffmanCode& distances) {
+    while (true) {
+        if (size_ >= WINDOW_SIZE + CHUNK_SIZE && !MakeRoom()) {
+            return false;
+        }
+
+        int symbol = DecodeSymbol(input, literals);
+
+        if (symbol < 0) {
+            return Fail("Literal/length code is invalid");
+        }
+
+        if (symbol < 256) {
+            buffer_[size_++] = static_cast<uint8_t>(symbol);
+            continue;
+        }
+
+        if (symbol == 256) {
+            return true;
+        }
+
+        symbol -= 257;
+        if (symbol >= 29) {
+            return Fail("Length code is invalid");
+        }
+
+        uint32_t extra;
+        if (!input->Read(LENGTH_EXTRA[symbol], &extra)) {
+            return Fail("Compressed data is truncated");
+        }
+        const size_t length = LENGTH_BASE[symbol] + extra;
+
+        symbol = DecodeSymbol(input, distances);
+        if (symbol < 0 || symbol >= static_cast<int>(MAX_DISTANCE_CODES)) {
+            return Fail("Distance code is invalid");
+        }
+
+        if (!input->Read(DISTANCE_EXTRA[symbol], &extra)) {
+            return Fail("Compressed data is truncated");
+        }
+        const size_t distance = DISTANCE_BASE[symbol] + extra;
+
+        if (distance > size_) {
+            return Fail("Distance is too far back");
+        }
+
+        uint8_t *output = buffer_.data() + size_;
+        const uint8_t *source = output - distance;
+
+        if (distance >= length) {
+            std::memcpy(output, source, length);
+        } else {
+            // Overlapping copies repeat the most recent bytes.
+            for (size_t i = 0; i < length; ++i) {
+                output[i] = source[i];
+            }
+        }
+
+        size_ += length;
+    }
+}
+
+}   // namespace
+
+/**
+ * Checks whether a buffer starts with the gzip magic number.
+ */
+bool GzipDecoder::IsGzip(const uint8_t *data, size_t size) {
+    return size >= 2 && data[0] == GZIP_MAGIC[0] && data[1] == GZIP_MAGIC[1];
+}
+
+/**
+ * Decodes a complete gzip file held in memory.
+ *
+ * @param data The gzip file contents.
+ * @param size The size of the file in bytes.
+ * @param callback Receives the decoded data, chunk by chunk, in order.
+ * @return true on success, false if the file is not a valid gzip file, is
+ *         corrupt, or the callback stopped decoding. GetError() describes
+ *         the failure.
+ */
+bool GzipDecoder::Decode(const uint8_t *data, size_t size,
+                         const ChunkCallback& callback) {
+    error_.clear();
+
+    Inflater inflater(callback);
+    size_t position = 0;
+    size_t members = 0;
+
+    auto fail = [this](const char *error) {
+        error_ = error;
+        return false;
+    };
+
+    while (position < size) {
+        // Anything after the last member that is not another member, such
+        // as padding from a tape or block device, is ignored.
+        if (!IsGzip(data + position, size - position)) {
+            if (members > 0) {
+                break;
+            }
+            return fail("Not a gzip file");
+        }
+
+        if (size - position < GZIP_HEADER_SIZE) {
+            return fail("Gzip header is truncated");
+        }
+
+        const uint8_t *header = data + position;
+        const uint8_t flags = header[3];
+
+        if (header[2] != GZIP_METHOD_DEFLATE) {
+            return fail("Unsupported gzip compression method");
+        }
+
+        if (flags & FLAG_RESERVED) {
+            return fail("Gzip header has reserved flags set");
+        }
+
+        position += GZIP_HEADER_SIZE;
+
+        if (flags & FLAG_EXTRA) {
+            if (size - position < 2) {
+                return fail("Gzip header is truncated");
+            }
+
+            const size_t extra = data[position] | data[position + 1] << 8;
+            if (size - position - 2 < extra) {
+                return fail("Gzip header is truncated");
+            }
+            position += 2 + extra;
+        }
+
+        for (uint8_t flag : { FLAG_NAME, FLAG_COMMENT }) {
+            if (flags & flag) {
+                const uint8_t *end = static_cast<const uint8_t *>(
+                    std::memchr(data + position, 0, size - position));
+                if (!end) {
+                    return fail("Gzip header is truncated");
+                }
+                position = end - data + 1;
+            }
+        }
+
+        if (flags & FLAG_HEADER_CRC) {
+            if (size - position < 2) {
+                return fail("Gzip header is truncated");
+            }
+            position += 2;
+        }
+
+        BitReader input(data + position, size - position);
+        inflater.BeginMember();
+
+        if (!inflater.Inflate(&input) || !inflater.Flush()) {
+            error_ = inflater.GetError();
+            return false;
+        }
+
+        input.AlignToByte();
+        const uint8_t *trailer = input.Take(GZIP_TRAILER_SIZE);
+
+        if (!trailer) {
+            return fail("Gzip trailer is truncated");
+        }
+
+        if (ReadLittleEndian32(trailer) != inflater.GetCrc()) {
+            return fail("Gzip CRC-32 does not match the decoded data");
+        }
+
+        if (ReadLittleEndian32(trailer + 4) != inflater.GetLength()) {
+            return fail("Gzip length does not match the decoded data");
+        }
+
+        position = trailer + GZIP_TRAILER_SIZE - data;
+        members++;
+    }
+
+    if (members == 0) {
+        return fail("Not a gzip file");
+    }
+
+    return true;
+}
+
+}   // namespace Meshborn
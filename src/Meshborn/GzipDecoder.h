@@ -0,0 +1,56 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef GZIPDECODER_H_
+#define GZIPDECODER_H_
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace Meshborn {
+
+/**
+ * Dependency free decoder for gzip files (RFC 1952) and the DEFLATE data
+ * they hold (RFC 1951).
+ *
+ * Output is produced in chunks of about a megabyte, each handed to a
+ * callback as soon as it is complete, so a consumer can work on the start
+ * of a file while the rest is still being inflated. Only the last 32 KiB
+ * needed for back-references is retained between chunks. Concatenated gzip
+ * members are decoded one after the other, and each member's CRC-32 and
+ * length are verified.
+ */
+class GzipDecoder {
+ public:
+    // Receives each decoded chunk. Returning false stops decoding.
+    using ChunkCallback = std::function<bool(const char *data, size_t size)>;
+
+    static bool IsGzip(const uint8_t *data, size_t size);
+
+    bool Decode(const uint8_t *data, size_t size,
+                const ChunkCallback& callback);
+
+    const std::string& GetError() const { return error_; }
+
+ private:
+    std::string error_;
+};
+
+}   // namespace Meshborn
+
+#endif  // GZIPDECODER_H_
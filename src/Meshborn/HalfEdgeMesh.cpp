@@ -0,0 +1,298 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <format>
+#include <mutex>    // NOLINT
+#include <utility>
+#include <vector>
+#include "HalfEdgeMesh.h"
+#include "LoggerManager.h"
+#include "Parallel.h"
+#include "RadixSort.h"
+
+namespace Meshborn {
+
+namespace {
+
+// Number of faces or half-edges handed to a worker thread in one chunk.
+const size_t HALF_EDGE_GRAIN_SIZE = 16384;
+
+}   // namespace
+
+HalfEdgeMesh::HalfEdgeMesh() : faceStarts_(1, 0), boundaryCount_(0) {
+}
+
+HalfEdgeMesh::HalfEdgeMesh(const HalfEdgeBuildOptions& options)
+    : options_(options), faceStarts_(1, 0), boundaryCount_(0) {
+}
+
+/**
+ * Builds the half-edge structure for the faces of a mesh, replacing any
+ * previous contents.
+ *
+ * Each half-edge gets a key made of the smaller vertex of its edge above
+ * its own index, and the keys are radix sorted so that half-edges around
+ * each vertex become neighbours. Each of those small runs is then grouped
+ * by the other vertex: a pair of half-edges running in opposite directions
+ * are twins, a lone half-edge is a boundary and anything else is reported
+ * as a non-manifold edge. Runs are paired in parallel.
+ *
+ * @param mesh The mesh whose faces to use. Vertices are not required.
+ * @return true on success, false if a face refers to an invalid position
+ *         or the mesh is too large.
+ */
+bool HalfEdgeMesh::Build(const Mesh& mesh) {
+    const uint32_t threadCount = options_.threadCount;
+    const size_t faceCount = mesh.faces.size();
+
+    faceStarts_.assign(faceCount + 1, 0);
+    positions_.clear();
+    outgoing_.clear();
+    nonManifoldEdges_.clear();
+    boundaryCount_ = 0;
+
+    size_t halfEdgeCount = 0;
+
+    for (size_t f = 0; f < faceCount; ++f) {
+        faceStarts_[f] = static_cast<uint32_t>(halfEdgeCount);
+        halfEdgeCount += mesh.faces[f].elements.size();
+
+        if (halfEdgeCount >= NO_HALF_EDGE) {
+            LOG(Logger::LogLevel::Critical, std::format(
+                "Mesh '{}' is too large for a half-edge structure",
+                mesh.name));
+            faceStarts_.assign(1, 0);
+            return false;
+        }
+    }
+
+    faceStarts_[faceCount] = static_cast<uint32_t>(halfEdgeCount);
+    origins_.resize(halfEdgeCount);
+    faces_.resize(halfEdgeCount);
+    twins_.assign(halfEdgeCount, NO_HALF_EDGE);
+
+    // Gather the 0-based position index of each half-edge's origin.
+    std::atomic<bool> valid = true;
+    std::atomic<uint32_t> maxPosition = 0;
+
+    ParallelFor(faceCount, HALF_EDGE_GRAIN_SIZE,
+                [&](size_t begin, size_t end) {
+        uint32_t chunkMax = 0;
+
+        for (size_t f = begin; f < end; ++f) {
+            uint32_t halfEdge = faceStarts_[f];
+
+            for (const auto& element : mesh.faces[f].elements) {
+                if (element.vertex < 1) {
+                    valid = false;
+                    return;
+                }
+
+                origins_[halfEdge] = static_cast<uint32_t>(element.vertex - 1);
+                faces_[halfEdge] = static_cast<uint32_t>(f);
+                chunkMax = std::max(chunkMax, origins_[halfEdge]);
+                ++halfEdge;
+            }
+        }
+
+        uint32_t current = maxPosition;
+        while (current < chunkMax &&
+               !maxPosition.compare_exchange_weak(current, chunkMax)) {
+        }
+    }, threadCount);
+
+    if (!valid) {
+        LOG(Logger::LogLevel::Critical, std::format(
+            "Mesh '{}' has a face with an invalid position index",
+            mesh.name));
+        faceStarts_.assign(1, 0);
+        origins_.clear();
+        faces_.clear();
+        twins_.clear();
+        return false;
+    }
+
+    if (halfEdgeCount == 0) {
+        return true;
+    }
+
+    // Number the positions the mesh uses, in position order.
+    std::vector<uint32_t> vertexIds(static_cast<size_t>(maxPosition) + 1, 0);
+
+    ParallelFor(halfEdgeCount, HALF_EDGE_GRAIN_SIZE,
+                [&](size_t begin, size_t end) {
+        for (size_t h = begin; h < end; ++h) {
+            std::atomic_ref<uint32_t>(vertexIds[origins_[h]]).store(
+                1, std::memory_order_relaxed);
+        }
+    }, threadCount);
+
+    for (size_t i = 0; i < vertexIds.size(); ++i) {
+        if (vertexIds[i]) {
+            vertexIds[i] = static_cast<uint32_t>(positions_.size());
+            positions_.push_back(static_cast<int>(i + 1));
+        }
+    }
+
+    ParallelFor(halfEdgeCount, HALF_EDGE_GRAIN_SIZE,
+                [&](size_t begin, size_t end) {
+        for (size_t h = begin; h < end; ++h) {
+            origins_[h] = vertexIds[origins_[h]];
+        }
+    }, threadCount);
+
+    std::vector<uint32_t>().swap(vertexIds);
+
+    // Sort the half-edges by the smaller vertex of their edge. Both fields
+    // fit in 64 bits as there are no more vertices than half-edges.
+    const unsigned int halfEdgeBits = std::max<unsigned int>(
+        1, std::bit_width(halfEdgeCount - 1));
+    const unsigned int vertexBits = std::max<unsigned int>(
+        1, std::bit_width(positions_.size() - 1));
+    std::vector<uint64_t> keys(halfEdgeCount);
+
+    ParallelFor(halfEdgeCount, HALF_EDGE_GRAIN_SIZE,
+                [&](size_t begin, size_t end) {
+        for (size_t h = begin; h < end; ++h) {
+            const uint32_t halfEdge = static_cast<uint32_t>(h);
+            const uint32_t low = std::min(GetOrigin(halfEdge),
+                                          GetTarget(halfEdge));
+            keys[h] = (static_cast<uint64_t>(low) << halfEdgeBits) | h;
+        }
+    }, threadCount);
+
+    RadixSort(&keys, halfEdgeBits, halfEdgeBits + vertexBits, threadCount);
+
+    const uint64_t indexMask = (uint64_t(1) << halfEdgeBits) - 1;
+    std::mutex nonManifoldMutex;
+
+    ParallelFor(halfEdgeCount, HALF_EDGE_GRAIN_SIZE,
+                [&](size_t begin, size_t end) {
+        // Each chunk handles the runs that start inside it.
+        const auto runStart = [&](size_t i) {
+            return i == 0 || i >= halfEdgeCount ||
+                   (keys[i] >> halfEdgeBits) != (keys[i - 1] >> halfEdgeBits);
+        };
+
+        while (begin < end && !runStart(begin)) {
+            ++begin;
+        }
+
+        while (!runStart(end)) {
+            ++end;
+        }
+
+        std::vector<std::pair<uint32_t, uint32_t>> edges;
+        std::vector<NonManifoldEdge> nonManifold;
+
+        for (size_t run = begin; run < end;) {
+            const uint32_t low = static_cast<uint32_t>(keys[run] >>
+                                                       halfEdgeBits);
+            size_t runEnd = run + 1;
+
+            while (runEnd < halfEdgeCount &&
+                   (keys[runEnd] >> halfEdgeBits) == low) {
+                ++runEnd;
+            }
+
+            edges.clear();
+
+            for (size_t i = run; i < runEnd; ++i) {
+                const uint32_t halfEdge = static_cast<uint32_t>(
+                    keys[i] & indexMask);
+                const uint32_t origin = GetOrigin(halfEdge);
+                edges.emplace_back(origin == low ? GetTarget(halfEdge) :
+                                                   origin, halfEdge);
+            }
+
+            std::sort(edges.begin(), edges.end());
+
+            for (size_t group = 0; group < edges.size();) {
+                size_t groupEnd = group + 1;
+
+                while (groupEnd < edges.size() &&
+                       edges[groupEnd].first == edges[group].first) {
+                    ++groupEnd;
+                }
+
+                const uint32_t first = edges[group].second;
+                const size_t count = groupEnd - group;
+
+                // Edges from a vertex to itself are left as boundaries.
+                if (edges[group].first != low && count > 1) {
+                    const uint32_t second = edges[group + 1].second;
+
+                    if (count == 2 &&
+                        GetOrigin(first) != GetOrigin(second)) {
+                        twins_[first] = second;
+                        twins_[second] = first;
+                    } else {
+                        NonManifoldEdge edge;
+                        edge.from = positions_[GetOrigin(first)];
+                        edge.to = positions_[GetTarget(first)];
+                        edge.faceCount = static_cast<uint32_t>(count);
+                        nonManifold.push_back(edge);
+                    }
+                }
+
+                group = groupEnd;
+            }
+
+            run = runEnd;
+        }
+
+        if (!nonManifold.empty()) {
+            std::lock_guard<std::mutex> lock(nonManifoldMutex);
+            nonManifoldEdges_.insert(nonManifoldEdges_.end(),
+                                     nonManifold.begin(), nonManifold.end());
+        }
+    }, threadCount);
+
+    std::sort(nonManifoldEdges_.begin(), nonManifoldEdges_.end(),
+              [](const NonManifoldEdge& a, const NonManifoldEdge& b) {
+        return a.from < b.from || (a.from == b.from && a.to < b.to);
+    });
+
+    // Prefer boundary half-edges as the outgoing half-edge of a vertex.
+    outgoing_.assign(positions_.size(), NO_HALF_EDGE);
+
+    for (uint32_t h = 0; h < halfEdgeCount; ++h) {
+        uint32_t& outgoing = outgoing_[origins_[h]];
+
+        if (IsBoundary(h)) {
+            ++boundaryCount_;
+
+            if (outgoing == NO_HALF_EDGE || !IsBoundary(outgoing)) {
+                outgoing = h;
+            }
+        } else if (outgoing == NO_HALF_EDGE) {
+            outgoing = h;
+        }
+    }
+
+    LOG(Logger::LogLevel::Debug, std::format(
+        "HALF EDGES => mesh '{}', {} half-edges, {} boundary, "
+        "{} non-manifold edges", mesh.name, halfEdgeCount, boundaryCount_,
+        nonManifoldEdges_.size()));
+
+    return true;
+}
+
+}   // namespace Meshborn
@@ -0,0 +1,162 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef HALFEDGEMESH_H_
+#define HALFEDGEMESH_H_
+#include <cstdint>
+#include <vector>
+#include "Mesh.h"
+
+namespace Meshborn {
+
+/**
+ * Value of a half-edge index that refers to no half-edge, e.g. the twin of
+ * a boundary half-edge.
+ */
+const uint32_t NO_HALF_EDGE = 0xFFFFFFFF;
+
+/**
+ * An edge used by more than two faces, or by two faces that run along it
+ * in the same direction. Such edges are left without twins.
+ */
+struct NonManifoldEdge {
+    NonManifoldEdge() : from(0), to(0), faceCount(0) {}
+
+    // Position indices of the edge's end points, as in the faces.
+    int from;
+    int to;
+
+    // Number of faces using the edge.
+    uint32_t faceCount;
+};
+
+/**
+ * Settings controlling how the half-edge structure is built.
+ */
+struct HalfEdgeBuildOptions {
+    HalfEdgeBuildOptions() : threadCount(0) {}
+
+    // Maximum worker threads, 0 selects the hardware default.
+    unsigned int threadCount;
+};
+
+/**
+ * Half-edge adjacency for the faces of a Mesh, for boundary detection,
+ * manifold checks and other topology queries.
+ *
+ * Each face corner starts a half-edge running to the next corner, so
+ * half-edges are numbered in face order and a face's half-edges are
+ * contiguous. Corners sharing a position index share a vertex, regardless
+ * of their normals or texture coordinates. Every query is O(1).
+ *
+ * Twins are paired by radix sorting the half-edges by their end points in
+ * parallel, rather than with a map.
+ */
+class HalfEdgeMesh {
+ public:
+    HalfEdgeMesh();
+
+    explicit HalfEdgeMesh(const HalfEdgeBuildOptions& options);
+
+    bool Build(const Mesh& mesh);
+
+    size_t GetHalfEdgeCount() const { return origins_.size(); }
+
+    size_t GetFaceCount() const { return faceStarts_.size() - 1; }
+
+    size_t GetVertexCount() const { return positions_.size(); }
+
+    // Half-edge queries.
+    uint32_t GetOrigin(uint32_t halfEdge) const { return origins_[halfEdge]; }
+
+    uint32_t GetTarget(uint32_t halfEdge) const {
+        return origins_[GetNext(halfEdge)];
+    }
+
+    uint32_t GetFace(uint32_t halfEdge) const { return faces_[halfEdge]; }
+
+    uint32_t GetNext(uint32_t halfEdge) const {
+        const uint32_t face = faces_[halfEdge];
+        return halfEdge + 1 == faceStarts_[face + 1] ? faceStarts_[face] :
+                                                       halfEdge + 1;
+    }
+
+    uint32_t GetPrevious(uint32_t halfEdge) const {
+        const uint32_t face = faces_[halfEdge];
+        return halfEdge == faceStarts_[face] ? faceStarts_[face + 1] - 1 :
+                                               halfEdge - 1;
+    }
+
+    uint32_t GetTwin(uint32_t halfEdge) const { return twins_[halfEdge]; }
+
+    bool IsBoundary(uint32_t halfEdge) const {
+        return twins_[halfEdge] == NO_HALF_EDGE;
+    }
+
+    // Face queries. A face's half-edges run from GetFaceHalfEdge(face) for
+    // GetFaceSize(face) half-edges.
+    uint32_t GetFaceHalfEdge(uint32_t face) const {
+        return faceStarts_[face];
+    }
+
+    uint32_t GetFaceSize(uint32_t face) const {
+        return faceStarts_[face + 1] - faceStarts_[face];
+    }
+
+    // Vertex queries. Vertices are numbered in order of position index.
+    int GetPositionIndex(uint32_t vertex) const { return positions_[vertex]; }
+
+    // Returns a half-edge leaving the vertex, a boundary one if there is
+    // one, so that walking twins from it visits the whole fan.
+    uint32_t GetOutgoingHalfEdge(uint32_t vertex) const {
+        return outgoing_[vertex];
+    }
+
+    size_t GetBoundaryHalfEdgeCount() const { return boundaryCount_; }
+
+    const std::vector<NonManifoldEdge>& GetNonManifoldEdges() const {
+        return nonManifoldEdges_;
+    }
+
+    bool IsManifold() const { return nonManifoldEdges_.empty(); }
+
+    bool IsClosed() const {
+        return boundaryCount_ == 0 && nonManifoldEdges_.empty();
+    }
+
+ private:
+    HalfEdgeBuildOptions options_;
+
+    // Index of the first half-edge of each face, plus the total.
+    std::vector<uint32_t> faceStarts_;
+
+    // Per half-edge: starting vertex, face and twin.
+    std::vector<uint32_t> origins_;
+    std::vector<uint32_t> faces_;
+    std::vector<uint32_t> twins_;
+
+    // Per vertex: position index and an outgoing half-edge.
+    std::vector<int> positions_;
+    std::vector<uint32_t> outgoing_;
+
+    size_t boundaryCount_;
+    std::vector<NonManifoldEdge> nonManifoldEdges_;
+};
+
+}   // namespace Meshborn
+
+#endif  // HALFEDGEMESH_H_
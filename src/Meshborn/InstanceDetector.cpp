@@ -0,0 +1,740 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+#include "InstanceDetector.h"
+#include "LoggerManager.h"
+#include "Parallel.h"
+
+namespace Meshborn {
+
+namespace {
+
+// Layout value of a face corner without texture coordinates.
+const uint32_t NO_TEXTURE = 0xFFFFFFFF;
+
+// Jacobi sweeps allowed when solving for the best rotation; a symmetric
+// 4x4 matrix normally converges in well under ten.
+const int MAX_JACOBI_SWEEPS = 32;
+
+struct MeshSignature {
+    MeshSignature() : hash(0), spread(0.0) {
+        centroid[0] = centroid[1] = centroid[2] = 0.0;
+    }
+
+    // Hash of the layout and of the vertex data that must be identical for
+    // two meshes to match.
+    uint64_t hash;
+
+    // Size and smoothing group of each face followed by, for each corner,
+    // the position and texture indices relabelled in order of first use and
+    // whether the normal came from the file. Meshes that share attributes
+    // between corners in the same way have equal layouts, so normals and
+    // tangents generated later are the same up to the transform.
+    std::vector<uint32_t> layout;
+
+    // Centroid of the corner positions and their root mean square distance
+    // from it, which a rigid transform preserves.
+    double centroid[3];
+    double spread;
+};
+
+/**
+ * The corners of a mesh in the order FinaliseVertices stores them, read
+ * from its vertices once finalised or, before that, from its face elements
+ * and the attribute lists they index.
+ */
+class CornerView {
+ public:
+    CornerView() : mesh_(nullptr), positions_(nullptr), normals_(nullptr),
+                   textureCoordinates_(nullptr) {}
+
+    void SetVertices(const Mesh *mesh) {
+        mesh_ = mesh;
+    }
+
+    /**
+     * Views the face elements of an unfinalised mesh. A mesh with a
+     * position index out of range is left empty, so it is never matched
+     * and finalisation still reports it.
+     */
+    void SetElements(const Mesh *mesh,
+                     const Point4DList *positions,
+                     const Point3DList *normals,
+                     const TextureCoordinatesList *textureCoordinates) {
+        mesh_ = mesh;
+        positions_ = positions;
+        normals_ = normals;
+        textureCoordinates_ = textureCoordinates;
+
+        size_t count = 0;
+
+        for (const auto& face : mesh->faces) {
+            count += face.elements.size();
+        }
+
+        elements_.reserve(count);
+
+        for (const auto& face : mesh->faces) {
+            for (const auto& element : face.elements) {
+                if (element.vertex < 1 ||
+                    element.vertex > static_cast<int>(positions->size())) {
+                    elements_.clear();
+                    return;
+                }
+
+                elements_.push_back(&element);
+            }
+        }
+    }
+
+    const Mesh& GetMesh() const {
+        return *mesh_;
+    }
+
+    size_t GetSize() const {
+        return positions_ ? elements_.size() : mesh_->vertices.size();
+    }
+
+    Vertex GetVertex(size_t index) const {
+        if (!positions_) {
+            return mesh_->vertices[index];
+        }
+
+        const PolygonalFaceElement& element = *elements_[index];
+        Vertex vertex;
+
+        vertex.position = (*positions_)[element.vertex - 1];
+
+        vertex.normal = { 0.0f, 0.0f, 0.0f };
+        if (element.normal >= 1 &&
+            element.normal <= static_cast<int>(normals_->size())) {
+            vertex.normal = (*normals_)[element.normal - 1];
+        }
+
+        vertex.textureCoordinates = { 0.0f, 0.0f, 0.0f };
+        if (element.texture >= 1 &&
+            element.texture <=
+                static_cast<int>(textureCoordinates_->size())) {
+            vertex.textureCoordinates =
+                (*textureCoordinates_)[element.texture - 1];
+        }
+
+        return vertex;
+    }
+
+ private:
+    const Mesh *mesh_;
+    const Point4DList *positions_;
+    const Point3DList *normals_;
+    const TextureCoordinatesList *textureCoordinates_;
+    std::vector<const PolygonalFaceElement *> elements_;
+};
+
+uint64_t MixHash(uint64_t hash, uint32_t value) {
+    hash ^= value;
+    hash *= 0x100000001B3ull;
+    return hash ^ (hash >> 32);
+}
+
+uint32_t FloatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/**
+ * Checks the parts of two vertices that a rigid transform leaves alone.
+ */
+bool SameInvariants(const Vertex& a, const Vertex& b) {
+    return FloatBits(a.position.w) == FloatBits(b.position.w) &&
+           FloatBits(a.textureCoordinates.u) ==
+               FloatBits(b.textureCoordinates.u) &&
+           FloatBits(a.textureCoordinates.v) ==
+               FloatBits(b.textureCoordinates.v) &&
+           FloatBits(a.textureCoordinates.w) ==
+               FloatBits(b.textureCoordinates.w);
+}
+
+bool SameVertex(const Vertex& a, const Vertex& b) {
+    return SameInvariants(a, b) &&
+           FloatBits(a.position.x) == FloatBits(b.position.x) &&
+           FloatBits(a.position.y) == FloatBits(b.position.y) &&
+           FloatBits(a.position.z) == FloatBits(b.position.z) &&
+           FloatBits(a.normal.x) == FloatBits(b.normal.x) &&
+           FloatBits(a.normal.y) == FloatBits(b.normal.y) &&
+           FloatBits(a.normal.z) == FloatBits(b.normal.z);
+}
+
+void BuildSignature(const CornerView& corners, InstanceMatching matching,
+                    MeshSignature *signature) {
+    const Mesh& mesh = corners.GetMesh();
+    const size_t count = corners.GetSize();
+    std::unordered_map<int, uint32_t> positionIds;
+    std::unordered_map<int, uint32_t> textureIds;
+    std::vector<uint32_t>& layout = signature->layout;
+
+    layout.reserve(mesh.faces.size() * 2 + count * 3);
+
+    for (const auto& face : mesh.faces) {
+        layout.push_back(static_cast<uint32_t>(face.elements.size()));
+        layout.push_back(face.smoothingGroup);
+
+        for (const auto& element : face.elements) {
+            layout.push_back(positionIds.try_emplace(element.vertex,
+                static_cast<uint32_t>(positionIds.size())).first->second);
+
+            if (element.texture >= 1) {
+                layout.push_back(textureIds.try_emplace(element.texture,
+                    static_cast<uint32_t>(textureIds.size())).first->second);
+            } else {
+                layout.push_back(NO_TEXTURE);
+            }
+
+            layout.push_back(element.normal >= 1 ? 1 : 0);
+        }
+    }
+
+    uint64_t hash = 0xCBF29CE484222325ull;
+
+    for (uint32_t value : layout) {
+        hash = MixHash(hash, value);
+    }
+
+    double sum[3] = { 0.0, 0.0, 0.0 };
+
+    for (size_t i = 0; i < count; ++i) {
+        const Vertex vertex = corners.GetVertex(i);
+
+        hash = MixHash(hash, FloatBits(vertex.position.w));
+        hash = MixHash(hash, FloatBits(vertex.textureCoordinates.u));
+        hash = MixHash(hash, FloatBits(vertex.textureCoordinates.v));
+        hash = MixHash(hash, FloatBits(vertex.textureCoordinates.w));
+
+        if (matching == InstanceMatching::EXACT) {
+            hash = MixHash(hash, FloatBits(vertex.position.x));
+            hash = MixHash(hash, FloatBits(vertex.position.y));
+            hash = MixHash(hash, FloatBits(vertex.position.z));
+            hash = MixHash(hash, FloatBits(vertex.normal.x));
+            hash = MixHash(hash, FloatBits(vertex.normal.y));
+            hash = MixHash(hash, FloatBits(vertex.normal.z));
+        }
+
+        sum[0] += vertex.position.x;
+        sum[1] += vertex.position.y;
+        sum[2] += vertex.position.z;
+    }
+
+    signature->hash = hash;
+
+    if (count == 0) {
+        return;
+    }
+
+    double squares = 0.0;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        signature->centroid[axis] = sum[axis] / static_cast<double>(count);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const Vertex vertex = corners.GetVertex(i);
+        const double dx = vertex.position.x - signature->centroid[0];
+        const double dy = vertex.position.y - signature->centroid[1];
+        const double dz = vertex.position.z - signature->centroid[2];
+        squares += dx * dx + dy * dy + dz * dz;
+    }
+
+    signature->spread = std::sqrt(squares / static_cast<double>(count));
+}
+
+/**
+ * Finds the eigenvector of the largest eigenvalue of a symmetric 4x4
+ * matrix with cyclic Jacobi rotations.
+ *
+ * @param matrix The matrix, which is diagonalised in place.
+ * @param vector Receives the unit eigenvector.
+ */
+void LargestEigenvector(double matrix[4][4], double vector[4]) {
+    double basis[4][4];
+
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            basis[row][column] = row == column ? 1.0 : 0.0;
+        }
+    }
+
+    for (int sweep = 0; sweep < MAX_JACOBI_SWEEPS; ++sweep) {
+        double offDiagonal = 0.0;
+        double diagonal = 0.0;
+
+        for (int row = 0; row < 4; ++row) {
+            diagonal += matrix[row][row] * matrix[row][row];
+
+            for (int column = row + 1; column < 4; ++column) {
+                offDiagonal += matrix[row][column] * matrix[row][column];
+            }
+        }
+
+        if (offDiagonal <= 1.0e-30 * diagonal || offDiagonal == 0.0) {
+            break;
+        }
+
+        for (int p = 0; p < 3; ++p) {
+            for (int q = p + 1; q < 4; ++q) {
+                if (matrix[p][q] == 0.0) {
+                    continue;
+                }
+
+                const double theta = (matrix[q][q] - matrix[p][p]) /
+                                     (2.0 * matrix[p][q]);
+                const double t = (theta >= 0.0 ? 1.0 : -1.0) /
+                    (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                const double c = 1.0 / std::sqrt(t * t + 1.0);
+                const double s = t * c;
+
+                for (int k = 0; k < 4; ++k) {
+                    const double kp = matrix[k][p];
+                    const double kq = matrix[k][q];
+                    matrix[k][p] = c * kp - s * kq;
+                    matrix[k][q] = s * kp + c * kq;
+                }
+
+                for (int k = 0; k < 4; ++k) {
+                    const double pk = matrix[p][k];
+                    const double qk = matrix[q][k];
+                    matrix[p][k] = c * pk - s * qk;
+                    matrix[q][k] = s * pk + c * qk;
+                }
+
+                for (int k = 0; k < 4; ++k) {
+                    const double kp = basis[k][p];
+                    const double kq = basis[k][q];
+                    basis[k][p] = c * kp - s * kq;
+                    basis[k][q] = s * kp + c * kq;
+                }
+            }
+        }
+    }
+
+    int largest = 0;
+
+    for (int i = 1; i < 4; ++i) {
+        if (matrix[i][i] > matrix[largest][largest]) {
+            largest = i;
+        }
+    }
+
+    double length = 0.0;
+
+    for (int i = 0; i < 4; ++i) {
+        vector[i] = basis[i][largest];
+        length += vector[i] * vector[i];
+    }
+
+    length = std::sqrt(length);
+
+    for (int i = 0; i < 4; ++i) {
+        vector[i] /= length;
+    }
+}
+
+/**
+ * Fits the rigid transform that best maps the corners of one mesh onto
+ * another's and checks that every corner lies within tolerance.
+ *
+ * The rotation is the unit quaternion maximising the correlation between
+ * the centred positions (Horn, 1987), which is the eigenvector of the
+ * largest eigenvalue of a 4x4 matrix built from their cross covariance.
+ * The check uses the transform rounded to float, as it will be stored.
+ *
+ * @return true if the meshes match, with transform mapping from to to.
+ */
+bool FitRigidTransform(const CornerView& from,
+                       const MeshSignature& fromSignature,
+                       const CornerView& to,
+                       const MeshSignature& toSignature,
+                       const InstanceDetectionOptions& options,
+                       float transform[3][4]) {
+    const double tolerance = options.tolerance;
+
+    if (std::fabs(fromSignature.spread - toSignature.spread) >
+        2.0 * tolerance) {
+        return false;
+    }
+
+    const size_t count = from.GetSize();
+    double covariance[3][3] = {};
+
+    for (size_t i = 0; i < count; ++i) {
+        const Vertex a = from.GetVertex(i);
+        const Vertex b = to.GetVertex(i);
+
+        if (!SameInvariants(a, b)) {
+            return false;
+        }
+
+        const double pa[3] = { a.position.x - fromSignature.centroid[0],
+                               a.position.y - fromSignature.centroid[1],
+                               a.position.z - fromSignature.centroid[2] };
+        const double pb[3] = { b.position.x - toSignature.centroid[0],
+                               b.position.y - toSignature.centroid[1],
+                               b.position.z - toSignature.centroid[2] };
+
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 3; ++column) {
+                covariance[row][column] += pa[row] * pb[column];
+            }
+        }
+    }
+
+    const double (&s)[3][3] = covariance;
+    double matrix[4][4] = {
+        { s[0][0] + s[1][1] + s[2][2], s[1][2] - s[2][1],
+          s[2][0] - s[0][2], s[0][1] - s[1][0] },
+        { s[1][2] - s[2][1], s[0][0] - s[1][1] - s[2][2],
+          s[0][1] + s[1][0], s[2][0] + s[0][2] },
+        { s[2][0] - s[0][2], s[0][1] + s[1][0],
+          -s[0][0] + s[1][1] - s[2][2], s[1][2] + s[2][1] },
+        { s[0][1] - s[1][0], s[2][0] + s[0][2],
+          s[1][2] + s[2][1], -s[0][0] - s[1][1] + s[2][2] }
+    };
+
+    double q[4];
+    LargestEigenvector(matrix, q);
+
+    const double w = q[0], x = q[1], y = q[2], z = q[3];
+    const double rotation[3][3] = {
+        { 1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y - w * z),
+          2.0 * (x * z + w * y) },
+        { 2.0 * (x * y + w * z), 1.0 - 2.0 * (x * x + z * z),
+          2.0 * (y * z - w * x) },
+        { 2.0 * (x * z - w * y), 2.0 * (y * z + w * x),
+          1.0 - 2.0 * (x * x + y * y) }
+    };
+
+    double r[3][4];
+
+    for (int row = 0; row < 3; ++row) {
+        double translation = toSignature.centroid[row];
+
+        for (int column = 0; column < 3; ++column) {
+            r[row][column] = static_cast<float>(rotation[row][column]);
+            translation -= rotation[row][column] *
+                           fromSignature.centroid[column];
+        }
+
+        r[row][3] = static_cast<float>(translation);
+    }
+
+    const double toleranceSquared = tolerance * tolerance;
+    const double normalToleranceSquared =
+        static_cast<double>(options.normalTolerance) * options.normalTolerance;
+
+    for (size_t i = 0; i < count; ++i) {
+        const Vertex a = from.GetVertex(i);
+        const Vertex b = to.GetVertex(i);
+        const double pa[3] = { a.position.x, a.position.y, a.position.z };
+        const double pb[3] = { b.position.x, b.position.y, b.position.z };
+        const double na[3] = { a.normal.x, a.normal.y, a.normal.z };
+        const double nb[3] = { b.normal.x, b.normal.y, b.normal.z };
+        double positionError = 0.0;
+        double normalError = 0.0;
+
+        for (int row = 0; row < 3; ++row) {
+            const double position = r[row][0] * pa[0] + r[row][1] * pa[1] +
+                                    r[row][2] * pa[2] + r[row][3];
+            const double normal = r[row][0] * na[0] + r[row][1] * na[1] +
+                                  r[row][2] * na[2];
+            positionError += (position - pb[row]) * (position - pb[row]);
+            normalError += (normal - nb[row]) * (normal - nb[row]);
+        }
+
+        if (positionError > toleranceSquared ||
+            normalError > normalToleranceSquared) {
+            return false;
+        }
+    }
+
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            transform[row][column] = static_cast<float>(r[row][column]);
+        }
+    }
+
+    return true;
+}
+
+bool MatchMeshes(const CornerView& from, const MeshSignature& fromSignature,
+                 const CornerView& to, const MeshSignature& toSignature,
+                 const InstanceDetectionOptions& options,
+                 float transform[3][4]) {
+    if (fromSignature.hash != toSignature.hash ||
+        from.GetSize() != to.GetSize() ||
+        fromSignature.layout != toSignature.layout) {
+        return false;
+    }
+
+    if (options.matching == InstanceMatching::RIGID) {
+        return FitRigidTransform(from, fromSignature, to, toSignature,
+                                 options, transform);
+    }
+
+    for (size_t i = 0; i < from.GetSize(); ++i) {
+        if (!SameVertex(from.GetVertex(i), to.GetVertex(i))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Combines two transforms so that result applies inner then outer.
+ */
+void ComposeTransforms(const float outer[3][4], const float inner[3][4],
+                       float result[3][4]) {
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            float value = column == 3 ? outer[row][3] : 0.0f;
+
+            for (int k = 0; k < 3; ++k) {
+                value += outer[row][k] * inner[k][column];
+            }
+
+            result[row][column] = value;
+        }
+    }
+}
+
+}   // namespace
+
+InstanceDetector::InstanceDetector() {
+}
+
+InstanceDetector::InstanceDetector(const InstanceDetectionOptions& options)
+    : options_(options) {
+}
+
+/**
+ * Replaces repeated meshes in a model with instances of their first
+ * occurrence.
+ *
+ * Instances already in the model that refer to a mesh found to be a copy
+ * are moved onto the shared mesh with the two transforms combined.
+ *
+ * @param model The model to process, which must have finalised vertices
+ *        and must not yet be consolidated.
+ * @return true on success, false if the model cannot be processed.
+ */
+bool InstanceDetector::Detect(Model *model) {
+    return DetectMeshes(model, nullptr, nullptr, nullptr);
+}
+
+/**
+ * Replaces repeated meshes in a model that has not been finalised with
+ * instances of their first occurrence.
+ *
+ * Meshes are compared through their face elements, so only the meshes
+ * that are kept need finalising afterwards. The model bounds are left for
+ * the caller to update once that is done.
+ *
+ * @param model The model to process, which must not yet be finalised.
+ * @param positions Positions indexed by the face elements.
+ * @param normals Normals indexed by the face elements.
+ * @param textureCoordinates Texture coordinates indexed by the face
+ *        elements.
+ * @return true on success, false if the model cannot be processed.
+ */
+bool InstanceDetector::Detect(
+    Model *model,
+    const Point4DList& positions,
+    const Point3DList& normals,
+    const TextureCoordinatesList& textureCoordinates) {
+    return DetectMeshes(model, &positions, &normals, &textureCoordinates);
+}
+
+bool InstanceDetector::DetectMeshes(
+    Model *model,
+    const Point4DList *positions,
+    const Point3DList *normals,
+    const TextureCoordinatesList *textureCoordinates) {
+    if (!model) {
+        LOG(Logger::LogLevel::Critical,
+            "Invalid model passed to InstanceDetector");
+        return false;
+    }
+
+    if (model->consolidated) {
+        LOG(Logger::LogLevel::Critical,
+            "InstanceDetector must run before buffers are consolidated");
+        return false;
+    }
+
+    const size_t meshCount = model->meshes.size();
+    std::vector<CornerView> corners(meshCount);
+    std::vector<MeshSignature> signatures(meshCount);
+
+    ParallelFor(meshCount, 1, [&](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; ++m) {
+            if (positions) {
+                corners[m].SetElements(&model->meshes[m], positions,
+                                       normals, textureCoordinates);
+            } else {
+                corners[m].SetVertices(&model->meshes[m]);
+            }
+
+            BuildSignature(corners[m], options_.matching, &signatures[m]);
+        }
+    }, options_.threadCount);
+
+    // Group the candidates by hash, in file order within each group so the
+    // first occurrence of each shape is the one kept.
+    std::vector<size_t> order;
+
+    for (size_t m = 0; m < meshCount; ++m) {
+        if (corners[m].GetSize() != 0) {
+            order.push_back(m);
+        }
+    }
+
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return signatures[a].hash < signatures[b].hash ||
+               (signatures[a].hash == signatures[b].hash && a < b);
+    });
+
+    std::vector<size_t> groups;
+
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i == 0 ||
+            signatures[order[i]].hash != signatures[order[i - 1]].hash) {
+            groups.push_back(i);
+        }
+    }
+
+    groups.push_back(order.size());
+
+    // The mesh each mesh is a copy of, itself if it is unique, and the
+    // transform from that mesh.
+    std::vector<size_t> prototypes(meshCount);
+    std::vector<MeshInstance> placements(meshCount);
+    std::iota(prototypes.begin(), prototypes.end(), 0);
+
+    ParallelFor(groups.size() - 1, 1, [&](size_t begin, size_t end) {
+        std::vector<size_t> unique;
+
+        for (size_t g = begin; g < end; ++g) {
+            unique.clear();
+
+            for (size_t i = groups[g]; i < groups[g + 1]; ++i) {
+                const size_t m = order[i];
+
+                for (size_t u : unique) {
+                    if (MatchMeshes(corners[u], signatures[u],
+                                    corners[m], signatures[m],
+                                    options_, placements[m].transform)) {
+                        prototypes[m] = u;
+                        break;
+                    }
+                }
+
+                if (prototypes[m] == m) {
+                    unique.push_back(m);
+                }
+            }
+        }
+    }, options_.threadCount);
+
+    std::vector<size_t> remap(meshCount);
+    size_t uniqueCount = 0;
+
+    for (size_t m = 0; m < meshCount; ++m) {
+        if (prototypes[m] == m) {
+            remap[m] = uniqueCount++;
+        }
+    }
+
+    if (uniqueCount == meshCount) {
+        return true;
+    }
+
+    // The views point into the meshes about to be moved.
+    corners.clear();
+
+    std::vector<Mesh> meshes;
+    meshes.reserve(uniqueCount);
+
+    for (size_t m = 0; m < meshCount; ++m) {
+        if (prototypes[m] == m) {
+            meshes.push_back(std::move(model->meshes[m]));
+        }
+    }
+
+    std::vector<MeshInstance> instances;
+    instances.reserve(model->instances.size() + meshCount - meshes.size());
+
+    for (const auto& existing : model->instances) {
+        MeshInstance instance = existing;
+
+        if (existing.mesh < meshCount) {
+            const size_t source = existing.mesh;
+
+            if (prototypes[source] != source) {
+                ComposeTransforms(existing.transform,
+                                  placements[source].transform,
+                                  instance.transform);
+            }
+
+            instance.mesh = remap[prototypes[source]];
+        }
+
+        instances.push_back(std::move(instance));
+    }
+
+    for (size_t m = 0; m < meshCount; ++m) {
+        if (prototypes[m] != m) {
+            MeshInstance& instance = placements[m];
+            instance.name = std::move(model->meshes[m].name);
+            instance.material = std::move(model->meshes[m].material);
+            instance.mesh = remap[prototypes[m]];
+            instances.push_back(std::move(instance));
+        }
+    }
+
+    LOG(Logger::LogLevel::Debug, std::format(
+        "INSTANCES => {} meshes into {}, {} instances",
+        meshCount, meshes.size(), instances.size()));
+
+    model->meshes = std::move(meshes);
+    model->instances = std::move(instances);
+    model->totalMeshes = model->meshes.size();
+
+    if (!positions) {
+        model->UpdateBounds();
+    }
+
+    return true;
+}
+
+}   // namespace Meshborn
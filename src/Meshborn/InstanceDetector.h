@@ -0,0 +1,99 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef INSTANCEDETECTOR_H_
+#define INSTANCEDETECTOR_H_
+#include "Model.h"
+
+namespace Meshborn {
+
+/**
+ * How closely two meshes must agree to be treated as copies.
+ */
+enum class InstanceMatching {
+    // Vertices and faces are identical, the copy sits in the same place.
+    EXACT,
+
+    // Faces and texture coordinates are identical and the positions and
+    // normals agree after a rotation and translation.
+    RIGID
+};
+
+/**
+ * Settings controlling instance detection.
+ */
+struct InstanceDetectionOptions {
+    InstanceDetectionOptions() : matching(InstanceMatching::RIGID),
+                                 tolerance(1.0e-4f),
+                                 normalTolerance(1.0e-3f),
+                                 threadCount(0) {}
+
+    InstanceMatching matching;
+
+    // Largest distance allowed between a transformed position and the
+    // position it is matched with.
+    float tolerance;
+
+    // Largest difference allowed between a rotated unit normal and the
+    // normal it is matched with.
+    float normalTolerance;
+
+    // Maximum worker threads, 0 selects the hardware default.
+    unsigned int threadCount;
+};
+
+/**
+ * Finds meshes that repeat the geometry of an earlier mesh, such as the
+ * bolts or wheels of an exported assembly, and replaces them with
+ * instances of that mesh.
+ *
+ * Meshes are fingerprinted by their face layout and, for rigid matching,
+ * by their texture coordinates, which a rigid transform leaves unchanged.
+ * Meshes with the same fingerprint are then compared in full, fitting the
+ * best rotation with Horn's quaternion method.
+ *
+ * Detection runs before consolidation, either on finalised meshes or on
+ * their face elements and the attribute lists they index. The parser uses
+ * the second form so that copies are never finalised. The mesh that
+ * occurs first is kept and the copies are removed, so later processing
+ * only touches the unique geometry.
+ */
+class InstanceDetector {
+ public:
+    InstanceDetector();
+
+    explicit InstanceDetector(const InstanceDetectionOptions& options);
+
+    bool Detect(Model *model);
+
+    bool Detect(Model *model,
+                const Point4DList& positions,
+                const Point3DList& normals,
+                const TextureCoordinatesList& textureCoordinates);
+
+ private:
+    InstanceDetectionOptions options_;
+
+    bool DetectMeshes(Model *model,
+                      const Point4DList *positions,
+                      const Point3DList *normals,
+                      const TextureCoordinatesList *textureCoordinates);
+};
+
+}   // namespace Meshborn
+
+#endif  // INSTANCEDETECTOR_H_
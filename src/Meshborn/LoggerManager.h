@@ -17,14 +17,31 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #ifndef LOGGERMANAGER_H_
 #define LOGGERMANAGER_H_
+#include <atomic>
 #include <memory>
 #include <mutex>    // NOLINT
+#include <string>
+#include <thread>   // NOLINT
 #include <utility>
 #include "Logger.h"
 
 namespace Meshborn {
 namespace Logger {
 
+/**
+ * Holds the application's logger. Logging reads the logger through an
+ * atomic pointer and checks the level first, so it takes no lock; the
+ * mutex only guards replacing the logger.
+ *
+ * Each call to the global logger is counted against the current epoch.
+ * Replacing the logger advances the epoch twice, waiting each time for the
+ * calls counted against the previous one to return, and then destroys the
+ * old logger. SetLogger therefore blocks until every Log() already using
+ * the old logger has finished, and must not be called from a logger's own
+ * Log().
+ *
+ * A thread can log to its own logger instead, see ScopedThreadLogger.
+ */
 class LoggerManager {
  public:
     static LoggerManager& Instance() {
@@ -34,39 +51,154 @@ class LoggerManager {
 
     void SetLogger(std::shared_ptr<ILogger> newLogger) {
         std::lock_guard<std::mutex> lock(mutex_);
-        logger_ = std::move(newLogger);
+        std::shared_ptr<ILogger> previous = std::move(owned_);
+
+        owned_ = std::move(newLogger);
+        logger_.store(owned_.get());
+
+        // A call still using the old logger was counted before the store
+        // above, against one of the two counters. Each is seen at zero
+        // after the store before the old logger is released. Calls that
+        // start after a flip count against the other counter, so neither
+        // wait can be held up by new calls.
+        for (int phase = 0; phase < 2; ++phase) {
+            const unsigned int epoch = epoch_.fetch_add(1);
+
+            while (readers_[epoch & 1].load() != 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void SetLevel(LogLevel level) {
+        level_.store(level, std::memory_order_relaxed);
+    }
+
+    LogLevel GetLevel() const {
+        return level_.load(std::memory_order_relaxed);
     }
 
     bool HasLogger() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return logger_ != nullptr;
+        return threadLogger_ ||
+               logger_.load(std::memory_order_relaxed) != nullptr;
     }
 
-    ILogger& GetLogger() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return *logger_;
+    // Logger used by the calling thread in place of the global one, or
+    // null if it has none.
+    static ILogger *GetThreadLogger() {
+        return threadLogger_;
+    }
+
+    static void SetThreadLogger(ILogger *logger) {
+        threadLogger_ = logger;
+    }
+
+    // True if a message of the level would be logged, checked before the
+    // message is built.
+    bool IsEnabled(LogLevel level) const {
+        return static_cast<int>(level) >=
+               static_cast<int>(level_.load(std::memory_order_relaxed)) &&
+               HasLogger();
+    }
+
+    void Log(LogLevel level, const std::string& message) {
+        if (threadLogger_) {
+            threadLogger_->Log(level, message);
+            return;
+        }
+
+        ReaderScope reader(this);
+        ILogger *logger = logger_.load();
+
+        if (logger) {
+            logger->Log(level, message);
+        }
     }
 
  private:
-    LoggerManager() = default;
-    std::shared_ptr<ILogger> logger_;
-    mutable std::mutex mutex_;
+    LoggerManager() : logger_(nullptr), level_(LogLevel::Debug), epoch_(0) {
+        readers_[0].store(0);
+        readers_[1].store(0);
+    }
+
+    /**
+     * Counts a call to the global logger against the current epoch for as
+     * long as it runs, including when the logger throws.
+     */
+    class ReaderScope {
+     public:
+        explicit ReaderScope(LoggerManager *manager)
+            : counter_(&manager->readers_[manager->epoch_.load() & 1]) {
+            counter_->fetch_add(1);
+        }
+
+        ~ReaderScope() {
+            counter_->fetch_sub(1);
+        }
+
+        ReaderScope(const ReaderScope&) = delete;
+        ReaderScope& operator=(const ReaderScope&) = delete;
+
+     private:
+        std::atomic<unsigned int> *counter_;
+    };
+
+    std::atomic<ILogger *> logger_;
+    std::atomic<LogLevel> level_;
+    std::shared_ptr<ILogger> owned_;
+    std::mutex mutex_;
+
+    // Calls to the global logger in progress, by the parity of the epoch
+    // they started in.
+    std::atomic<unsigned int> epoch_;
+    std::atomic<unsigned int> readers_[2];
+
+    static inline thread_local ILogger *threadLogger_ = nullptr;
 };
 
-#ifndef DISABLE_LOGGING
+/**
+ * Sends the calling thread's messages to a logger for the rest of the
+ * scope, then restores the previous one. A null logger leaves the thread's
+ * logger unchanged.
+ */
+class ScopedThreadLogger {
+ public:
+    explicit ScopedThreadLogger(ILogger *logger)
+        : previous_(LoggerManager::GetThreadLogger()) {
+        if (logger) {
+            LoggerManager::SetThreadLogger(logger);
+        }
+    }
+
+    ~ScopedThreadLogger() {
+        LoggerManager::SetThreadLogger(previous_);
+    }
+
+    ScopedThreadLogger(const ScopedThreadLogger&) = delete;
+    ScopedThreadLogger& operator=(const ScopedThreadLogger&) = delete;
+
+ private:
+    ILogger *previous_;
+};
+
+// Lowest level compiled in; messages below it cost nothing at run time.
+// Debug messages are only compiled in with MESHBORN_LOG_DEBUG.
+#ifndef MESHBORN_LOG_LEVEL
   #ifdef MESHBORN_LOG_DEBUG
-    #define SHOULD_LOG_DEBUG true
+    #define MESHBORN_LOG_LEVEL 0
   #else
-    #define SHOULD_LOG_DEBUG false
+    #define MESHBORN_LOG_LEVEL 1
   #endif
+#endif
 
+#ifndef DISABLE_LOGGING
+  // The message expression is only evaluated once the level has passed
+  // both thresholds and a logger is set.
   #define LOG(level, message)                                           \
     do {                                                                \
-      if (Logger::LoggerManager::Instance().HasLogger()) {              \
-        if ((level) != Logger::LogLevel::Debug || SHOULD_LOG_DEBUG) {   \
-          Logger::LoggerManager::Instance().GetLogger().Log((level),    \
-                                                            (message)); \
-        }                                                               \
+      if (static_cast<int>(level) >= MESHBORN_LOG_LEVEL &&              \
+          Logger::LoggerManager::Instance().IsEnabled((level))) {       \
+        Logger::LoggerManager::Instance().Log((level), (message));      \
       }                                                                 \
     } while (0)
 #else
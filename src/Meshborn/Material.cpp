@@ -16,13 +16,15 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "Material.h"
+#include "StringMemory.h"
 
 namespace Meshborn {
 
  /**
  * @brief Constructs a new Material with the given name.
  * 
- * Initializes the ambient colour to black (0, 0, 0) and marks it as unset.
+ * Initializes the colours to black (0, 0, 0) and marks every property as
+ * unset.
  * 
  * @param name The name of the material.
  */
@@ -35,12 +37,52 @@ Material::Material(std::string name) : name_(name) {
 
     specularColour_ = RGB(0.0f, 0.0f, 0.0f);
     specularColourSet_ = false;
+
+    emissiveColour_ = RGB(0.0f, 0.0f, 0.0f);
+    emissiveColourSet_ = false;
+
+    illuminationModel_ = 0;
+    illuminationModelSet_ = false;
+
+    opticalDensity_ = 0.0f;
+    opticalDensitySet_ = false;
+
+    transparentDissolve_ = 1.0f;
+    transparentDissolveSet_ = false;
+
+    ambientTextureMapSet_ = false;
+    diffuseTextureMapSet_ = false;
+    specularColourTextureMapSet_ = false;
+    specularHighlightComponentSet_ = false;
+    alphaTextureMapSet_ = false;
+    bumpMapSet_ = false;
+    displacementMapSet_ = false;
+    stencilDecalTextureSet_ = false;
 }
 
 std::string Material::GetName() {
     return name_;
 }
 
+/**
+ * Returns the bytes held by the material: the object itself and the heap
+ * storage of its name and texture map strings.
+ *
+ * @return Size of the material in bytes.
+ */
+size_t Material::GetMemoryUsage() const {
+    return sizeof(Material) +
+           GetStringHeapBytes(name_) +
+           GetStringHeapBytes(ambientTextureMap_) +
+           GetStringHeapBytes(diffuseTextureMap_) +
+           GetStringHeapBytes(specularColourTextureMap_) +
+           GetStringHeapBytes(specularHighlightComponent_) +
+           GetStringHeapBytes(alphaTextureMap_) +
+           GetStringHeapBytes(bumpMap_) +
+           GetStringHeapBytes(displacementMap_) +
+           GetStringHeapBytes(stencilDecalTexture_);
+}
+
 /**
  * @brief Sets the ambient colour of the material.
  * 
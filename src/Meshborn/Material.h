@@ -30,6 +30,9 @@ class Material {
 
     std::string GetName();
 
+    // Bytes held by the material, including its strings' heap storage.
+    size_t GetMemoryUsage() const;
+
     void SetAmbientColour(RGB colour);
     bool GetAmbientColour(RGB *colour);
 
@@ -17,10 +17,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <format>
 #include <iostream>
+#include <span>
 #include <vector>
 #include "MaterialLibraryParser.h"
 #include "Material.h"
 #include "LoggerManager.h"
+#include "ParseStatsRecorder.h"
+#include "TraceRecorder.h"
 
 namespace Meshborn {
 
@@ -49,6 +52,31 @@ const char KEYWORD_DISPLACEMENT_MAP[] = "disp ";
 // defaults to 'matte' channel of the image)
 const char KEYWORD_STENCIL_DECAL_TEXTURE[] = "decal ";
 
+namespace {
+
+/**
+ * Frees a context's material lines when a library has been parsed if its
+ * buffers have grown past the high-water mark. The other buffers are left
+ * to ParseObj, which may still be reading them.
+ */
+class MaterialBufferLimitGuard {
+ public:
+    explicit MaterialBufferLimitGuard(ParseContext *context)
+        : context_(context) {}
+
+    ~MaterialBufferLimitGuard() {
+        if (context_->buffers.GetReservedBytes() > context_->bufferLimit) {
+            std::vector<std::string>().swap(context_->buffers.materialLines);
+            context_->buffers.materialLineCount = 0;
+        }
+    }
+
+ private:
+    ParseContext *context_;
+};
+
+}   // namespace
+
 MaterialLibraryParser::MaterialLibraryParser() {
 }
 
@@ -74,28 +102,76 @@ MaterialLibraryParser::MaterialLibraryParser() {
  */
 bool MaterialLibraryParser::ParseLibrary(std::string materialFile,
                                          MaterialMap *materials) {
-    std::vector<std::string> rawLines;
+    context_.stats.Reset();
+    return ParseLibrary(materialFile, materials, &context_);
+}
+
+/**
+ * Parses a material library (.mtl) file as ParseLibrary(materialFile,
+ * materials) does, but logs to the context's logger and adds timings and
+ * counters to its statistics. The file's lines are read into the context's
+ * buffers. The parser itself is not modified, so one parser can be used by
+ * several threads, each with its own context.
+ *
+ * @param materialFile Path to the material file (.mtl) to be parsed.
+ * @param materials A pointer to a map where the parsed materials will be
+ *                  stored, keyed by their names.
+ * @param context The logger, statistics and buffers of this parse.
+ * @return true if the material file was successfully parsed, false if the
+ *         context is null or an error occurred during parsing.
+ */
+bool MaterialLibraryParser::ParseLibrary(std::string materialFile,
+                                         MaterialMap *materials,
+                                         ParseContext *context) const {
+    if (!context) {
+        LOG(Logger::LogLevel::Critical,
+            "Invalid parse context passed to ParseLibrary");
+        return false;
+    }
+
+    MaterialBufferLimitGuard bufferLimit(context);
+    ParseBuffers& buffers = context->buffers;
+
+    Logger::ScopedThreadLogger scopedLogger(context->logger);
+    TRACE_SCOPE("ParseMaterialLibrary", "mtl");
+    PARSE_STATS_PHASE(&context->stats, ParsePhase::MATERIAL_LIBRARY);
+    uint64_t bytesRead = 0;
 
     try {
-        rawLines = ReadFile(materialFile);
+        buffers.materialLineCount = ReadFile(materialFile,
+                                             &buffers.materialLines,
+                                             &bytesRead);
     }
     catch (std::runtime_error ex) {
         throw std::runtime_error(ex.what());
     }
 
+    const std::span<const std::string> rawLines(buffers.materialLines.data(),
+                                                buffers.materialLineCount);
+
+    PARSE_STATS(context->stats.bytesRead += bytesRead);
+    PARSE_STATS(context->stats.bytesAllocated +=
+        GetLinesAllocation(buffers.materialLines));
+
     std::shared_ptr<Material> currentMaterial = nullptr;
 
     for (const auto& line : rawLines) {
         std::string_view view(line);
+        PARSE_STATS_LINE_TIMER(&context->stats);
+        PARSE_STATS_LINE(ParseKeyword::MATERIAL_PROPERTY);
 
         // New material
         if (StartsWith(std::string(view), KEYWORD_NEW_MATERIAL)) {
             std::string materialName;
 
+            PARSE_STATS_LINE(ParseKeyword::NEW_MATERIAL);
+
             if (!ProcessTagNewMaterial(view, &materialName)) {
                 return false;
             }
 
+            PARSE_STATS(context->stats.materialsCreated++);
+
             LOG(Logger::LogLevel::Debug, std::format(
                 "NEW MATERIAL => {}", materialName));
 
@@ -409,6 +485,7 @@ bool MaterialLibraryParser::ParseLibrary(std::string materialFile,
         // Unknown tag : Doesn't mean it's invalid, it could be a tag that
         //               currently isn't parsed.
         } else {
+            PARSE_STATS_LINE(ParseKeyword::UNKNOWN);
             LOG(Logger::LogLevel::Debug, std::format(
                 "Unknown material tag '{}'", view));
         }
@@ -425,7 +502,7 @@ bool MaterialLibraryParser::ParseLibrary(std::string materialFile,
  * @return true if parsing was successful, false otherwise.
  */
 bool MaterialLibraryParser::ProcessTagNewMaterial(std::string_view line,
-                                                  std::string *material) {
+                                                  std::string *material) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 2) {
@@ -447,7 +524,7 @@ bool MaterialLibraryParser::ProcessTagNewMaterial(std::string_view line,
  * @return true if parsing was successful, false otherwise.
  */
 bool MaterialLibraryParser::ProcessTagAmbientColour(std::string_view line,
-                                                    RGB *colour) {
+                                                    RGB *colour) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 4) {
@@ -475,7 +552,7 @@ bool MaterialLibraryParser::ProcessTagAmbientColour(std::string_view line,
  * @return true if parsing was successful, false otherwise.
  */
 bool MaterialLibraryParser::ProcessTagDiffuseColour(std::string_view line,
-                                                    RGB *colour) {
+                                                    RGB *colour) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 4) {
@@ -503,7 +580,7 @@ bool MaterialLibraryParser::ProcessTagDiffuseColour(std::string_view line,
  * @return true if parsing was successful, false otherwise.
  */
 bool MaterialLibraryParser::ProcessTagEmissiveColour(std::string_view line,
-                                                     RGB *colour) {
+                                                     RGB *colour) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 4) {
@@ -531,7 +608,7 @@ bool MaterialLibraryParser::ProcessTagEmissiveColour(std::string_view line,
  * @return true if parsing was successful, false otherwise.
  */
 bool MaterialLibraryParser::ProcessTagSpecularColour(std::string_view line,
-                                                     RGB *colour) {
+                                                     RGB *colour) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 4) {
@@ -567,7 +644,7 @@ bool MaterialLibraryParser::ProcessTagSpecularColour(std::string_view line,
  *         false otherwise.
  */
 bool MaterialLibraryParser::ProcessTagSpecularExponent(std::string_view line,
-                                                       float *shininess) {
+                                                       float *shininess) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 2) {
@@ -597,8 +674,8 @@ bool MaterialLibraryParser::ProcessTagSpecularExponent(std::string_view line,
  *                     stored.
  * @return true if parsing and validation succeed, false otherwise.
  */
-bool MaterialLibraryParser::ProcessTagTransparentDissolve(std::string_view line,
-                                                          float *transparency) {
+bool MaterialLibraryParser::ProcessTagTransparentDissolve(
+    std::string_view line, float *transparency) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 2) {
@@ -638,7 +715,7 @@ bool MaterialLibraryParser::ProcessTagTransparentDissolve(std::string_view line,
  * @return true if parsing and validation succeed, false otherwise.
  */
 bool MaterialLibraryParser::ProcessTagOpticalDensity(std::string_view line,
-                                                     float *density) {
+                                                     float *density) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 2) {
@@ -684,7 +761,7 @@ bool MaterialLibraryParser::ProcessTagOpticalDensity(std::string_view line,
  *   true if the illumination model is parsed and valid; false otherwise.
  */
 bool MaterialLibraryParser::ProcessTagIlluminationModel(std::string_view line,
-                                                        int *density) {
+                                                        int *density) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 2) {
@@ -719,8 +796,8 @@ bool MaterialLibraryParser::ProcessTagIlluminationModel(std::string_view line,
  *              parsed;
  *         false otherwise.
  */
-bool MaterialLibraryParser::ProcessTagAmbientTextureMap(std::string_view line,
-                                                        std::string *map) {
+bool MaterialLibraryParser::ProcessTagAmbientTextureMap(
+    std::string_view line, std::string *map) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 2) {
@@ -748,8 +825,8 @@ bool MaterialLibraryParser::ProcessTagAmbientTextureMap(std::string_view line,
  * @return true if the line is correctly formatted and the filename was extracted;
  *         false otherwise.
  */
-bool MaterialLibraryParser::ProcessTagDiffuseTextureMap(std::string_view line,
-                                                        std::string *map) {
+bool MaterialLibraryParser::ProcessTagDiffuseTextureMap(
+    std::string_view line, std::string *map) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 2) {
@@ -779,7 +856,7 @@ bool MaterialLibraryParser::ProcessTagDiffuseTextureMap(std::string_view line,
  *         false otherwise.
  */
 bool MaterialLibraryParser::ProcessTagSpecularColorTextureMap(
-    std::string_view line, std::string *map) {
+    std::string_view line, std::string *map) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 2) {
@@ -810,7 +887,7 @@ bool MaterialLibraryParser::ProcessTagSpecularColorTextureMap(
  *         false otherwise.
  */
 bool MaterialLibraryParser::ProcessTagSpecularHighlightConponent(
-    std::string_view line, std::string *component) {
+    std::string_view line, std::string *component) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 2) {
@@ -839,7 +916,7 @@ bool MaterialLibraryParser::ProcessTagSpecularHighlightConponent(
  *         false otherwise.
  */
 bool MaterialLibraryParser::ProcessTagAlphaTextureMap(std::string_view line,
-                                                       std::string *map) {
+                                                       std::string *map) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 2) {
@@ -868,7 +945,7 @@ bool MaterialLibraryParser::ProcessTagAlphaTextureMap(std::string_view line,
  *         false otherwise.
  */
 bool MaterialLibraryParser::ProcessTagBumpMap(std::string_view line,
-                                              std::string *map) {
+                                              std::string *map) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 2) {
@@ -897,7 +974,7 @@ bool MaterialLibraryParser::ProcessTagBumpMap(std::string_view line,
  *         false otherwise.
  */
 bool MaterialLibraryParser::ProcessTagDisplacementMap(std::string_view line,
-                                                      std::string *map) {
+                                                      std::string *map) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 2) {
@@ -926,7 +1003,7 @@ bool MaterialLibraryParser::ProcessTagDisplacementMap(std::string_view line,
  *         false otherwise.
  */
 bool MaterialLibraryParser::ProcessTagStencilDecalTexture(
-    std::string_view line, std::string *texture) {
+    std::string_view line, std::string *texture) const {
     auto words = SplitElementString(std::string(line));
 
     if (words.size() != 2) {
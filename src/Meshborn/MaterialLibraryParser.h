@@ -21,6 +21,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <string>
 #include "BaseWavefrontParser.h"
 #include "Material.h"
+#include "ParseContext.h"
+#include "ParseStats.h"
 
 namespace Meshborn {
 
@@ -30,41 +32,65 @@ class MaterialLibraryParser : public BaseWavefrontParser {
 
     bool ParseLibrary(std::string materialFile, MaterialMap *materials);
 
+    // Parses with the logger and buffers of a context and adds to its
+    // statistics. Safe to call from several threads at once, each with its
+    // own context.
+    bool ParseLibrary(std::string materialFile,
+                      MaterialMap *materials,
+                      ParseContext *context) const;
+
+    // Statistics of the last ParseLibrary(materialFile, materials) call,
+    // see ParseStats.
+    const ParseStats& GetStats() const { return context_.stats; }
+
+    // Sets the high-water mark of the buffers kept between ParseLibrary
+    // calls, see ParseContext::bufferLimit.
+    void SetBufferLimit(size_t bytes) { context_.bufferLimit = bytes; }
+
  private:
-    bool ProcessTagNewMaterial(std::string_view line, std::string *material);
+    bool ProcessTagNewMaterial(std::string_view line,
+                               std::string *material) const;
 
-    bool ProcessTagAmbientColour(std::string_view line, RGB *colour);
-    bool ProcessTagDiffuseColour(std::string_view line, RGB *colour);
-    bool ProcessTagEmissiveColour(std::string_view line, RGB *colour);
-    bool ProcessTagSpecularColour(std::string_view line, RGB *colour);
+    bool ProcessTagAmbientColour(std::string_view line, RGB *colour) const;
+    bool ProcessTagDiffuseColour(std::string_view line, RGB *colour) const;
+    bool ProcessTagEmissiveColour(std::string_view line, RGB *colour) const;
+    bool ProcessTagSpecularColour(std::string_view line, RGB *colour) const;
 
-    bool ProcessTagSpecularExponent(std::string_view line, float *shininess);
+    bool ProcessTagSpecularExponent(std::string_view line,
+                                    float *shininess) const;
 
     bool ProcessTagTransparentDissolve(std::string_view line,
-                                       float *transparency);
+                                       float *transparency) const;
 
-    bool ProcessTagOpticalDensity(std::string_view line, float *density);
+    bool ProcessTagOpticalDensity(std::string_view line, float *density) const;
 
-    bool ProcessTagIlluminationModel(std::string_view line, int *density);
+    bool ProcessTagIlluminationModel(std::string_view line, int *density) const;
 
-    bool ProcessTagAmbientTextureMap(std::string_view line, std::string *map);
+    bool ProcessTagAmbientTextureMap(std::string_view line,
+                                     std::string *map) const;
 
-    bool ProcessTagDiffuseTextureMap(std::string_view line, std::string *map);
+    bool ProcessTagDiffuseTextureMap(std::string_view line,
+                                     std::string *map) const;
 
     bool ProcessTagSpecularColorTextureMap(std::string_view line,
-                                           std::string *map);
+                                           std::string *map) const;
 
     bool ProcessTagSpecularHighlightConponent(std::string_view line,
-                                              std::string *component);
+                                              std::string *component) const;
 
-    bool ProcessTagAlphaTextureMap(std::string_view line, std::string *map);
+    bool ProcessTagAlphaTextureMap(std::string_view line,
+                                   std::string *map) const;
 
-    bool ProcessTagBumpMap(std::string_view line, std::string *map);
+    bool ProcessTagBumpMap(std::string_view line, std::string *map) const;
 
-    bool ProcessTagDisplacementMap(std::string_view line, std::string *map);
+    bool ProcessTagDisplacementMap(std::string_view line,
+                                   std::string *map) const;
 
     bool ProcessTagStencilDecalTexture(std::string_view line,
-                                       std::string *texture);
+                                       std::string *texture) const;
+
+    // Statistics and buffers of ParseLibrary(materialFile, materials).
+    ParseContext context_;
 };
 
 }   // namespace Meshborn
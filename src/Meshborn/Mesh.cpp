@@ -16,3 +16,15 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "Mesh.h"
+
+namespace Meshborn {
+
+/**
+ * Recomputes the bounding box and bounding sphere from the mesh vertices.
+ */
+void Mesh::UpdateBounds() {
+    boundingBox = ComputeBoundingBox(vertices);
+    boundingSphere = ComputeBoundingSphere(vertices, boundingBox);
+}
+
+}   // namespace Meshborn
@@ -19,6 +19,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define MESH_H_
 #include <string>
 #include <vector>
+#include "BoundingVolume.h"
 #include "Structures.h"
 
 namespace Meshborn {
@@ -51,8 +52,15 @@ enum class PolygonalFaceType {
  * a vertex, texture coordinate, and/or normal index.
  */
 struct PolygonalFace {
+    PolygonalFace() : faceType(PolygonalFaceType::TRIANGE),
+                      smoothingGroup(0) {}
+
     PolygonalFaceType faceType;
     std::vector<PolygonalFaceElement> elements;
+
+    // Smoothing group active when the face was read, 0 means smoothing is
+    // off ('s off' or 's 0').
+    unsigned int smoothingGroup;
 };
 
 /**
@@ -62,10 +70,32 @@ struct PolygonalFace {
  */
 class Mesh {
  public:
+    Mesh() : vertexOffset(0), vertexCount(0), indexOffset(0),
+             indexCount(0) {}
+
+    void UpdateBounds();
+
     std::string name;
     std::string material;
     std::vector<PolygonalFace> faces;
     std::vector<Vertex> vertices;
+
+    // Optional per-vertex tangents, parallel to vertices. The w component
+    // holds the handedness, so the bitangent is w * cross(normal, tangent).
+    // Empty unless tangents have been generated.
+    std::vector<Point4D> tangents;
+
+    // Bounds of the vertex positions, computed when the mesh is finalised.
+    AxisAlignedBoundingBox boundingBox;
+    BoundingSphere boundingSphere;
+
+    // Range of the model's shared vertex and index buffers used by this
+    // mesh once the model has been consolidated, at which point vertices
+    // and tangents are emptied. Indices are relative to vertexOffset.
+    size_t vertexOffset;
+    size_t vertexCount;
+    size_t indexOffset;
+    size_t indexCount;
 };
 
 }   // namespace Meshborn
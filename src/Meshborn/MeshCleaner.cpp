@@ -0,0 +1,422 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <utility>
+#include <vector>
+#include "LoggerManager.h"
+#include "MeshCleaner.h"
+#include "Parallel.h"
+
+namespace Meshborn {
+
+namespace {
+
+// Number of faces handed to a worker thread in one chunk.
+const size_t CLEAN_GRAIN_SIZE = 16384;
+
+/**
+ * A run of faces from one mesh. Faces are split into runs of at most the
+ * grain size so that work is balanced however it is spread over meshes.
+ */
+struct FaceRange {
+    Mesh *mesh;
+    size_t begin;
+    size_t end;
+};
+
+std::vector<FaceRange> SplitFaces(std::vector<Mesh> *meshes) {
+    std::vector<FaceRange> ranges;
+
+    for (auto& mesh : *meshes) {
+        for (size_t begin = 0; begin < mesh.faces.size();
+             begin += CLEAN_GRAIN_SIZE) {
+            ranges.push_back({ &mesh, begin, std::min(
+                mesh.faces.size(), begin + CLEAN_GRAIN_SIZE) });
+        }
+    }
+
+    return ranges;
+}
+
+bool IsValidIndex(int index, size_t poolSize) {
+    return index >= 1 && static_cast<size_t>(index) <= poolSize;
+}
+
+PolygonalFaceType GetFaceType(size_t corners) {
+    if (corners == 3) {
+        return PolygonalFaceType::TRIANGE;
+    }
+
+    return corners == 4 ? PolygonalFaceType::QUAD : PolygonalFaceType::N_GON;
+}
+
+/**
+ * Collapses corners that repeat the position of the corner before them and
+ * tests whether the rest of the face encloses more than the minimum area.
+ *
+ * The area is that of a fan from the first corner, computed in double
+ * precision so that a triangle with collinear corners comes out with an
+ * area of exactly zero unless its coordinates differ greatly in magnitude.
+ * Faces that use a position outside the pool are kept for FinaliseVertices
+ * to report.
+ *
+ * @return false if the face is degenerate.
+ */
+bool CleanFace(PolygonalFace *face, const Point4DList& positions,
+               double minimumArea) {
+    auto& elements = face->elements;
+    size_t kept = 0;
+
+    for (size_t i = 0; i < elements.size(); ++i) {
+        if (kept == 0 || elements[i].vertex != elements[kept - 1].vertex) {
+            elements[kept++] = elements[i];
+        }
+    }
+
+    while (kept > 1 && elements[kept - 1].vertex == elements[0].vertex) {
+        --kept;
+    }
+
+    elements.resize(kept);
+
+    if (kept < 3) {
+        return false;
+    }
+
+    face->faceType = GetFaceType(kept);
+
+    for (const auto& element : elements) {
+        if (!IsValidIndex(element.vertex, positions.size())) {
+            return true;
+        }
+    }
+
+    const Point4D& origin = positions[elements[0].vertex - 1];
+    double area[3] = { 0.0, 0.0, 0.0 };
+
+    for (size_t i = 1; i + 1 < kept; ++i) {
+        const Point4D& b = positions[elements[i].vertex - 1];
+        const Point4D& c = positions[elements[i + 1].vertex - 1];
+        const double ab[3] = { static_cast<double>(b.x) - origin.x,
+                               static_cast<double>(b.y) - origin.y,
+                               static_cast<double>(b.z) - origin.z };
+        const double ac[3] = { static_cast<double>(c.x) - origin.x,
+                               static_cast<double>(c.y) - origin.y,
+                               static_cast<double>(c.z) - origin.z };
+
+        area[0] += ab[1] * ac[2] - ab[2] * ac[1];
+        area[1] += ab[2] * ac[0] - ab[0] * ac[2];
+        area[2] += ab[0] * ac[1] - ab[1] * ac[0];
+    }
+
+    return 0.5 * std::sqrt(area[0] * area[0] + area[1] * area[1] +
+                           area[2] * area[2]) > minimumArea;
+}
+
+/**
+ * Returns the corner holding the smallest position index, where a face's
+ * corners start when compared regardless of the corner it was written from.
+ */
+size_t GetFirstCorner(const PolygonalFace& face) {
+    size_t first = 0;
+
+    for (size_t i = 1; i < face.elements.size(); ++i) {
+        if (face.elements[i].vertex < face.elements[first].vertex) {
+            first = i;
+        }
+    }
+
+    return first;
+}
+
+bool SamePositions(const PolygonalFace& a, const PolygonalFace& b) {
+    const size_t count = a.elements.size();
+
+    if (b.elements.size() != count) {
+        return false;
+    }
+
+    const size_t firstA = GetFirstCorner(a);
+    const size_t firstB = GetFirstCorner(b);
+
+    for (size_t i = 0; i < count; ++i) {
+        if (a.elements[(firstA + i) % count].vertex !=
+            b.elements[(firstB + i) % count].vertex) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Clears the corners of faces that repeat an earlier face of the mesh.
+ *
+ * @return The number of faces cleared.
+ */
+size_t ClearDuplicateFaces(Mesh *mesh) {
+    std::vector<std::pair<uint64_t, size_t>> keys;
+    keys.reserve(mesh->faces.size());
+
+    for (size_t f = 0; f < mesh->faces.size(); ++f) {
+        const PolygonalFace& face = mesh->faces[f];
+        const size_t count = face.elements.size();
+
+        if (count < 3) {
+            continue;
+        }
+
+        const size_t first = GetFirstCorner(face);
+        uint64_t hash = count;
+
+        for (size_t i = 0; i < count; ++i) {
+            hash ^= static_cast<uint32_t>(
+                face.elements[(first + i) % count].vertex);
+            hash *= 0x9E3779B97F4A7C15ull;
+            hash ^= hash >> 31;
+        }
+
+        keys.emplace_back(hash, f);
+    }
+
+    // Sorting by face within each hash keeps the first copy of a face.
+    std::sort(keys.begin(), keys.end());
+
+    size_t cleared = 0;
+
+    for (size_t group = 0; group < keys.size();) {
+        size_t end = group + 1;
+
+        while (end < keys.size() && keys[end].first == keys[group].first) {
+            ++end;
+        }
+
+        for (size_t i = group + 1; i < end; ++i) {
+            PolygonalFace& face = mesh->faces[keys[i].second];
+
+            for (size_t j = group; j < i; ++j) {
+                const PolygonalFace& earlier = mesh->faces[keys[j].second];
+
+                if (!earlier.elements.empty() &&
+                    SamePositions(earlier, face)) {
+                    face.elements.clear();
+                    ++cleared;
+                    break;
+                }
+            }
+        }
+
+        group = end;
+    }
+
+    return cleared;
+}
+
+/**
+ * Moves the used entries of a pool to its start.
+ *
+ * @param pool The pool to compact.
+ * @param used Flags for each entry of the pool, set if it is used.
+ * @param remap Receives the new 1-based index of each used entry.
+ * @return The number of entries removed.
+ */
+template <typename T>
+size_t CompactPool(std::vector<T> *pool, const std::vector<uint8_t>& used,
+                   std::vector<int> *remap) {
+    remap->assign(pool->size(), 0);
+    size_t kept = 0;
+
+    for (size_t i = 0; i < pool->size(); ++i) {
+        if (used[i]) {
+            (*remap)[i] = static_cast<int>(++kept);
+        }
+    }
+
+    const size_t removed = pool->size() - kept;
+
+    // Entries only move towards the start, so the pool is compacted in
+    // place and keeps its capacity.
+    if (removed) {
+        size_t next = 0;
+
+        for (size_t i = 0; i < pool->size(); ++i) {
+            if (used[i]) {
+                (*pool)[next++] = (*pool)[i];
+            }
+        }
+
+        pool->resize(kept);
+    }
+
+    return removed;
+}
+
+void MarkUsed(int index, std::vector<uint8_t> *used) {
+    if (IsValidIndex(index, used->size())) {
+        std::atomic_ref<uint8_t>((*used)[index - 1]).store(
+            1, std::memory_order_relaxed);
+    }
+}
+
+int RemapIndex(int index, const std::vector<int>& remap) {
+    return IsValidIndex(index, remap.size()) ? remap[index - 1] : index;
+}
+
+}   // namespace
+
+MeshCleaner::MeshCleaner() {
+}
+
+MeshCleaner::MeshCleaner(const MeshCleanupOptions& options)
+    : options_(options) {
+}
+
+/**
+ * Cleans meshes whose faces refer to shared attribute pools, removing
+ * faces and pool entries as set in the options.
+ *
+ * Indices outside a pool are left for FinaliseVertices to handle; as the
+ * pools only shrink they stay outside them.
+ *
+ * @param positions The position pool used by the faces.
+ * @param normals The normal pool used by the faces.
+ * @param textureCoordinates The texture coordinate pool used by the faces.
+ * @param meshes Meshes whose faces refer to the pools.
+ * @return true on success, false if a pool or the meshes are missing.
+ */
+bool MeshCleaner::Clean(Point4DList *positions,
+                        Point3DList *normals,
+                        TextureCoordinatesList *textureCoordinates,
+                        std::vector<Mesh> *meshes) {
+    if (!positions || !normals || !textureCoordinates || !meshes) {
+        LOG(Logger::LogLevel::Critical,
+            "Invalid arguments passed to MeshCleaner");
+        return false;
+    }
+
+    std::atomic<size_t> degenerateFaces = 0;
+    std::atomic<size_t> duplicateFaces = 0;
+
+    if (options_.removeDegenerateFaces) {
+        const std::vector<FaceRange> ranges = SplitFaces(meshes);
+        const double minimumArea = options_.minimumArea;
+
+        ParallelFor(ranges.size(), 1, [&](size_t begin, size_t end) {
+            size_t removed = 0;
+
+            for (size_t r = begin; r < end; ++r) {
+                for (size_t f = ranges[r].begin; f < ranges[r].end; ++f) {
+                    PolygonalFace& face = ranges[r].mesh->faces[f];
+
+                    if (!CleanFace(&face, *positions, minimumArea)) {
+                        face.elements.clear();
+                        ++removed;
+                    }
+                }
+            }
+
+            degenerateFaces += removed;
+        }, options_.threadCount);
+    }
+
+    if (options_.removeDuplicateFaces) {
+        ParallelFor(meshes->size(), 1, [&](size_t begin, size_t end) {
+            for (size_t m = begin; m < end; ++m) {
+                duplicateFaces += ClearDuplicateFaces(&(*meshes)[m]);
+            }
+        }, options_.threadCount);
+    }
+
+    if (degenerateFaces || duplicateFaces) {
+        ParallelFor(meshes->size(), 1, [&](size_t begin, size_t end) {
+            for (size_t m = begin; m < end; ++m) {
+                std::erase_if((*meshes)[m].faces,
+                              [](const PolygonalFace& face) {
+                    return face.elements.empty();
+                });
+            }
+        }, options_.threadCount);
+    }
+
+    size_t unusedPositions = 0;
+    size_t unusedNormals = 0;
+    size_t unusedTextureCoordinates = 0;
+
+    if (options_.removeUnusedAttributes) {
+        const std::vector<FaceRange> ranges = SplitFaces(meshes);
+        std::vector<uint8_t> usedPositions(positions->size(), 0);
+        std::vector<uint8_t> usedNormals(normals->size(), 0);
+        std::vector<uint8_t> usedTextures(textureCoordinates->size(), 0);
+
+        ParallelFor(ranges.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t r = begin; r < end; ++r) {
+                for (size_t f = ranges[r].begin; f < ranges[r].end; ++f) {
+                    for (const auto& element :
+                         ranges[r].mesh->faces[f].elements) {
+                        MarkUsed(element.vertex, &usedPositions);
+                        MarkUsed(element.normal, &usedNormals);
+                        MarkUsed(element.texture, &usedTextures);
+                    }
+                }
+            }
+        }, options_.threadCount);
+
+        std::vector<int> positionRemap;
+        std::vector<int> normalRemap;
+        std::vector<int> textureRemap;
+
+        unusedPositions = CompactPool(positions, usedPositions,
+                                      &positionRemap);
+        unusedNormals = CompactPool(normals, usedNormals, &normalRemap);
+        unusedTextureCoordinates = CompactPool(textureCoordinates,
+                                               usedTextures, &textureRemap);
+
+        if (unusedPositions || unusedNormals || unusedTextureCoordinates) {
+            ParallelFor(ranges.size(), 1, [&](size_t begin, size_t end) {
+                for (size_t r = begin; r < end; ++r) {
+                    for (size_t f = ranges[r].begin; f < ranges[r].end;
+                         ++f) {
+                        for (auto& element :
+                             ranges[r].mesh->faces[f].elements) {
+                            element.vertex = RemapIndex(element.vertex,
+                                                        positionRemap);
+                            element.normal = RemapIndex(element.normal,
+                                                        normalRemap);
+                            element.texture = RemapIndex(element.texture,
+                                                         textureRemap);
+                        }
+                    }
+                }
+            }, options_.threadCount);
+        }
+    }
+
+    LOG(Logger::LogLevel::Debug, std::format(
+        "CLEAN => removed {} degenerate faces, {} duplicate faces, "
+        "{} positions, {} normals, {} texture coordinates",
+        degenerateFaces.load(), duplicateFaces.load(), unusedPositions,
+        unusedNormals, unusedTextureCoordinates));
+
+    return true;
+}
+
+}   // namespace Meshborn
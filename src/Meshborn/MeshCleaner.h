@@ -0,0 +1,79 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef MESHCLEANER_H_
+#define MESHCLEANER_H_
+#include <vector>
+#include "Mesh.h"
+#include "Structures.h"
+
+namespace Meshborn {
+
+/**
+ * Settings controlling mesh cleanup.
+ */
+struct MeshCleanupOptions {
+    MeshCleanupOptions() : removeDegenerateFaces(true),
+                           removeDuplicateFaces(true),
+                           removeUnusedAttributes(true),
+                           minimumArea(0.0f), threadCount(0) {}
+
+    // Collapse corners that repeat the previous corner's position and
+    // remove faces left with fewer than three corners or with an area of
+    // at most minimumArea.
+    bool removeDegenerateFaces;
+
+    // Remove faces of a mesh that use the same positions in the same
+    // winding order as an earlier face of that mesh.
+    bool removeDuplicateFaces;
+
+    // Remove positions, normals and texture coordinates that no face uses
+    // and renumber the faces to match.
+    bool removeUnusedAttributes;
+
+    // Faces with this area or less are degenerate. 0 only removes faces
+    // whose area is exactly zero, such as those with collinear corners.
+    float minimumArea;
+
+    // Maximum worker threads, 0 selects the hardware default.
+    unsigned int threadCount;
+};
+
+/**
+ * Removes degenerate and duplicate faces from meshes, and the attributes
+ * that are left unused, before the meshes are finalised. This saves the
+ * work of finalising and processing geometry that cannot be seen and the
+ * memory it would occupy.
+ */
+class MeshCleaner {
+ public:
+    MeshCleaner();
+
+    explicit MeshCleaner(const MeshCleanupOptions& options);
+
+    bool Clean(Point4DList *positions,
+               Point3DList *normals,
+               TextureCoordinatesList *textureCoordinates,
+               std::vector<Mesh> *meshes);
+
+ private:
+    MeshCleanupOptions options_;
+};
+
+}   // namespace Meshborn
+
+#endif  // MESHCLEANER_H_
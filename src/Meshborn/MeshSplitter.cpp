@@ -0,0 +1,298 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <format>
+#include <utility>
+#include <vector>
+#include "LoggerManager.h"
+#include "MeshSplitter.h"
+#include "Parallel.h"
+
+namespace Meshborn {
+
+namespace {
+
+const uint32_t NO_PART = UINT32_MAX;
+
+/**
+ * A run of faces from one mesh and the vertices they use, as indices into
+ * the mesh's vertex range.
+ */
+struct MeshPart {
+    MeshPart() : faceBegin(0), faceEnd(0) {}
+
+    size_t faceBegin;
+    size_t faceEnd;
+    std::vector<uint32_t> vertices;
+    std::vector<uint16_t> indices;
+};
+
+/**
+ * Partitions the faces of a consolidated mesh into parts that each use at
+ * most maxVertices unique vertices.
+ *
+ * Each face's triangles are added to the open part; if that takes the part
+ * over the limit, the vertices the face introduced are released and the
+ * face starts the next part instead. Faces are never divided, so the
+ * triangles of a face stay together as ray hits and the BVH expect.
+ */
+bool SplitMesh(const Model& model, const Mesh& mesh, size_t maxVertices,
+               std::vector<MeshPart> *parts) {
+    const uint32_t *indices = model.indexBuffer.data() + mesh.indexOffset;
+    size_t triangleCount = 0;
+
+    for (const auto& face : mesh.faces) {
+        if (face.elements.size() >= 3) {
+            triangleCount += face.elements.size() - 2;
+        }
+    }
+
+    if (mesh.indexCount != triangleCount * 3 ||
+        mesh.indexOffset + mesh.indexCount > model.indexBuffer.size() ||
+        mesh.vertexOffset + mesh.vertexCount > model.vertexBuffer.size()) {
+        LOG(Logger::LogLevel::Critical, std::format(
+            "Mesh '{}' does not match its buffer ranges, unable to split it",
+            mesh.name));
+        return false;
+    }
+
+    std::vector<uint32_t> partOf(mesh.vertexCount, NO_PART);
+    std::vector<uint16_t> localIndex(mesh.vertexCount);
+
+    parts->clear();
+    parts->emplace_back();
+
+    size_t triangle = 0;
+
+    for (size_t f = 0; f < mesh.faces.size(); ++f) {
+        const size_t count = mesh.faces[f].elements.size();
+        const size_t faceIndexCount = count >= 3 ? (count - 2) * 3 : 0;
+        const uint32_t *faceIndices = indices + triangle * 3;
+
+        for (int attempt = 0; ; ++attempt) {
+            MeshPart& part = parts->back();
+            const uint32_t partNumber = static_cast<uint32_t>(
+                parts->size() - 1);
+            const size_t previousCount = part.vertices.size();
+
+            for (size_t i = 0; i < faceIndexCount; ++i) {
+                const uint32_t vertex = faceIndices[i];
+
+                if (vertex >= mesh.vertexCount) {
+                    LOG(Logger::LogLevel::Critical, std::format(
+                        "Mesh '{}' has an index outside its vertex range",
+                        mesh.name));
+                    return false;
+                }
+
+                if (partOf[vertex] != partNumber) {
+                    partOf[vertex] = partNumber;
+                    localIndex[vertex] = static_cast<uint16_t>(
+                        part.vertices.size());
+                    part.vertices.push_back(vertex);
+                }
+            }
+
+            if (part.vertices.size() <= maxVertices) {
+                for (size_t i = 0; i < faceIndexCount; ++i) {
+                    part.indices.push_back(localIndex[faceIndices[i]]);
+                }
+                break;
+            }
+
+            if (attempt > 0 || previousCount == 0) {
+                LOG(Logger::LogLevel::Critical, std::format(
+                    "Face {} of mesh '{}' uses more than {} vertices",
+                    f, mesh.name, maxVertices));
+                return false;
+            }
+
+            for (size_t i = previousCount; i < part.vertices.size(); ++i) {
+                partOf[part.vertices[i]] = NO_PART;
+            }
+            part.vertices.resize(previousCount);
+            part.faceEnd = f;
+
+            MeshPart next;
+            next.faceBegin = f;
+            parts->push_back(std::move(next));
+        }
+
+        triangle += faceIndexCount / 3;
+    }
+
+    parts->back().faceEnd = mesh.faces.size();
+    return true;
+}
+
+}   // namespace
+
+MeshSplitter::MeshSplitter() {
+}
+
+MeshSplitter::MeshSplitter(const MeshSplitOptions& options)
+    : options_(options) {
+}
+
+/**
+ * Splits every mesh of a consolidated model so its indices fit 16 bits.
+ *
+ * Meshes are partitioned in parallel, then rebuilt in mesh order with each
+ * part becoming a mesh of its own that shares the original name and
+ * material and holds the faces it covers. The vertex and tangent buffers are
+ * rebuilt to match and the indices are moved to Model::indexBuffer16, with
+ * Model::indexBuffer released. Meshes already within the limit are carried
+ * over as a single part.
+ *
+ * @param model Pointer to a consolidated model to split.
+ * @return true on success, false if the model is not consolidated or a
+ *         single face needs more vertices than the limit.
+ */
+bool MeshSplitter::Split(Model *model) {
+    if (!model || !model->consolidated) {
+        LOG(Logger::LogLevel::Critical,
+            "MeshSplitter requires a consolidated model");
+        return false;
+    }
+
+    if (model->indexFormat == IndexFormat::UINT16) {
+        return true;
+    }
+
+    const size_t maxVertices = std::clamp<size_t>(options_.maxVertices, 3,
+                                                  65536);
+    const size_t meshCount = model->meshes.size();
+    std::vector<std::vector<MeshPart>> parts(meshCount);
+    std::atomic<bool> status = true;
+
+    ParallelFor(meshCount, 1, [&](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; ++m) {
+            if (!SplitMesh(*model, model->meshes[m], maxVertices,
+                           &parts[m])) {
+                status = false;
+            }
+        }
+    }, options_.threadCount);
+
+    if (!status) {
+        return false;
+    }
+
+    // Lay the parts out in mesh order and work out their buffer ranges.
+    struct PartSource {
+        size_t mesh;
+        size_t part;
+    };
+
+    std::vector<PartSource> sources;
+    std::vector<Mesh> meshes;
+    std::vector<size_t> firstParts(meshCount);
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+
+    for (size_t m = 0; m < meshCount; ++m) {
+        firstParts[m] = meshes.size();
+
+        for (size_t p = 0; p < parts[m].size(); ++p) {
+            Mesh submesh;
+            submesh.name = model->meshes[m].name;
+            submesh.material = model->meshes[m].material;
+            submesh.vertexOffset = vertexCount;
+            submesh.vertexCount = parts[m][p].vertices.size();
+            submesh.indexOffset = indexCount;
+            submesh.indexCount = parts[m][p].indices.size();
+
+            vertexCount += submesh.vertexCount;
+            indexCount += submesh.indexCount;
+
+            meshes.push_back(std::move(submesh));
+            sources.push_back({m, p});
+        }
+    }
+
+    std::vector<Vertex> vertexBuffer(vertexCount);
+    std::vector<Point4D> tangentBuffer(
+        model->tangentBuffer.empty() ? 0 : vertexCount);
+    std::vector<uint16_t> indexBuffer16(indexCount);
+
+    ParallelFor(meshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            Mesh& submesh = meshes[i];
+            Mesh& source = model->meshes[sources[i].mesh];
+            const MeshPart& part = parts[sources[i].mesh][sources[i].part];
+
+            for (size_t v = 0; v < part.vertices.size(); ++v) {
+                const size_t from = source.vertexOffset + part.vertices[v];
+                vertexBuffer[submesh.vertexOffset + v] =
+                    model->vertexBuffer[from];
+
+                if (!tangentBuffer.empty()) {
+                    tangentBuffer[submesh.vertexOffset + v] =
+                        model->tangentBuffer[from];
+                }
+            }
+
+            std::copy(part.indices.begin(), part.indices.end(),
+                      indexBuffer16.begin() + submesh.indexOffset);
+
+            submesh.faces.assign(source.faces.begin() + part.faceBegin,
+                                 source.faces.begin() + part.faceEnd);
+
+            const Vertex *first = vertexBuffer.data() + submesh.vertexOffset;
+            submesh.boundingBox = ComputeBoundingBox(first,
+                                                     submesh.vertexCount);
+            submesh.boundingSphere = ComputeBoundingSphere(
+                first, submesh.vertexCount, submesh.boundingBox);
+        }
+    }, options_.threadCount);
+
+    // An instance of a split mesh becomes one instance of each part.
+    std::vector<MeshInstance> instances;
+
+    for (const auto& instance : model->instances) {
+        if (instance.mesh >= meshCount) {
+            instances.push_back(instance);
+            continue;
+        }
+
+        for (size_t p = 0; p < parts[instance.mesh].size(); ++p) {
+            instances.push_back(instance);
+            instances.back().mesh = firstParts[instance.mesh] + p;
+        }
+    }
+
+    LOG(Logger::LogLevel::Debug, std::format(
+        "SPLIT => {} meshes into {}, {} vertices into {}",
+        meshCount, meshes.size(), model->vertexBuffer.size(), vertexCount));
+
+    model->meshes = std::move(meshes);
+    model->instances = std::move(instances);
+    model->totalMeshes = model->meshes.size();
+    model->vertexBuffer = std::move(vertexBuffer);
+    model->tangentBuffer = std::move(tangentBuffer);
+    model->indexBuffer16 = std::move(indexBuffer16);
+    std::vector<uint32_t>().swap(model->indexBuffer);
+    model->indexFormat = IndexFormat::UINT16;
+    model->UpdateBounds();
+
+    return true;
+}
+
+}   // namespace Meshborn
@@ -0,0 +1,60 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef MESHSPLITTER_H_
+#define MESHSPLITTER_H_
+#include "Model.h"
+
+namespace Meshborn {
+
+/**
+ * Settings controlling mesh splitting.
+ */
+struct MeshSplitOptions {
+    MeshSplitOptions() : maxVertices(65535), threadCount(0) {}
+
+    // Maximum unique vertices per submesh. The default leaves index 0xFFFF
+    // free for use as a primitive restart value.
+    unsigned int maxVertices;
+
+    // Maximum worker threads, 0 selects the hardware default.
+    unsigned int threadCount;
+};
+
+/**
+ * Splits the meshes of a consolidated model into submeshes small enough to
+ * be drawn with 16-bit indices.
+ *
+ * Faces are assigned to submeshes greedily in their existing order, so the
+ * triangle order, and with it the vertex cache locality, is unchanged. Only
+ * the vertices shared across a split are duplicated.
+ */
+class MeshSplitter {
+ public:
+    MeshSplitter();
+
+    explicit MeshSplitter(const MeshSplitOptions& options);
+
+    bool Split(Model *model);
+
+ private:
+    MeshSplitOptions options_;
+};
+
+}   // namespace Meshborn
+
+#endif  // MESHSPLITTER_H_
@@ -25,7 +25,9 @@ namespace Meshborn {
  *
  * Transfers ownership of the provided logger to the LoggerManager singleton,
  * replacing any existing logger. This allows centralized control over
- * logging behavior throughout the application.
+ * logging behavior throughout the application. The previous logger is
+ * destroyed once no thread is still logging to it; the call waits for that,
+ * so it must not be made from inside a logger's Log().
  *
  * @param logger A unique pointer to a new ILogger implementation.
  */
@@ -33,4 +35,26 @@ void SetLogger(std::unique_ptr<Logger::ILogger> logger) {
     Logger::LoggerManager::Instance().SetLogger(std::move(logger));
 }
 
+/**
+ * Sets the lowest level that is passed to the logger.
+ *
+ * Messages below the level are discarded before they are formatted. Debug
+ * messages also need the library built with MESHBORN_LOG_DEBUG, as they are
+ * otherwise compiled out.
+ *
+ * @param level The lowest level to log.
+ */
+void SetLogLevel(Logger::LogLevel level) {
+    Logger::LoggerManager::Instance().SetLevel(level);
+}
+
+/**
+ * Gets the lowest level that is passed to the logger.
+ *
+ * @return The current log level threshold.
+ */
+Logger::LogLevel GetLogLevel() {
+    return Logger::LoggerManager::Instance().GetLevel();
+}
+
 }   // namespace Meshborn
@@ -25,6 +25,10 @@ namespace Meshborn {
 
 void SetLogger(std::unique_ptr<Logger::ILogger> logger);
 
+void SetLogLevel(Logger::LogLevel level);
+
+Logger::LogLevel GetLogLevel();
+
 }   // namespace Meshborn
 
 #endif  //  MESHBORN_H_
@@ -0,0 +1,307 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include "Model.h"
+#include "StringMemory.h"
+
+namespace Meshborn {
+
+MeshInstance::MeshInstance() : mesh(0) {
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            transform[row][column] = row == column ? 1.0f : 0.0f;
+        }
+    }
+}
+
+Point3D MeshInstance::TransformPoint(const Point3D& point) const {
+    const Point3D rotated = TransformDirection(point);
+    return Point3D(rotated.x + transform[0][3],
+                   rotated.y + transform[1][3],
+                   rotated.z + transform[2][3]);
+}
+
+Point3D MeshInstance::TransformDirection(const Point3D& direction) const {
+    return Point3D(
+        transform[0][0] * direction.x + transform[0][1] * direction.y +
+            transform[0][2] * direction.z,
+        transform[1][0] * direction.x + transform[1][1] * direction.y +
+            transform[1][2] * direction.z,
+        transform[2][0] * direction.x + transform[2][1] * direction.y +
+            transform[2][2] * direction.z);
+}
+
+/**
+ * @brief Bounds of a mesh placed by an instance transform.
+ *
+ * The box encloses the eight transformed corners of the mesh box. The
+ * transform is rigid, so the sphere keeps its radius.
+ */
+static void GetInstanceBounds(const MeshInstance& instance, const Mesh& mesh,
+                              AxisAlignedBoundingBox *box,
+                              BoundingSphere *sphere) {
+    *box = AxisAlignedBoundingBox();
+    *sphere = BoundingSphere();
+
+    if (mesh.boundingBox.IsEmpty()) {
+        return;
+    }
+
+    const Point3D& low = mesh.boundingBox.min;
+    const Point3D& high = mesh.boundingBox.max;
+
+    for (int corner = 0; corner < 8; ++corner) {
+        const Point3D point = instance.TransformPoint(Point3D(
+            corner & 1 ? high.x : low.x,
+            corner & 2 ? high.y : low.y,
+            corner & 4 ? high.z : low.z));
+
+        AxisAlignedBoundingBox pointBox;
+        pointBox.min = point;
+        pointBox.max = point;
+        box->Merge(pointBox);
+    }
+
+    if (!mesh.boundingSphere.IsEmpty()) {
+        sphere->centre = instance.TransformPoint(mesh.boundingSphere.centre);
+        sphere->radius = mesh.boundingSphere.radius;
+    }
+}
+
+/**
+ * @brief Recomputes the model bounds from the bounds of its meshes and
+ * instances.
+ *
+ * The bounding box is the union of the mesh boxes. The bounding sphere is
+ * centred on that box and, for each mesh, grown to the smaller of two
+ * conservative limits: the far side of the mesh sphere and the furthest
+ * corner of the mesh box. No vertices are visited, so this is cheap to call
+ * once the meshes have been finalised.
+ */
+void Model::UpdateBounds() {
+    boundingBox = AxisAlignedBoundingBox();
+    boundingSphere = BoundingSphere();
+
+    std::vector<AxisAlignedBoundingBox> boxes;
+    std::vector<BoundingSphere> spheres;
+    boxes.reserve(meshes.size() + instances.size());
+    spheres.reserve(meshes.size() + instances.size());
+
+    for (const auto& mesh : meshes) {
+        boxes.push_back(mesh.boundingBox);
+        spheres.push_back(mesh.boundingSphere);
+    }
+
+    for (const auto& instance : instances) {
+        if (instance.mesh >= meshes.size()) {
+            continue;
+        }
+
+        AxisAlignedBoundingBox box;
+        BoundingSphere sphere;
+        GetInstanceBounds(instance, meshes[instance.mesh], &box, &sphere);
+        boxes.push_back(box);
+        spheres.push_back(sphere);
+    }
+
+    for (const auto& box : boxes) {
+        boundingBox.Merge(box);
+    }
+
+    if (boundingBox.IsEmpty()) {
+        return;
+    }
+
+    const Point3D centre = boundingBox.Centre();
+    float radius = 0.0f;
+
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        if (boxes[i].IsEmpty()) {
+            continue;
+        }
+
+        const AxisAlignedBoundingBox& box = boxes[i];
+        float dx = std::max(std::fabs(box.min.x - centre.x),
+                            std::fabs(box.max.x - centre.x));
+        float dy = std::max(std::fabs(box.min.y - centre.y),
+                            std::fabs(box.max.y - centre.y));
+        float dz = std::max(std::fabs(box.min.z - centre.z),
+                            std::fabs(box.max.z - centre.z));
+        float limit = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+        if (!spheres[i].IsEmpty()) {
+            const BoundingSphere& sphere = spheres[i];
+            float sx = sphere.centre.x - centre.x;
+            float sy = sphere.centre.y - centre.y;
+            float sz = sphere.centre.z - centre.z;
+            limit = std::min(limit, std::sqrt(sx * sx + sy * sy + sz * sz) +
+                                    sphere.radius);
+        }
+
+        radius = std::max(radius, limit);
+    }
+
+    boundingSphere.centre = centre;
+    boundingSphere.radius = radius;
+}
+
+MemoryUsage& MemoryUsage::operator+=(const MemoryUsage& other) {
+    usedBytes += other.usedBytes;
+    reservedBytes += other.reservedBytes;
+    return *this;
+}
+
+MemoryUsage ModelMemoryUsage::GetTotal() const {
+    MemoryUsage total;
+    total += meshes;
+    total += faces;
+    total += vertices;
+    total += buffers;
+    total += strings;
+    total += materials;
+    total += instances;
+    return total;
+}
+
+/**
+ * @brief Adds the heap storage of a vector's elements.
+ */
+template <typename T>
+static void AddVector(const std::vector<T>& values, MemoryUsage *usage) {
+    usage->usedBytes += values.size() * sizeof(T);
+    usage->reservedBytes += values.capacity() * sizeof(T);
+}
+
+/**
+ * @brief Adds the heap storage of a string, if it is too long to be held
+ * inside the string object itself.
+ */
+static void AddString(const std::string& value, MemoryUsage *usage) {
+    const size_t heapBytes = GetStringHeapBytes(value);
+
+    if (heapBytes == 0) {
+        return;
+    }
+
+    usage->usedBytes += value.size() + 1;
+    usage->reservedBytes += heapBytes;
+}
+
+/**
+ * @brief Measures the memory held by the model, by category.
+ *
+ * Walks every mesh, face, vertex buffer, string and material, so the cost
+ * is proportional to the number of faces. Used bytes count the elements in
+ * use; reserved bytes add the spare capacity that Compact() releases.
+ *
+ * @return The used and reserved bytes of each category.
+ */
+ModelMemoryUsage Model::GetMemoryUsage() const {
+    ModelMemoryUsage usage;
+
+    usage.meshes.usedBytes = sizeof(Model) + meshes.size() * sizeof(Mesh);
+    usage.meshes.reservedBytes = sizeof(Model) +
+                                 meshes.capacity() * sizeof(Mesh);
+
+    for (const auto& mesh : meshes) {
+        AddString(mesh.name, &usage.strings);
+        AddString(mesh.material, &usage.strings);
+        AddVector(mesh.faces, &usage.faces);
+
+        for (const auto& face : mesh.faces) {
+            AddVector(face.elements, &usage.faces);
+        }
+
+        AddVector(mesh.vertices, &usage.vertices);
+        AddVector(mesh.tangents, &usage.vertices);
+    }
+
+    AddVector(vertexBuffer, &usage.buffers);
+    AddVector(tangentBuffer, &usage.buffers);
+    AddVector(indexBuffer, &usage.buffers);
+    AddVector(indexBuffer16, &usage.buffers);
+
+    AddVector(instances, &usage.instances);
+
+    for (const auto& instance : instances) {
+        AddString(instance.name, &usage.strings);
+        AddString(instance.material, &usage.strings);
+    }
+
+    // Each map node holds the key, the shared pointer, a next pointer and
+    // the cached hash; each material also shares its shared_ptr control
+    // block allocation with make_shared.
+    const size_t nodeBytes = sizeof(MaterialMap::value_type) +
+                             2 * sizeof(void *);
+    const size_t bucketBytes = materials.bucket_count() * sizeof(void *);
+    usage.materials.usedBytes = bucketBytes;
+
+    for (const auto& [name, material] : materials) {
+        AddString(name, &usage.strings);
+
+        const size_t materialBytes = nodeBytes + 2 * sizeof(long) +
+            (material ? material->GetMemoryUsage() : 0);
+        usage.materials.usedBytes += materialBytes;
+    }
+
+    usage.materials.reservedBytes = usage.materials.usedBytes;
+    return usage;
+}
+
+/**
+ * @brief Releases spare capacity left in the model's vectors and strings.
+ *
+ * Faces and vertices are appended one at a time while a file is parsed
+ * and finalised, so their vectors typically hold up to twice the memory
+ * they need. Compacting reallocates each vector to its size, briefly
+ * needing both copies of the largest one. Element addresses change, but
+ * indices into the vectors remain valid.
+ */
+void Model::Compact() {
+    meshes.shrink_to_fit();
+
+    for (auto& mesh : meshes) {
+        mesh.name.shrink_to_fit();
+        mesh.material.shrink_to_fit();
+        mesh.faces.shrink_to_fit();
+
+        for (auto& face : mesh.faces) {
+            face.elements.shrink_to_fit();
+        }
+
+        mesh.vertices.shrink_to_fit();
+        mesh.tangents.shrink_to_fit();
+    }
+
+    vertexBuffer.shrink_to_fit();
+    tangentBuffer.shrink_to_fit();
+    indexBuffer.shrink_to_fit();
+    indexBuffer16.shrink_to_fit();
+    instances.shrink_to_fit();
+
+    for (auto& instance : instances) {
+        instance.name.shrink_to_fit();
+        instance.material.shrink_to_fit();
+    }
+
+    materials.rehash(0);
+}
+
+}   // namespace Meshborn
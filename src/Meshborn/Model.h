@@ -17,13 +17,140 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #ifndef MODEL_H_
 #define MODEL_H_
+#include <cstdint>
 #include <map>
+#include <string>
 #include <vector>
+#include "BoundingVolume.h"
 #include "Material.h"
 #include "Mesh.h"
 
 namespace Meshborn {
 
+/**
+ * @brief Width of the indices in a consolidated model.
+ */
+enum class IndexFormat {
+    // Indices are held in Model::indexBuffer.
+    UINT32,
+
+    // Indices are held in Model::indexBuffer16, see MeshSplitter.
+    UINT16
+};
+
+/**
+ * @brief A placement of a mesh shared with other parts of the model.
+ *
+ * Instances are created by InstanceDetector for meshes whose geometry
+ * duplicates an earlier mesh, which is kept in Model::meshes and drawn in
+ * place as usual.
+ */
+struct MeshInstance {
+    MeshInstance();
+
+    /**
+     * @brief Name of the duplicate mesh this instance replaces.
+     */
+    std::string name;
+
+    /**
+     * @brief Material of the duplicate, which may differ from the shared
+     * mesh's material.
+     */
+    std::string material;
+
+    /**
+     * @brief Index of the shared mesh in Model::meshes.
+     */
+    size_t mesh;
+
+    /**
+     * @brief Rigid transform from the shared mesh to the instance, as the
+     * rows of a 3x4 matrix: p' = R p + t with t in the last column.
+     */
+    float transform[3][4];
+
+    /**
+     * @brief Applies the transform to a point.
+     */
+    Point3D TransformPoint(const Point3D& point) const;
+
+    /**
+     * @brief Applies the rotation part of the transform to a direction.
+     */
+    Point3D TransformDirection(const Point3D& direction) const;
+};
+
+/**
+ * @brief Bytes held by one category of a model's data.
+ */
+struct MemoryUsage {
+    MemoryUsage() : usedBytes(0), reservedBytes(0) {}
+
+    MemoryUsage& operator+=(const MemoryUsage& other);
+
+    /**
+     * @brief Bytes of the elements in use.
+     */
+    size_t usedBytes;
+
+    /**
+     * @brief Bytes allocated, including spare vector and string capacity.
+     * Always at least usedBytes.
+     */
+    size_t reservedBytes;
+};
+
+/**
+ * @brief Memory held by a model, by category, see Model::GetMemoryUsage().
+ *
+ * Each category counts the objects it holds and the heap memory they own.
+ * Allocator overheads are not known, so the figures are lower bounds, and
+ * material map nodes are estimated.
+ */
+struct ModelMemoryUsage {
+    /**
+     * @brief The Mesh objects in Model::meshes.
+     */
+    MemoryUsage meshes;
+
+    /**
+     * @brief Faces and their corner elements.
+     */
+    MemoryUsage faces;
+
+    /**
+     * @brief Per-mesh vertices and tangents.
+     */
+    MemoryUsage vertices;
+
+    /**
+     * @brief The model's shared vertex, tangent and index buffers.
+     */
+    MemoryUsage buffers;
+
+    /**
+     * @brief Heap storage of mesh and instance names and material names.
+     */
+    MemoryUsage strings;
+
+    /**
+     * @brief Materials and the map holding them.
+     */
+    MemoryUsage materials;
+
+    /**
+     * @brief Instance placements of shared meshes; their names are counted
+     * in strings.
+     */
+    MemoryUsage instances;
+
+    /**
+     * @brief Sum of every category.
+     */
+    MemoryUsage GetTotal() const;
+};
+
 /**
  * @class Model
  * @brief Represents a 3D model composed of multiple meshes and materials.
@@ -38,10 +165,31 @@ class Model {
     /**
     * @brief Constructs an empty Model with zero meshes and materials.
     */
-    Model() : totalMeshes(0), totalMaterials(0) {}
+    Model() : totalMeshes(0), totalMaterials(0), consolidated(false),
+              indexFormat(IndexFormat::UINT32) {}
+
+    /**
+    * @brief Recomputes the model bounds from the bounds of its meshes and
+    * instances.
+    */
+    void UpdateBounds();
+
+    /**
+     * @brief Measures the memory held by the model, by category.
+     */
+    ModelMemoryUsage GetMemoryUsage() const;
+
+    /**
+     * @brief Releases spare capacity left in the model's vectors and
+     * strings by loading and processing.
+     */
+    void Compact();
 
     /**
      * @brief A list of meshes that make up the model.
+     *
+     * Meshes are drawn in place; further copies of a mesh may be listed in
+     * instances.
      */
     std::vector<Mesh> meshes;
 
@@ -67,6 +215,56 @@ class Model {
      * for external tracking.
      */
     size_t totalMaterials;
+
+    /**
+     * @brief Bounding box enclosing every mesh in the model.
+     */
+    AxisAlignedBoundingBox boundingBox;
+
+    /**
+     * @brief Bounding sphere enclosing every mesh in the model.
+     */
+    BoundingSphere boundingSphere;
+
+    /**
+     * @brief True once the mesh vertices have been moved into the shared
+     * buffers below by a BufferConsolidator.
+     */
+    bool consolidated;
+
+    /**
+     * @brief Vertices of every mesh, each mesh owning a contiguous range.
+     */
+    std::vector<Vertex> vertexBuffer;
+
+    /**
+     * @brief Optional tangents parallel to vertexBuffer.
+     *
+     * Empty unless a mesh had tangents when the model was consolidated.
+     */
+    std::vector<Point4D> tangentBuffer;
+
+    /**
+     * @brief Triangle list indices of every mesh, relative to the vertex
+     * offset of the mesh that owns them.
+     */
+    std::vector<uint32_t> indexBuffer;
+
+    /**
+     * @brief Which of the index buffers holds the mesh index ranges.
+     */
+    IndexFormat indexFormat;
+
+    /**
+     * @brief 16-bit triangle list indices, used in place of indexBuffer
+     * once every mesh has been split to fit them.
+     */
+    std::vector<uint16_t> indexBuffer16;
+
+    /**
+     * @brief Placements of shared meshes, see InstanceDetector.
+     */
+    std::vector<MeshInstance> instances;
 };
 
 }   // namespace Meshborn
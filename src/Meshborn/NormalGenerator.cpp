@@ -0,0 +1,377 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <numbers>
+#include <vector>
+#include "LoggerManager.h"
+#include "NormalGenerator.h"
+#include "Parallel.h"
+
+namespace Meshborn {
+
+// Number of faces or corners handed to a worker thread in one chunk. Meshes
+// smaller than this are processed inline, several meshes at a time.
+const size_t NORMAL_GRAIN_SIZE = 4096;
+
+NormalGenerator::NormalGenerator() {
+}
+
+NormalGenerator::NormalGenerator(const NormalGenerationOptions& options)
+    : options_(options) {
+}
+
+/**
+ * Generates normals for every mesh in a model.
+ *
+ * Small meshes are spread across worker threads a mesh at a time, while large
+ * meshes are processed one after another with their faces and corners split
+ * across the worker threads instead.
+ *
+ * @param model Pointer to the model whose meshes are updated.
+ * @return true on success, false if any mesh could not be processed.
+ */
+bool NormalGenerator::Generate(Model *model) {
+    if (!model) {
+        LOG(Logger::LogLevel::Critical,
+            "Invalid model passed to NormalGenerator");
+        return false;
+    }
+
+    std::vector<Mesh *> smallMeshes;
+    std::vector<Mesh *> largeMeshes;
+
+    for (auto& mesh : model->meshes) {
+        if (mesh.vertices.size() < NORMAL_GRAIN_SIZE) {
+            smallMeshes.push_back(&mesh);
+        } else {
+            largeMeshes.push_back(&mesh);
+        }
+    }
+
+    std::atomic<bool> status = true;
+
+    ParallelFor(smallMeshes.size(), 16, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (!Generate(smallMeshes[i])) {
+                status = false;
+            }
+        }
+    }, options_.threadCount);
+
+    for (auto mesh : largeMeshes) {
+        if (!Generate(mesh)) {
+            status = false;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * Generates normals for a single finalised mesh.
+ *
+ * Face normals are found with Newell's method so that quads and n-gons are
+ * handled as well as triangles. Face corners are then bucketed by their
+ * position index and each corner missing a normal sums the weighted normals
+ * of the faces in its bucket that pass the smoothing group and crease angle
+ * tests. Face data is kept in separate arrays per component so that the
+ * per-face and per-corner loops can be vectorised by the compiler.
+ *
+ * @param mesh Pointer to the mesh to update; its vertices must have been
+ *             finalised from its faces.
+ * @return true on success, false if the mesh is invalid.
+ */
+bool NormalGenerator::Generate(Mesh *mesh) {
+    if (!mesh) {
+        LOG(Logger::LogLevel::Critical,
+            "Invalid mesh passed to NormalGenerator");
+        return false;
+    }
+
+    const auto& faces = mesh->faces;
+    auto& vertices = mesh->vertices;
+    const size_t faceCount = faces.size();
+
+    // Offset of the first corner of each face within the vertex list.
+    std::vector<size_t> faceOffsets(faceCount + 1, 0);
+    bool usesSmoothingGroups = false;
+
+    for (size_t f = 0; f < faceCount; ++f) {
+        faceOffsets[f + 1] = faceOffsets[f] + faces[f].elements.size();
+        usesSmoothingGroups |= faces[f].smoothingGroup != 0;
+    }
+
+    const size_t cornerCount = faceOffsets.back();
+
+    if (cornerCount != vertices.size()) {
+        LOG(Logger::LogLevel::Critical, std::format(
+            "Mesh '{}' has not been finalised, unable to generate normals",
+            mesh->name));
+        return false;
+    }
+
+    if (cornerCount == 0) {
+        return true;
+    }
+
+    std::vector<float> faceNormalX(faceCount);
+    std::vector<float> faceNormalY(faceCount);
+    std::vector<float> faceNormalZ(faceCount);
+    std::vector<float> faceArea(faceCount);
+
+    std::vector<uint32_t> cornerFace(cornerCount);
+    std::vector<float> cornerWeight(cornerCount);
+    std::vector<uint8_t> cornerMissing(cornerCount);
+    std::vector<uint64_t> cornerKeys(cornerCount);
+
+    std::atomic<bool> missingNormals = false;
+
+    ParallelFor(faceCount, NORMAL_GRAIN_SIZE, [&](size_t begin, size_t end) {
+        bool missing = false;
+
+        for (size_t f = begin; f < end; ++f) {
+            const size_t first = faceOffsets[f];
+            const size_t count = faceOffsets[f + 1] - first;
+
+            float nx = 0.0f;
+            float ny = 0.0f;
+            float nz = 0.0f;
+
+            for (size_t i = 0; i < count; ++i) {
+                const Point4D& a = vertices[first + i].position;
+                const Point4D& b = vertices[first + (i + 1) % count].position;
+
+                nx += (a.y - b.y) * (a.z + b.z);
+                ny += (a.z - b.z) * (a.x + b.x);
+                nz += (a.x - b.x) * (a.y + b.y);
+            }
+
+            // Newell's method yields a vector twice the face area in length.
+            float length = std::sqrt(nx * nx + ny * ny + nz * nz);
+            float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+
+            faceNormalX[f] = nx * inverse;
+            faceNormalY[f] = ny * inverse;
+            faceNormalZ[f] = nz * inverse;
+            faceArea[f] = 0.5f * length;
+
+            for (size_t i = 0; i < count; ++i) {
+                const size_t corner = first + i;
+                const PolygonalFaceElement& element = faces[f].elements[i];
+                const Point3D& normal = vertices[corner].normal;
+
+                cornerFace[corner] = static_cast<uint32_t>(f);
+                cornerKeys[corner] =
+                    (static_cast<uint64_t>(
+                        static_cast<uint32_t>(element.vertex)) << 32) |
+                    static_cast<uint64_t>(corner);
+
+                cornerMissing[corner] = options_.overwriteExisting ||
+                    element.normal < 1 ||
+                    (normal.x == 0.0f && normal.y == 0.0f &&
+                     normal.z == 0.0f);
+                missing |= cornerMissing[corner] != 0;
+
+                if (options_.weighting == NormalWeighting::AREA) {
+                    cornerWeight[corner] = faceArea[f];
+                    continue;
+                }
+
+                const Point4D& previous =
+                    vertices[first + (i + count - 1) % count].position;
+                const Point4D& current = vertices[corner].position;
+                const Point4D& next = vertices[first + (i + 1) % count].position;
+
+                float ax = previous.x - current.x;
+                float ay = previous.y - current.y;
+                float az = previous.z - current.z;
+                float bx = next.x - current.x;
+                float by = next.y - current.y;
+                float bz = next.z - current.z;
+
+                float cx = ay * bz - az * by;
+                float cy = az * bx - ax * bz;
+                float cz = ax * by - ay * bx;
+
+                cornerWeight[corner] = std::atan2(
+                    std::sqrt(cx * cx + cy * cy + cz * cz),
+                    ax * bx + ay * by + az * bz);
+            }
+        }
+
+        if (missing) {
+            missingNormals = true;
+        }
+    }, options_.threadCount);
+
+    if (!missingNormals) {
+        return true;
+    }
+
+    // Group the corners that share a position index.
+    std::sort(cornerKeys.begin(), cornerKeys.end());
+
+    std::vector<size_t> bucketStarts;
+    for (size_t i = 0; i < cornerCount; ++i) {
+        if (i == 0 || (cornerKeys[i] >> 32) != (cornerKeys[i - 1] >> 32)) {
+            bucketStarts.push_back(i);
+        }
+    }
+    bucketStarts.push_back(cornerCount);
+
+    const float creaseAngle = std::clamp(options_.creaseAngle, 0.0f, 180.0f);
+    const bool testCrease = creaseAngle < 180.0f;
+    const float cosCrease = std::cos(creaseAngle *
+                                     std::numbers::pi_v<float> / 180.0f);
+    const bool splitByGroup = options_.honourSmoothingGroups &&
+                              usesSmoothingGroups;
+
+    ParallelFor(bucketStarts.size() - 1, NORMAL_GRAIN_SIZE,
+        [&](size_t begin, size_t end) {
+        // Corners of a bucket keyed by smoothing group in the high bits, so
+        // that sorting gathers each group into a run.
+        std::vector<uint64_t> members;
+
+        auto setNormal = [&](size_t corner, float nx, float ny, float nz) {
+            const uint32_t face = cornerFace[corner];
+            float length = std::sqrt(nx * nx + ny * ny + nz * nz);
+
+            // Fall back to the face normal if the contributions cancel.
+            if (length > 0.0f) {
+                vertices[corner].normal = Point3D(nx / length,
+                                                  ny / length,
+                                                  nz / length);
+            } else {
+                vertices[corner].normal = Point3D(faceNormalX[face],
+                                                  faceNormalY[face],
+                                                  faceNormalZ[face]);
+            }
+        };
+
+        for (size_t bucket = begin; bucket < end; ++bucket) {
+            const size_t first = bucketStarts[bucket];
+            const size_t last = bucketStarts[bucket + 1];
+
+            members.clear();
+            for (size_t i = first; i < last; ++i) {
+                const uint32_t corner = static_cast<uint32_t>(cornerKeys[i]);
+                const uint64_t group = splitByGroup ?
+                    faces[cornerFace[corner]].smoothingGroup : 0;
+                members.push_back((group << 32) | corner);
+            }
+
+            std::sort(members.begin(), members.end());
+
+            for (size_t runStart = 0; runStart < members.size();) {
+                const uint64_t group = members[runStart] >> 32;
+                size_t runEnd = runStart + 1;
+
+                while (runEnd < members.size() &&
+                       (members[runEnd] >> 32) == group) {
+                    ++runEnd;
+                }
+
+                // Faces with smoothing switched off keep their face normal.
+                if (splitByGroup && group == 0) {
+                    for (size_t i = runStart; i < runEnd; ++i) {
+                        const size_t corner =
+                            static_cast<uint32_t>(members[i]);
+                        const uint32_t face = cornerFace[corner];
+
+                        if (cornerMissing[corner]) {
+                            setNormal(corner, faceNormalX[face],
+                                      faceNormalY[face], faceNormalZ[face]);
+                        }
+                    }
+                } else if (!testCrease) {
+                    // Every corner of the group gets the same sum, so it is
+                    // built once rather than per corner.
+                    float nx = 0.0f;
+                    float ny = 0.0f;
+                    float nz = 0.0f;
+
+                    for (size_t i = runStart; i < runEnd; ++i) {
+                        const size_t other =
+                            static_cast<uint32_t>(members[i]);
+                        const uint32_t otherFace = cornerFace[other];
+
+                        nx += cornerWeight[other] * faceNormalX[otherFace];
+                        ny += cornerWeight[other] * faceNormalY[otherFace];
+                        nz += cornerWeight[other] * faceNormalZ[otherFace];
+                    }
+
+                    for (size_t i = runStart; i < runEnd; ++i) {
+                        const size_t corner =
+                            static_cast<uint32_t>(members[i]);
+
+                        if (cornerMissing[corner]) {
+                            setNormal(corner, nx, ny, nz);
+                        }
+                    }
+                } else {
+                    // The crease test depends on both faces of a pair, so
+                    // each corner sums the rest of its group itself.
+                    for (size_t i = runStart; i < runEnd; ++i) {
+                        const size_t corner =
+                            static_cast<uint32_t>(members[i]);
+                        if (!cornerMissing[corner]) {
+                            continue;
+                        }
+
+                        const uint32_t face = cornerFace[corner];
+                        float nx = 0.0f;
+                        float ny = 0.0f;
+                        float nz = 0.0f;
+
+                        for (size_t j = runStart; j < runEnd; ++j) {
+                            const size_t other =
+                                static_cast<uint32_t>(members[j]);
+                            const uint32_t otherFace = cornerFace[other];
+
+                            if (faceNormalX[face] * faceNormalX[otherFace] +
+                                faceNormalY[face] * faceNormalY[otherFace] +
+                                faceNormalZ[face] * faceNormalZ[otherFace] <
+                                cosCrease) {
+                                continue;
+                            }
+
+                            nx += cornerWeight[other] *
+                                  faceNormalX[otherFace];
+                            ny += cornerWeight[other] *
+                                  faceNormalY[otherFace];
+                            nz += cornerWeight[other] *
+                                  faceNormalZ[otherFace];
+                        }
+
+                        setNormal(corner, nx, ny, nz);
+                    }
+                }
+
+                runStart = runEnd;
+            }
+        }
+    }, options_.threadCount);
+
+    return true;
+}
+
+}   // namespace Meshborn
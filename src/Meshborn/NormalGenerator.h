@@ -0,0 +1,83 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef NORMALGENERATOR_H_
+#define NORMALGENERATOR_H_
+#include "Mesh.h"
+#include "Model.h"
+
+namespace Meshborn {
+
+enum class NormalWeighting {
+    // Each face contributes in proportion to its area.
+    AREA,
+
+    // Each face contributes in proportion to the angle of the face corner
+    // at the vertex, which is independent of how the surface is tessellated.
+    ANGLE
+};
+
+/**
+ * Settings controlling how smooth vertex normals are generated.
+ */
+struct NormalGenerationOptions {
+    NormalGenerationOptions() : weighting(NormalWeighting::ANGLE),
+                                creaseAngle(180.0f),
+                                honourSmoothingGroups(true),
+                                overwriteExisting(false),
+                                threadCount(0) {}
+
+    NormalWeighting weighting;
+
+    // Faces meeting at an angle (in degrees) greater than this are not
+    // smoothed together. 180 disables the crease test.
+    float creaseAngle;
+
+    // Only smooth faces that share an 's' smoothing group. Meshes that never
+    // use smoothing groups are treated as one smoothing group.
+    bool honourSmoothingGroups;
+
+    // Replace normals that came from 'vn' records as well as missing ones.
+    bool overwriteExisting;
+
+    // Maximum worker threads, 0 selects the hardware default.
+    unsigned int threadCount;
+};
+
+/**
+ * Generates smooth vertex normals for face corners that have no 'vn' normal.
+ *
+ * Corners sharing a position are smoothed together when their faces are in
+ * the same smoothing group and meet within the crease angle.
+ */
+class NormalGenerator {
+ public:
+    NormalGenerator();
+
+    explicit NormalGenerator(const NormalGenerationOptions& options);
+
+    bool Generate(Model *model);
+
+    bool Generate(Mesh *mesh);
+
+ private:
+    NormalGenerationOptions options_;
+};
+
+}   // namespace Meshborn
+
+#endif  // NORMALGENERATOR_H_
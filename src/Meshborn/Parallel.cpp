@@ -0,0 +1,153 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <exception>
+#include <thread>   // NOLINT
+#include <vector>
+#include "LoggerManager.h"
+#include "Parallel.h"
+#include "TraceRecorder.h"
+
+namespace Meshborn {
+
+namespace {
+
+/**
+ * Joins every worker that is still running when it goes out of scope, so
+ * that an exception thrown while starting the workers or running the
+ * calling thread's chunk does not destroy a joinable thread, which would
+ * end the process.
+ */
+class WorkerJoinGuard {
+ public:
+    explicit WorkerJoinGuard(std::vector<std::thread> *workers)
+        : workers_(workers) {}
+
+    ~WorkerJoinGuard() {
+        JoinAll();
+    }
+
+    void JoinAll() {
+        for (auto& worker : *workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    WorkerJoinGuard(const WorkerJoinGuard&) = delete;
+    WorkerJoinGuard& operator=(const WorkerJoinGuard&) = delete;
+
+ private:
+    std::vector<std::thread> *workers_;
+};
+
+}   // namespace
+
+/**
+ * Returns the number of worker threads to use for a parallel operation.
+ *
+ * When no explicit count is requested the hardware concurrency is used. As
+ * std::thread::hardware_concurrency() may report 0 when it cannot be
+ * determined, the result is clamped to at least one thread.
+ *
+ * @param requested Requested thread count, 0 selects the hardware default.
+ * @return The number of threads to use, always at least 1.
+ */
+unsigned int ResolveThreadCount(unsigned int requested) {
+    if (requested) {
+        return requested;
+    }
+
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * Runs a body over the half-open range [0, count) split into contiguous
+ * chunks, one per worker thread.
+ *
+ * The calling thread processes the final chunk itself and then joins the
+ * workers, so the function only returns once every chunk has completed.
+ * Workers log to the calling thread's logger, if it has its own.
+ *
+ * An exception thrown by the body, on any thread, is rethrown to the
+ * caller once every chunk has finished; when several chunks throw, the
+ * one from the lowest chunk is kept. The workers are also joined if
+ * starting one of them fails.
+ *
+ * @param count Number of items in the range.
+ * @param grainSize Minimum number of items given to a single chunk.
+ * @param body Function called with the [begin, end) of each chunk.
+ * @param threadCount Maximum number of threads, 0 selects the default.
+ */
+void ParallelFor(size_t count,
+                 size_t grainSize,
+                 const std::function<void(size_t begin, size_t end)>& body,
+                 unsigned int threadCount) {
+    if (count == 0) {
+        return;
+    }
+
+    grainSize = std::max<size_t>(1, grainSize);
+    size_t chunks = std::min<size_t>(ResolveThreadCount(threadCount),
+                                     (count + grainSize - 1) / grainSize);
+
+    if (chunks <= 1) {
+        body(0, count);
+        return;
+    }
+
+    size_t chunkSize = (count + chunks - 1) / chunks;
+    std::vector<std::thread> workers;
+    workers.reserve(chunks - 1);
+
+    // One slot per chunk, each written only by the thread running it.
+    std::vector<std::exception_ptr> errors(chunks);
+    Logger::ILogger *logger = Logger::LoggerManager::GetThreadLogger();
+
+    auto runChunk = [&body, &errors, logger](size_t chunk, size_t begin,
+                                             size_t end) {
+        Logger::ScopedThreadLogger scopedLogger(logger);
+        TRACE_SCOPE("ParallelChunk", "parallel");
+
+        try {
+            body(begin, end);
+        }
+        catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+
+    WorkerJoinGuard joinGuard(&workers);
+
+    for (size_t begin = 0; begin + chunkSize < count; begin += chunkSize) {
+        workers.emplace_back(runChunk, workers.size(), begin,
+                             begin + chunkSize);
+    }
+
+    runChunk(workers.size(), workers.size() * chunkSize, count);
+    joinGuard.JoinAll();
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}   // namespace Meshborn
@@ -0,0 +1,52 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+#include <cstddef>
+#include <functional>
+
+namespace Meshborn {
+
+/**
+ * Returns the number of worker threads to use for a parallel operation.
+ *
+ * @param requested Requested thread count, 0 selects the hardware default.
+ * @return The number of threads to use, always at least 1.
+ */
+unsigned int ResolveThreadCount(unsigned int requested);
+
+/**
+ * Runs a body over the half-open range [0, count) split into contiguous
+ * chunks, one per worker thread.
+ *
+ * Ranges smaller than the grain size are run inline on the calling thread,
+ * so it is cheap to call on the many small meshes found in typical files.
+ *
+ * @param count Number of items in the range.
+ * @param grainSize Minimum number of items given to a single chunk.
+ * @param body Function called with the [begin, end) of each chunk.
+ * @param threadCount Maximum number of threads, 0 selects the default.
+ */
+void ParallelFor(size_t count,
+                 size_t grainSize,
+                 const std::function<void(size_t begin, size_t end)>& body,
+                 unsigned int threadCount = 0);
+
+}   // namespace Meshborn
+
+#endif  // PARALLEL_H_
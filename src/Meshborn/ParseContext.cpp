@@ -0,0 +1,94 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "ParseContext.h"
+#include "StringMemory.h"
+
+namespace Meshborn {
+
+namespace {
+
+size_t GetLinesBytes(const std::vector<std::string>& lines) {
+    size_t bytes = lines.capacity() * sizeof(std::string);
+
+    for (const auto& line : lines) {
+        bytes += GetStringHeapBytes(line);
+    }
+
+    return bytes;
+}
+
+// Estimate of the bytes held by a node-based hash table: its bucket array
+// and one node, holding the value and a next pointer, per entry.
+template<typename Map>
+size_t GetMapBytes(const Map& map) {
+    return map.bucket_count() * sizeof(void *) +
+           map.size() * (sizeof(typename Map::value_type) + sizeof(void *));
+}
+
+}   // namespace
+
+/**
+ * Empties the buffers for the next file, keeping their memory.
+ *
+ * The lines are left alone, as reading a file overwrites them in place
+ * and clearing them would free the memory of each line.
+ */
+void ParseBuffers::Clear() {
+    positions.clear();
+    normals.clear();
+    textureCoordinates.clear();
+    internedStrings.clear();
+    meshesByKey.clear();
+}
+
+/**
+ * Frees the memory held by the buffers.
+ */
+void ParseBuffers::Release() {
+    std::vector<std::string>().swap(lines);
+    std::vector<std::string>().swap(materialLines);
+    lineCount = 0;
+    materialLineCount = 0;
+    Point4DList().swap(positions);
+    Point3DList().swap(normals);
+    TextureCoordinatesList().swap(textureCoordinates);
+    std::unordered_map<std::string, uint32_t>().swap(internedStrings);
+    std::unordered_map<uint64_t, size_t>().swap(meshesByKey);
+}
+
+/**
+ * Returns the bytes of memory held by the buffers, whether used or not.
+ * Hash tables are estimated from their bucket and entry counts.
+ *
+ * @return The reserved size of the buffers in bytes.
+ */
+size_t ParseBuffers::GetReservedBytes() const {
+    size_t bytes = GetLinesBytes(lines) + GetLinesBytes(materialLines) +
+                   positions.capacity() * sizeof(Point4D) +
+                   normals.capacity() * sizeof(Point3D) +
+                   textureCoordinates.capacity() * sizeof(TextureCoordinates) +
+                   GetMapBytes(internedStrings) + GetMapBytes(meshesByKey);
+
+    for (const auto& entry : internedStrings) {
+        bytes += GetStringHeapBytes(entry.first);
+    }
+
+    return bytes;
+}
+
+}   // namespace Meshborn
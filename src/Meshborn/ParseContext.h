@@ -0,0 +1,121 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef PARSECONTEXT_H_
+#define PARSECONTEXT_H_
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Logger.h"
+#include "ParseOptions.h"
+#include "ParseStats.h"
+#include "Structures.h"
+
+namespace Meshborn {
+
+// Default ParseContext::bufferLimit, in bytes.
+const size_t DEFAULT_PARSE_BUFFER_LIMIT = 64 * 1024 * 1024;
+
+/**
+ * Working storage of a parse, kept in its ParseContext so that loading
+ * many files with one context reuses the memory instead of growing new
+ * vectors for each file. The contents are only meaningful during a parse.
+ */
+struct ParseBuffers {
+    ParseBuffers() : lineCount(0), materialLineCount(0) {}
+
+    // Lines of the file, overwritten in place so their strings keep their
+    // capacity from one file to the next. Only the first lineCount belong
+    // to the current file; the rest are kept from a longer one.
+    std::vector<std::string> lines;
+    size_t lineCount;
+
+    // Lines of the material library being read, the first
+    // materialLineCount of which belong to it.
+    std::vector<std::string> materialLines;
+    size_t materialLineCount;
+
+    Point4DList positions;
+    Point3DList normals;
+    TextureCoordinatesList textureCoordinates;
+
+    // Interned mesh names and materials, and the mesh for each pair of
+    // them, used when coalescing meshes.
+    std::unordered_map<std::string, uint32_t> internedStrings;
+    std::unordered_map<uint64_t, size_t> meshesByKey;
+
+    /**
+     * Empties the buffers for the next file, keeping their memory.
+     */
+    void Clear();
+
+    /**
+     * Frees the memory held by the buffers.
+     */
+    void Release();
+
+    /**
+     * @return Bytes of memory held by the buffers, whether used or not.
+     */
+    size_t GetReservedBytes() const;
+};
+
+/**
+ * Everything a single parse reads or writes besides the file itself, so
+ * that parsers hold no state of their own during a call. Loads running at
+ * the same time, even through one parser object, each use their own
+ * context and share nothing mutable.
+ */
+struct ParseContext {
+    ParseContext() : logger(nullptr), threadCount(0),
+                     bufferLimit(DEFAULT_PARSE_BUFFER_LIMIT) {}
+
+    explicit ParseContext(const ParseOptions& parseOptions)
+        : options(parseOptions), logger(nullptr), threadCount(0),
+          bufferLimit(DEFAULT_PARSE_BUFFER_LIMIT) {}
+
+    // Processing applied to the model, see ParseOptions.
+    ParseOptions options;
+
+    // Receives the messages logged by this parse, on the calling thread
+    // and on the worker threads it starts. It is not owned and must
+    // outlive the call. When null the logger given to SetLogger is used.
+    Logger::ILogger *logger;
+
+    // Maximum number of threads used by each post-processing step,
+    // overriding the threadCount of the step's options when non-zero.
+    unsigned int threadCount;
+
+    // Timings and counters of the parse, added to by each call. Only
+    // recorded when the library is built with MESHBORN_PARSE_STATS.
+    ParseStats stats;
+
+    // Working storage, kept between calls. A context should be reused for
+    // a run of loads, e.g. one per worker thread.
+    ParseBuffers buffers;
+
+    // High-water mark for the buffers: after a parse they are freed if
+    // they hold more than this many bytes, so one large file does not pin
+    // its memory for the rest of the run. 0 frees them after every parse.
+    size_t bufferLimit;
+};
+
+}   // namespace Meshborn
+
+#endif  // PARSECONTEXT_H_
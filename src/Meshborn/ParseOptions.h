@@ -0,0 +1,90 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef PARSEOPTIONS_H_
+#define PARSEOPTIONS_H_
+#include "BufferConsolidator.h"
+#include "InstanceDetector.h"
+#include "MeshCleaner.h"
+#include "MeshSplitter.h"
+#include "NormalGenerator.h"
+#include "SpatialSorter.h"
+#include "TangentGenerator.h"
+#include "VertexWelder.h"
+
+namespace Meshborn {
+
+/**
+ * Optional processing applied by WaveFrontObjParser::ParseObj.
+ *
+ * Everything is disabled by default so that a default-constructed parser
+ * returns the file contents as written.
+ */
+struct ParseOptions {
+    ParseOptions() : coalesceMeshes(false), weldVertices(false),
+                     cleanMeshes(false), detectInstances(false),
+                     spatialSort(false), generateNormals(false),
+                     generateTangents(false), consolidateBuffers(false),
+                     splitMeshes(false) {}
+
+    // Append faces to an earlier mesh with the same object:group name and
+    // material instead of starting a new mesh each time the combination
+    // recurs, e.g. when a file alternates between two materials.
+    bool coalesceMeshes;
+
+    // Merge vertex positions closer than the weld tolerance. This shrinks
+    // the position pool, but FinaliseVertices still stores one vertex per
+    // face corner, so vertex memory only falls once consolidateBuffers
+    // shares the corners that welding has made identical.
+    bool weldVertices;
+    VertexWeldOptions weldOptions;
+
+    // Remove degenerate and duplicate faces and unused attributes before
+    // the meshes are finalised. Runs after welding, which can leave faces
+    // with repeated positions.
+    bool cleanMeshes;
+    MeshCleanupOptions cleanupOptions;
+
+    // Replace meshes that repeat earlier geometry with instances of it.
+    bool detectInstances;
+    InstanceDetectionOptions instanceOptions;
+
+    // Reorder faces and meshes along a space filling curve.
+    bool spatialSort;
+    SpatialSortOptions spatialSortOptions;
+
+    // Generate smooth normals for face corners without a 'vn' normal.
+    bool generateNormals;
+    NormalGenerationOptions normalOptions;
+
+    // Generate tangent frames, by default for bump mapped meshes only.
+    bool generateTangents;
+    TangentGenerationOptions tangentOptions;
+
+    // Move every mesh into the model's shared vertex and index buffers.
+    // Applied last, as the other steps work on the per-mesh vertices.
+    bool consolidateBuffers;
+    BufferConsolidationOptions consolidationOptions;
+
+    // Split meshes to fit 16-bit indices. Implies consolidateBuffers.
+    bool splitMeshes;
+    MeshSplitOptions splitOptions;
+};
+
+}   // namespace Meshborn
+
+#endif  // PARSEOPTIONS_H_
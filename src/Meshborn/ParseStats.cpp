@@ -0,0 +1,147 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <iterator>
+#include "ParseStats.h"
+
+namespace Meshborn {
+
+namespace {
+
+const char* const PHASE_NAMES[PARSE_PHASE_COUNT] = {
+    "READ_FILE",
+    "PARSE_LINES",
+    "MATERIAL_LIBRARY",
+    "WELD_VERTICES",
+    "CLEAN_MESHES",
+    "DETECT_INSTANCES",
+    "FINALISE_VERTICES",
+    "SPATIAL_SORT",
+    "GENERATE_NORMALS",
+    "GENERATE_TANGENTS",
+    "CONSOLIDATE_BUFFERS",
+    "SPLIT_MESHES"
+};
+
+const char* const KEYWORD_NAMES[PARSE_KEYWORD_COUNT] = {
+    "g",
+    "o",
+    "f",
+    "v",
+    "vn",
+    "vt",
+    "usemtl",
+    "s",
+    "mtllib",
+    "newmtl",
+    "material property",
+    "unknown"
+};
+
+}   // namespace
+
+ParseStats::ParseStats() {
+    Reset();
+}
+
+/**
+ * Sets every timing and counter back to zero.
+ */
+void ParseStats::Reset() {
+    std::fill(std::begin(phaseSeconds), std::end(phaseSeconds), 0.0);
+    std::fill(std::begin(lines), std::end(lines), 0);
+    std::fill(std::begin(lineSeconds), std::end(lineSeconds), 0.0);
+    std::fill(std::begin(faces), std::end(faces), 0);
+    bytesRead = 0;
+    meshesCreated = 0;
+    materialsCreated = 0;
+    bytesAllocated = 0;
+}
+
+/**
+ * Adds another set of statistics to this one.
+ *
+ * @param other Statistics to add, e.g. those of a material library loaded
+ *              while parsing a model.
+ */
+void ParseStats::Add(const ParseStats& other) {
+    for (size_t i = 0; i < PARSE_PHASE_COUNT; ++i) {
+        phaseSeconds[i] += other.phaseSeconds[i];
+    }
+
+    for (size_t i = 0; i < PARSE_KEYWORD_COUNT; ++i) {
+        lines[i] += other.lines[i];
+        lineSeconds[i] += other.lineSeconds[i];
+    }
+
+    for (size_t i = 0; i < POLYGONAL_FACE_TYPE_COUNT; ++i) {
+        faces[i] += other.faces[i];
+    }
+
+    bytesRead += other.bytesRead;
+    meshesCreated += other.meshesCreated;
+    materialsCreated += other.materialsCreated;
+    bytesAllocated += other.bytesAllocated;
+}
+
+/**
+ * @return Wall time of the whole load, the sum of the phases.
+ */
+double ParseStats::GetTotalSeconds() const {
+    double total = 0.0;
+
+    for (double seconds : phaseSeconds) {
+        total += seconds;
+    }
+
+    return total;
+}
+
+uint64_t ParseStats::GetLineCount() const {
+    uint64_t total = 0;
+
+    for (uint64_t count : lines) {
+        total += count;
+    }
+
+    return total;
+}
+
+uint64_t ParseStats::GetFaceCount() const {
+    return faces[0] + faces[1] + faces[2];
+}
+
+const char* ParseStats::GetPhaseName(ParsePhase phase) {
+    const size_t index = static_cast<size_t>(phase);
+    return index < PARSE_PHASE_COUNT ? PHASE_NAMES[index] : "";
+}
+
+const char* ParseStats::GetKeywordName(ParseKeyword keyword) {
+    const size_t index = static_cast<size_t>(keyword);
+    return index < PARSE_KEYWORD_COUNT ? KEYWORD_NAMES[index] : "";
+}
+
+bool IsParseStatsEnabled() {
+#ifdef MESHBORN_PARSE_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+}   // namespace Meshborn
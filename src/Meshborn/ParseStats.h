@@ -0,0 +1,142 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef PARSESTATS_H_
+#define PARSESTATS_H_
+#include <cstddef>
+#include <cstdint>
+
+namespace Meshborn {
+
+/**
+ * Stages of a load, in the order ParseObj runs them.
+ */
+enum class ParsePhase {
+    // Reading and, for .gz files, decompressing the file into lines.
+    READ_FILE,
+
+    // Tokenising and parsing the lines, excluding material libraries.
+    PARSE_LINES,
+
+    // Reading and parsing .mtl files named by 'mtllib'.
+    MATERIAL_LIBRARY,
+
+    WELD_VERTICES,
+    CLEAN_MESHES,
+    DETECT_INSTANCES,
+    FINALISE_VERTICES,
+    SPATIAL_SORT,
+    GENERATE_NORMALS,
+    GENERATE_TANGENTS,
+    CONSOLIDATE_BUFFERS,
+    SPLIT_MESHES,
+
+    COUNT
+};
+
+/**
+ * Kinds of line counted while parsing, .obj keywords first.
+ */
+enum class ParseKeyword {
+    GROUP,
+    OBJECT,
+    POLYGONAL_FACE,
+    VECTOR,
+    VECTOR_NORMAL,
+    TEXTURE_COORDINATE,
+    USE_MATERIAL,
+    SMOOTHING_GROUP,
+    MATERIAL_LIBRARY,
+
+    // 'newmtl' and the other lines of a .mtl file.
+    NEW_MATERIAL,
+    MATERIAL_PROPERTY,
+
+    // Keywords the parsers ignore. Comments and blank lines are dropped
+    // while the file is read and never reach the parsers.
+    UNKNOWN,
+
+    COUNT
+};
+
+const size_t PARSE_PHASE_COUNT = static_cast<size_t>(ParsePhase::COUNT);
+const size_t PARSE_KEYWORD_COUNT = static_cast<size_t>(ParseKeyword::COUNT);
+
+// One count per PolygonalFaceType.
+const size_t POLYGONAL_FACE_TYPE_COUNT = 3;
+
+/**
+ * Timings and counters recorded by WaveFrontObjParser::ParseObj and
+ * MaterialLibraryParser::ParseLibrary.
+ *
+ * The parsers only fill these in when the library is built with
+ * MESHBORN_PARSE_STATS defined (configure --enable-parse-stats), otherwise
+ * the instrumentation compiles away and the statistics stay zero. The
+ * layout is the same either way.
+ */
+struct ParseStats {
+    ParseStats();
+
+    void Reset();
+
+    // Adds the counters and timings of another load, e.g. a material
+    // library parsed as part of this one.
+    void Add(const ParseStats& other);
+
+    double GetTotalSeconds() const;
+
+    uint64_t GetLineCount() const;
+
+    uint64_t GetFaceCount() const;
+
+    static const char* GetPhaseName(ParsePhase phase);
+
+    static const char* GetKeywordName(ParseKeyword keyword);
+
+    // Wall time of each ParsePhase. Phases that did not run stay zero.
+    double phaseSeconds[PARSE_PHASE_COUNT];
+
+    // Lines of each ParseKeyword and the wall time spent on them, which
+    // splits PARSE_LINES into tokenising and parsing each kind of line.
+    // The time of an 'mtllib' line includes loading its library.
+    uint64_t lines[PARSE_KEYWORD_COUNT];
+    double lineSeconds[PARSE_KEYWORD_COUNT];
+
+    // Faces of each PolygonalFaceType as read from the file.
+    uint64_t faces[POLYGONAL_FACE_TYPE_COUNT];
+
+    // Bytes of text read, after decompression, including the comments,
+    // blank lines and line endings that are dropped before parsing.
+    uint64_t bytesRead;
+
+    uint64_t meshesCreated;
+    uint64_t materialsCreated;
+
+    // Bytes held by the parser's main buffers: the file's lines, the
+    // attribute pools, faces and finalised vertices. Small allocations
+    // such as names are not counted.
+    uint64_t bytesAllocated;
+};
+
+/**
+ * @return true if the library was built to record ParseStats.
+ */
+bool IsParseStatsEnabled();
+
+}   // namespace Meshborn
+
+#endif  // PARSESTATS_H_
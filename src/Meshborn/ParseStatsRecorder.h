@@ -0,0 +1,181 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef PARSESTATSRECORDER_H_
+#define PARSESTATSRECORDER_H_
+#include <chrono>   // NOLINT
+#include <string>
+#include <vector>
+#include "Mesh.h"
+#include "ParseStats.h"
+#include "StringMemory.h"
+
+namespace Meshborn {
+
+#ifdef MESHBORN_PARSE_STATS
+
+/**
+ * Adds the wall time of a scope, or up to Stop(), to one phase of a
+ * ParseStats. Time between Pause() and Resume() is left out, e.g. while a
+ * nested phase runs.
+ */
+class ParsePhaseTimer {
+ public:
+    ParsePhaseTimer(ParseStats *stats, ParsePhase phase)
+        : stats_(stats), phase_(phase), paused_(false),
+          start_(std::chrono::steady_clock::now()) {}
+
+    ~ParsePhaseTimer() {
+        Stop();
+    }
+
+    void Pause() {
+        if (stats_ && !paused_) {
+            AddElapsed();
+            paused_ = true;
+        }
+    }
+
+    void Resume() {
+        if (paused_) {
+            start_ = std::chrono::steady_clock::now();
+            paused_ = false;
+        }
+    }
+
+    void Stop() {
+        Pause();
+        stats_ = nullptr;
+    }
+
+ private:
+    void AddElapsed() {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start_;
+        stats_->phaseSeconds[static_cast<size_t>(phase_)] +=
+            elapsed.count();
+    }
+
+    ParseStats *stats_;
+    ParsePhase phase_;
+    bool paused_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * Counts a line and adds its wall time to the keyword it turns out to be,
+ * which is set once the line has been recognised.
+ */
+class ParseLineTimer {
+ public:
+    explicit ParseLineTimer(ParseStats *stats)
+        : stats_(stats), keyword_(ParseKeyword::UNKNOWN),
+          start_(std::chrono::steady_clock::now()) {}
+
+    ~ParseLineTimer() {
+        const size_t index = static_cast<size_t>(keyword_);
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start_;
+        stats_->lines[index]++;
+        stats_->lineSeconds[index] += elapsed.count();
+    }
+
+    void SetKeyword(ParseKeyword keyword) {
+        keyword_ = keyword;
+    }
+
+ private:
+    ParseStats *stats_;
+    ParseKeyword keyword_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @return Bytes held by a file's lines, as counted in bytesAllocated.
+ */
+inline uint64_t GetLinesAllocation(const std::vector<std::string>& lines) {
+    uint64_t bytes = lines.capacity() * sizeof(std::string);
+
+    for (const auto& line : lines) {
+        bytes += GetStringHeapBytes(line);
+    }
+
+    return bytes;
+}
+
+/**
+ * @return Bytes held by the faces of a set of meshes.
+ */
+inline uint64_t GetFacesAllocation(const std::vector<Mesh>& meshes) {
+    uint64_t bytes = 0;
+
+    for (const auto& mesh : meshes) {
+        bytes += mesh.faces.capacity() * sizeof(PolygonalFace);
+
+        for (const auto& face : mesh.faces) {
+            bytes += face.elements.capacity() *
+                     sizeof(PolygonalFaceElement);
+        }
+    }
+
+    return bytes;
+}
+
+/**
+ * @return Bytes held by the finalised vertices of a set of meshes.
+ */
+inline uint64_t GetVerticesAllocation(const std::vector<Mesh>& meshes) {
+    uint64_t bytes = 0;
+
+    for (const auto& mesh : meshes) {
+        bytes += mesh.vertices.capacity() * sizeof(Vertex);
+    }
+
+    return bytes;
+}
+
+  #define PARSE_STATS_CONCAT_(a, b) a##b
+  #define PARSE_STATS_CONCAT(a, b) PARSE_STATS_CONCAT_(a, b)
+
+  // Runs a statement that only updates statistics.
+  #define PARSE_STATS(statement) do { statement; } while (0)
+
+  // Times the rest of the enclosing scope as the given phase.
+  #define PARSE_STATS_PHASE(stats, phase)                               \
+    ParsePhaseTimer PARSE_STATS_CONCAT(parsePhaseTimer, __LINE__)(      \
+        (stats), (phase))
+
+  // Times from here to name.Stop(), or the end of the scope, as a phase.
+  #define PARSE_STATS_NAMED_PHASE(name, stats, phase)                   \
+    ParsePhaseTimer name((stats), (phase))
+
+  // Times the enclosing loop body as one line, see PARSE_STATS_LINE.
+  #define PARSE_STATS_LINE_TIMER(stats)                                 \
+    ParseLineTimer parseLineTimer((stats))
+
+  #define PARSE_STATS_LINE(keyword) parseLineTimer.SetKeyword((keyword))
+#else
+  #define PARSE_STATS(statement) do {} while (0)
+  #define PARSE_STATS_PHASE(stats, phase) do {} while (0)
+  #define PARSE_STATS_NAMED_PHASE(name, stats, phase) do {} while (0)
+  #define PARSE_STATS_LINE_TIMER(stats) do {} while (0)
+  #define PARSE_STATS_LINE(keyword) do {} while (0)
+#endif
+
+}   // namespace Meshborn
+
+#endif  // PARSESTATSRECORDER_H_
@@ -0,0 +1,134 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <vector>
+#include "Parallel.h"
+#include "RadixSort.h"
+
+namespace Meshborn {
+
+namespace {
+
+// Widest digit sorted in one pass; 2048 counters per chunk stay in L1.
+const unsigned int RADIX_MAX_DIGIT_BITS = 11;
+
+// Minimum number of values given to each chunk.
+const size_t RADIX_GRAIN_SIZE = 65536;
+
+}   // namespace
+
+/**
+ * Sorts 64-bit values by a range of their bits.
+ *
+ * The values are split into one contiguous chunk per thread. Each pass
+ * counts the digits of every chunk in parallel, turns the counts into
+ * output offsets ordered by digit and then by chunk, and scatters the
+ * chunks in parallel, which keeps the sort stable. Passes in which every
+ * value has the same digit are skipped, which is common for the high bits
+ * of keys quantised from a small range.
+ *
+ * @param values The values to sort in place.
+ * @param firstBit Lowest bit of the sort key.
+ * @param lastBit One past the highest bit of the sort key, at most 64.
+ * @param threadCount Maximum number of threads, 0 selects the default.
+ */
+void RadixSort(std::vector<uint64_t> *values,
+               unsigned int firstBit,
+               unsigned int lastBit,
+               unsigned int threadCount) {
+    lastBit = std::min(lastBit, 64u);
+
+    const size_t count = values->size();
+
+    if (count < 2 || lastBit <= firstBit) {
+        return;
+    }
+
+    const unsigned int range = lastBit - firstBit;
+    const unsigned int passes = (range + RADIX_MAX_DIGIT_BITS - 1) /
+                                RADIX_MAX_DIGIT_BITS;
+    const unsigned int digitBits = (range + passes - 1) / passes;
+    const size_t bucketCount = size_t(1) << digitBits;
+    const size_t chunkCount = std::clamp<size_t>(
+        count / RADIX_GRAIN_SIZE, 1, ResolveThreadCount(threadCount));
+    const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    std::vector<uint64_t> scratch(count);
+    std::vector<size_t> offsets(chunkCount * bucketCount);
+    uint64_t *source = values->data();
+    uint64_t *target = scratch.data();
+
+    for (unsigned int pass = 0; pass < passes; ++pass) {
+        const unsigned int shift = firstBit + pass * digitBits;
+        const uint64_t mask = (uint64_t(1) <<
+                               std::min(digitBits, lastBit - shift)) - 1;
+
+        ParallelFor(chunkCount, 1, [&](size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; ++chunk) {
+                size_t *counts = offsets.data() + chunk * bucketCount;
+                const size_t last = std::min(count, (chunk + 1) * chunkSize);
+
+                std::fill(counts, counts + bucketCount, 0);
+
+                for (size_t i = chunk * chunkSize; i < last; ++i) {
+                    ++counts[(source[i] >> shift) & mask];
+                }
+            }
+        }, threadCount);
+
+        size_t total = 0;
+        bool sorted = false;
+
+        for (size_t digit = 0; digit < bucketCount && !sorted; ++digit) {
+            size_t digitTotal = 0;
+
+            for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+                size_t& offset = offsets[chunk * bucketCount + digit];
+                const size_t digitCount = offset;
+                offset = total;
+                total += digitCount;
+                digitTotal += digitCount;
+            }
+
+            sorted = digitTotal == count;
+        }
+
+        if (sorted) {
+            continue;
+        }
+
+        ParallelFor(chunkCount, 1, [&](size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; ++chunk) {
+                size_t *next = offsets.data() + chunk * bucketCount;
+                const size_t last = std::min(count, (chunk + 1) * chunkSize);
+
+                for (size_t i = chunk * chunkSize; i < last; ++i) {
+                    target[next[(source[i] >> shift) & mask]++] = source[i];
+                }
+            }
+        }, threadCount);
+
+        std::swap(source, target);
+    }
+
+    if (source != values->data()) {
+        values->swap(scratch);
+    }
+}
+
+}   // namespace Meshborn
@@ -0,0 +1,44 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef RADIXSORT_H_
+#define RADIXSORT_H_
+#include <cstdint>
+#include <vector>
+
+namespace Meshborn {
+
+/**
+ * Sorts 64-bit values by a range of their bits with a stable, parallel
+ * least significant digit radix sort.
+ *
+ * Values that compare equal over the range keep their order, so an index
+ * packed into the bits below the range acts as a tie break for free.
+ *
+ * @param values The values to sort in place.
+ * @param firstBit Lowest bit of the sort key.
+ * @param lastBit One past the highest bit of the sort key, at most 64.
+ * @param threadCount Maximum number of threads, 0 selects the default.
+ */
+void RadixSort(std::vector<uint64_t> *values,
+               unsigned int firstBit,
+               unsigned int lastBit,
+               unsigned int threadCount = 0);
+
+}   // namespace Meshborn
+
+#endif  // RADIXSORT_H_
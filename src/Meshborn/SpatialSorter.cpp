@@ -0,0 +1,505 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <format>
+#include <vector>
+#include "LoggerManager.h"
+#include "Parallel.h"
+#include "RadixSort.h"
+#include "Simd.h"
+#include "SpatialSorter.h"
+
+namespace Meshborn {
+
+namespace {
+
+// Bits per quantised coordinate, giving 30-bit curve keys.
+const unsigned int CURVE_BITS = 10;
+
+// Largest quantised coordinate.
+const float CURVE_CELLS = static_cast<float>((1u << CURVE_BITS) - 1);
+
+// Minimum number of faces or keys handed to a worker thread. Meshes with
+// fewer faces are sorted whole on one thread, several meshes at a time.
+const size_t SORT_GRAIN_SIZE = 16384;
+
+/**
+ * Points to sort, with each coordinate in its own array so they can be
+ * loaded four at a time. The arrays are padded to a multiple of four.
+ */
+struct CentroidList {
+    explicit CentroidList(size_t count)
+        : x((count + 3) & ~size_t(3)), y(x.size()), z(x.size()) {}
+
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+};
+
+#ifndef MESHBORN_SSE2
+/**
+ * Spaces the low 10 bits of a value out to every third bit.
+ */
+uint32_t SpreadBits(uint32_t value) {
+    value = (value | (value << 16)) & 0x030000FF;
+    value = (value | (value << 8)) & 0x0300F00F;
+    value = (value | (value << 4)) & 0x030C30C3;
+    value = (value | (value << 2)) & 0x09249249;
+    return value;
+}
+
+uint32_t MortonKey(uint32_t x, uint32_t y, uint32_t z) {
+    return (SpreadBits(x) << 2) | (SpreadBits(y) << 1) | SpreadBits(z);
+}
+
+/**
+ * Computes a Hilbert curve key with Skilling's transform ("Programming the
+ * Hilbert curve", 2004), which turns the coordinates into the transposed
+ * Hilbert index whose interleaved bits are the key.
+ */
+uint32_t HilbertKey(uint32_t x, uint32_t y, uint32_t z) {
+    uint32_t axes[3] = { x, y, z };
+
+    for (uint32_t q = 1u << (CURVE_BITS - 1); q > 1; q >>= 1) {
+        const uint32_t p = q - 1;
+
+        for (int i = 0; i < 3; ++i) {
+            if (axes[i] & q) {
+                axes[0] ^= p;
+            } else {
+                const uint32_t t = (axes[0] ^ axes[i]) & p;
+                axes[0] ^= t;
+                axes[i] ^= t;
+            }
+        }
+    }
+
+    axes[1] ^= axes[0];
+    axes[2] ^= axes[1];
+
+    uint32_t t = 0;
+
+    for (uint32_t q = 1u << (CURVE_BITS - 1); q > 1; q >>= 1) {
+        if (axes[2] & q) {
+            t ^= q - 1;
+        }
+    }
+
+    return MortonKey(axes[0] ^ t, axes[1] ^ t, axes[2] ^ t);
+}
+
+uint32_t Quantise(float value, float low, float scale) {
+    const float cell = (value - low) * scale;
+
+    // Written so that NaN falls into cell 0.
+    return static_cast<uint32_t>(cell > 0.0f ? std::min(cell, CURVE_CELLS)
+                                             : 0.0f);
+}
+#else
+__m128i SpreadBits4(__m128i value) {
+    value = _mm_and_si128(_mm_or_si128(value, _mm_slli_epi32(value, 16)),
+                          _mm_set1_epi32(0x030000FF));
+    value = _mm_and_si128(_mm_or_si128(value, _mm_slli_epi32(value, 8)),
+                          _mm_set1_epi32(0x0300F00F));
+    value = _mm_and_si128(_mm_or_si128(value, _mm_slli_epi32(value, 4)),
+                          _mm_set1_epi32(0x030C30C3));
+    value = _mm_and_si128(_mm_or_si128(value, _mm_slli_epi32(value, 2)),
+                          _mm_set1_epi32(0x09249249));
+    return value;
+}
+
+__m128i MortonKey4(__m128i x, __m128i y, __m128i z) {
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(SpreadBits4(x), 2),
+                                     _mm_slli_epi32(SpreadBits4(y), 1)),
+                        SpreadBits4(z));
+}
+
+/**
+ * Four lane version of HilbertKey, with the branches replaced by masks.
+ */
+__m128i HilbertKey4(__m128i x, __m128i y, __m128i z) {
+    __m128i axes[3] = { x, y, z };
+
+    for (uint32_t q = 1u << (CURVE_BITS - 1); q > 1; q >>= 1) {
+        const __m128i qs = _mm_set1_epi32(static_cast<int>(q));
+        const __m128i ps = _mm_set1_epi32(static_cast<int>(q - 1));
+
+        for (int i = 0; i < 3; ++i) {
+            const __m128i set = _mm_cmpeq_epi32(_mm_and_si128(axes[i], qs),
+                                                qs);
+            axes[0] = _mm_xor_si128(axes[0], _mm_and_si128(set, ps));
+
+            const __m128i t = _mm_andnot_si128(set, _mm_and_si128(
+                _mm_xor_si128(axes[0], axes[i]), ps));
+            axes[0] = _mm_xor_si128(axes[0], t);
+            axes[i] = _mm_xor_si128(axes[i], t);
+        }
+    }
+
+    axes[1] = _mm_xor_si128(axes[1], axes[0]);
+    axes[2] = _mm_xor_si128(axes[2], axes[1]);
+
+    __m128i t = _mm_setzero_si128();
+
+    for (uint32_t q = 1u << (CURVE_BITS - 1); q > 1; q >>= 1) {
+        const __m128i qs = _mm_set1_epi32(static_cast<int>(q));
+        const __m128i set = _mm_cmpeq_epi32(_mm_and_si128(axes[2], qs), qs);
+        t = _mm_xor_si128(t, _mm_and_si128(
+            set, _mm_set1_epi32(static_cast<int>(q - 1))));
+    }
+
+    return MortonKey4(_mm_xor_si128(axes[0], t), _mm_xor_si128(axes[1], t),
+                      _mm_xor_si128(axes[2], t));
+}
+
+__m128i Quantise4(const float *values, __m128 low, __m128 scale) {
+    __m128 cell = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(values), low), scale);
+
+    // maxps returns its second operand for NaN, placing it in cell 0.
+    cell = _mm_min_ps(_mm_max_ps(cell, _mm_setzero_ps()),
+                      _mm_set1_ps(CURVE_CELLS));
+    return _mm_cvttps_epi32(cell);
+}
+#endif
+
+/**
+ * Computes the curve key of each point within a box and packs it above the
+ * point's index, ready for RadixSort.
+ */
+void ComputeKeys(const CentroidList& points, size_t count,
+                 const AxisAlignedBoundingBox& box, SpaceFillingCurve curve,
+                 std::vector<uint64_t> *keys, unsigned int threadCount) {
+    // The same scale is used on every axis so that cells stay cubic and
+    // flat or elongated meshes are not stretched along their short axes.
+    const float extent = std::max({ box.max.x - box.min.x,
+                                    box.max.y - box.min.y,
+                                    box.max.z - box.min.z });
+    const float scale = extent > 0.0f ? CURVE_CELLS / extent : 0.0f;
+
+    keys->resize(count);
+
+    ParallelFor((count + 3) / 4, SORT_GRAIN_SIZE / 4,
+                [&](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; ++block) {
+            const size_t first = block * 4;
+            uint32_t blockKeys[4];
+
+#ifdef MESHBORN_SSE2
+            const __m128i x = Quantise4(points.x.data() + first,
+                _mm_set1_ps(box.min.x), _mm_set1_ps(scale));
+            const __m128i y = Quantise4(points.y.data() + first,
+                _mm_set1_ps(box.min.y), _mm_set1_ps(scale));
+            const __m128i z = Quantise4(points.z.data() + first,
+                _mm_set1_ps(box.min.z), _mm_set1_ps(scale));
+            const __m128i key = curve == SpaceFillingCurve::HILBERT ?
+                HilbertKey4(x, y, z) : MortonKey4(x, y, z);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(blockKeys), key);
+#else
+            for (size_t lane = 0; lane < 4; ++lane) {
+                const uint32_t x = Quantise(points.x[first + lane],
+                                            box.min.x, scale);
+                const uint32_t y = Quantise(points.y[first + lane],
+                                            box.min.y, scale);
+                const uint32_t z = Quantise(points.z[first + lane],
+                                            box.min.z, scale);
+                blockKeys[lane] = curve == SpaceFillingCurve::HILBERT ?
+                    HilbertKey(x, y, z) : MortonKey(x, y, z);
+            }
+#endif
+
+            for (size_t lane = 0; lane < 4 && first + lane < count; ++lane) {
+                (*keys)[first + lane] =
+                    (static_cast<uint64_t>(blockKeys[lane]) << 32) |
+                    (first + lane);
+            }
+        }
+    }, threadCount);
+}
+
+/**
+ * Sorts points by their curve keys.
+ *
+ * @return The original index of each point in sorted order, or an empty
+ *         list if the order is unchanged.
+ */
+std::vector<uint32_t> SortPoints(const CentroidList& points, size_t count,
+                                 const AxisAlignedBoundingBox& box,
+                                 SpaceFillingCurve curve,
+                                 unsigned int threadCount) {
+    std::vector<uint64_t> keys;
+    ComputeKeys(points, count, box, curve, &keys, threadCount);
+    RadixSort(&keys, 32, 32 + 3 * CURVE_BITS, threadCount);
+
+    std::vector<uint32_t> order(count);
+    bool unchanged = true;
+
+    for (size_t i = 0; i < count; ++i) {
+        order[i] = static_cast<uint32_t>(keys[i]);
+        unchanged = unchanged && order[i] == i;
+    }
+
+    if (unchanged) {
+        order.clear();
+    }
+
+    return order;
+}
+
+bool SortFaces(Mesh *mesh, SpaceFillingCurve curve,
+               unsigned int threadCount) {
+    const size_t faceCount = mesh->faces.size();
+
+    if (faceCount < 2) {
+        return true;
+    }
+
+    if (faceCount > UINT32_MAX) {
+        LOG(Logger::LogLevel::Critical, std::format(
+            "Mesh '{}' has too many faces to sort", mesh->name));
+        return false;
+    }
+
+    std::vector<size_t> offsets(faceCount + 1, 0);
+
+    for (size_t f = 0; f < faceCount; ++f) {
+        offsets[f + 1] = offsets[f] + mesh->faces[f].elements.size();
+    }
+
+    if (offsets[faceCount] != mesh->vertices.size()) {
+        LOG(Logger::LogLevel::Critical, std::format(
+            "Mesh '{}' must be finalised before it is sorted", mesh->name));
+        return false;
+    }
+
+    CentroidList centroids(faceCount);
+
+    ParallelFor(faceCount, SORT_GRAIN_SIZE, [&](size_t begin, size_t end) {
+        for (size_t f = begin; f < end; ++f) {
+            float x = 0.0f;
+            float y = 0.0f;
+            float z = 0.0f;
+
+            for (size_t c = offsets[f]; c < offsets[f + 1]; ++c) {
+                x += mesh->vertices[c].position.x;
+                y += mesh->vertices[c].position.y;
+                z += mesh->vertices[c].position.z;
+            }
+
+            const size_t corners = offsets[f + 1] - offsets[f];
+            const float inverse = corners ? 1.0f / corners : 0.0f;
+            centroids.x[f] = x * inverse;
+            centroids.y[f] = y * inverse;
+            centroids.z[f] = z * inverse;
+        }
+    }, threadCount);
+
+    AxisAlignedBoundingBox box = mesh->boundingBox;
+
+    if (box.IsEmpty()) {
+        box = ComputeBoundingBox(mesh->vertices);
+    }
+
+    const std::vector<uint32_t> order = SortPoints(centroids, faceCount, box,
+                                                   curve, threadCount);
+
+    if (order.empty()) {
+        return true;
+    }
+
+    const bool hasTangents = mesh->tangents.size() == mesh->vertices.size();
+    std::vector<size_t> sortedOffsets(faceCount + 1, 0);
+
+    for (size_t f = 0; f < faceCount; ++f) {
+        sortedOffsets[f + 1] = sortedOffsets[f] +
+                               (offsets[order[f] + 1] - offsets[order[f]]);
+    }
+
+    std::vector<PolygonalFace> faces(faceCount);
+    std::vector<Vertex> vertices(mesh->vertices.size());
+    std::vector<Point4D> tangents(hasTangents ? vertices.size() : 0);
+
+    ParallelFor(faceCount, SORT_GRAIN_SIZE, [&](size_t begin, size_t end) {
+        for (size_t f = begin; f < end; ++f) {
+            const size_t source = order[f];
+            faces[f] = std::move(mesh->faces[source]);
+
+            std::copy(mesh->vertices.begin() + offsets[source],
+                      mesh->vertices.begin() + offsets[source + 1],
+                      vertices.begin() + sortedOffsets[f]);
+
+            if (hasTangents) {
+                std::copy(mesh->tangents.begin() + offsets[source],
+                          mesh->tangents.begin() + offsets[source + 1],
+                          tangents.begin() + sortedOffsets[f]);
+            }
+        }
+    }, threadCount);
+
+    mesh->faces = std::move(faces);
+    mesh->vertices = std::move(vertices);
+
+    if (hasTangents) {
+        mesh->tangents = std::move(tangents);
+    }
+
+    return true;
+}
+
+}   // namespace
+
+SpatialSorter::SpatialSorter() {
+}
+
+SpatialSorter::SpatialSorter(const SpatialSortOptions& options)
+    : options_(options) {
+}
+
+/**
+ * Sorts the faces of every mesh and then the meshes of a model, as set in
+ * the options. Instances are updated to follow their meshes.
+ *
+ * @param model The model to sort, which must have finalised vertices and
+ *        must not yet be consolidated.
+ * @return true on success, false if the model cannot be sorted.
+ */
+bool SpatialSorter::Sort(Model *model) {
+    if (!model) {
+        LOG(Logger::LogLevel::Critical,
+            "Invalid model passed to SpatialSorter");
+        return false;
+    }
+
+    if (model->consolidated) {
+        LOG(Logger::LogLevel::Critical,
+            "SpatialSorter must run before buffers are consolidated");
+        return false;
+    }
+
+    const size_t meshCount = model->meshes.size();
+
+    if (options_.sortFaces) {
+        // Large meshes are sorted one at a time using every thread, small
+        // ones several at a time with a thread each.
+        std::vector<Mesh *> smallMeshes;
+        bool status = true;
+
+        for (auto& mesh : model->meshes) {
+            if (mesh.faces.size() < SORT_GRAIN_SIZE) {
+                smallMeshes.push_back(&mesh);
+            } else {
+                status = SortFaces(&mesh, options_.curve,
+                                   options_.threadCount) && status;
+            }
+        }
+
+        std::atomic<bool> smallStatus = true;
+
+        ParallelFor(smallMeshes.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (!SortFaces(smallMeshes[i], options_.curve, 1)) {
+                    smallStatus = false;
+                }
+            }
+        }, options_.threadCount);
+
+        if (!status || !smallStatus) {
+            return false;
+        }
+    }
+
+    if (!options_.sortMeshes || meshCount < 2) {
+        return true;
+    }
+
+    CentroidList centres(meshCount);
+    AxisAlignedBoundingBox box;
+
+    for (size_t m = 0; m < meshCount; ++m) {
+        const AxisAlignedBoundingBox& meshBox = model->meshes[m].boundingBox;
+
+        if (meshBox.IsEmpty()) {
+            continue;
+        }
+
+        const Point3D centre = meshBox.Centre();
+        centres.x[m] = centre.x;
+        centres.y[m] = centre.y;
+        centres.z[m] = centre.z;
+        box.Merge(meshBox);
+    }
+
+    if (box.IsEmpty()) {
+        return true;
+    }
+
+    // Meshes without bounds sort to the start, in file order.
+    for (size_t m = 0; m < meshCount; ++m) {
+        if (model->meshes[m].boundingBox.IsEmpty()) {
+            centres.x[m] = box.min.x;
+            centres.y[m] = box.min.y;
+            centres.z[m] = box.min.z;
+        }
+    }
+
+    const std::vector<uint32_t> order = SortPoints(centres, meshCount, box,
+                                                   options_.curve,
+                                                   options_.threadCount);
+
+    if (order.empty()) {
+        return true;
+    }
+
+    std::vector<Mesh> meshes;
+    std::vector<size_t> remap(meshCount);
+    meshes.reserve(meshCount);
+
+    for (size_t m = 0; m < meshCount; ++m) {
+        remap[order[m]] = m;
+        meshes.push_back(std::move(model->meshes[order[m]]));
+    }
+
+    for (auto& instance : model->instances) {
+        if (instance.mesh < meshCount) {
+            instance.mesh = remap[instance.mesh];
+        }
+    }
+
+    model->meshes = std::move(meshes);
+
+    return true;
+}
+
+/**
+ * Sorts the faces of a single mesh along the curve.
+ *
+ * @param mesh The mesh to sort, which must have finalised vertices.
+ * @return true on success, false if the mesh cannot be sorted.
+ */
+bool SpatialSorter::Sort(Mesh *mesh) {
+    if (!mesh) {
+        LOG(Logger::LogLevel::Critical,
+            "Invalid mesh passed to SpatialSorter");
+        return false;
+    }
+
+    return SortFaces(mesh, options_.curve, options_.threadCount);
+}
+
+}   // namespace Meshborn
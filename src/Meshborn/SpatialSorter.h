@@ -0,0 +1,84 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SPATIALSORTER_H_
+#define SPATIALSORTER_H_
+#include "Model.h"
+
+namespace Meshborn {
+
+/**
+ * Space filling curve used to order faces and meshes.
+ */
+enum class SpaceFillingCurve {
+    // Interleaved coordinate bits (Z-order). Cheapest to compute.
+    MORTON,
+
+    // Hilbert curve, whose consecutive cells are always adjacent, giving
+    // better locality than Morton order for a little more work.
+    HILBERT
+};
+
+/**
+ * Settings controlling spatial sorting.
+ */
+struct SpatialSortOptions {
+    SpatialSortOptions() : curve(SpaceFillingCurve::HILBERT),
+                           sortFaces(true), sortMeshes(true),
+                           threadCount(0) {}
+
+    SpaceFillingCurve curve;
+
+    // Reorder the faces of each mesh by the curve position of their
+    // centroids within the mesh bounds.
+    bool sortFaces;
+
+    // Reorder the meshes of the model by the curve position of the centres
+    // of their bounding boxes within the model bounds.
+    bool sortMeshes;
+
+    // Maximum worker threads, 0 selects the hardware default.
+    unsigned int threadCount;
+};
+
+/**
+ * Reorders faces and meshes along a space filling curve so that geometry
+ * which is close in space is also close in memory, which helps spatial
+ * queries and tiled processing of files stored in an arbitrary order,
+ * such as scans.
+ *
+ * Curve keys are computed four at a time with SSE2 where available and
+ * sorted with a parallel radix sort. Faces or meshes with equal keys keep
+ * their file order.
+ */
+class SpatialSorter {
+ public:
+    SpatialSorter();
+
+    explicit SpatialSorter(const SpatialSortOptions& options);
+
+    bool Sort(Model *model);
+
+    bool Sort(Mesh *mesh);
+
+ private:
+    SpatialSortOptions options_;
+};
+
+}   // namespace Meshborn
+
+#endif  // SPATIALSORTER_H_
@@ -0,0 +1,48 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef STRINGMEMORY_H_
+#define STRINGMEMORY_H_
+#include <cstddef>
+#include <string>
+
+namespace Meshborn {
+
+/**
+ * Returns the heap bytes owned by a string.
+ *
+ * Short strings are held inside the string object itself by the small
+ * string optimisation and own no heap storage, which is detected from
+ * where their characters live rather than from an assumed buffer size.
+ *
+ * @param value The string to measure.
+ * @return The bytes allocated for its characters and terminator, or 0.
+ */
+inline size_t GetStringHeapBytes(const std::string& value) {
+    const char *data = value.data();
+    const char *object = reinterpret_cast<const char *>(&value);
+
+    if (data >= object && data < object + sizeof(value)) {
+        return 0;
+    }
+
+    return value.capacity() + 1;
+}
+
+}   // namespace Meshborn
+
+#endif  // STRINGMEMORY_H_
@@ -0,0 +1,395 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "LoggerManager.h"
+#include "Parallel.h"
+#include "TangentGenerator.h"
+
+namespace Meshborn {
+
+namespace {
+
+Point3D Subtract(const Point4D& a, const Point4D& b) {
+    return Point3D(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+float Dot(const Point3D& a, const Point3D& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+Point3D Cross(const Point3D& a, const Point3D& b) {
+    return Point3D(a.y * b.z - a.z * b.y,
+                   a.z * b.x - a.x * b.z,
+                   a.x * b.y - a.y * b.x);
+}
+
+bool Normalise(Point3D *v) {
+    float length = std::sqrt(Dot(*v, *v));
+    if (!(length > 0.0f)) {
+        return false;
+    }
+
+    v->x /= length;
+    v->y /= length;
+    v->z /= length;
+    return true;
+}
+
+// Removes the component of v along the unit vector n.
+Point3D Project(const Point3D& v, const Point3D& n) {
+    float d = Dot(v, n);
+    return Point3D(v.x - n.x * d, v.y - n.y * d, v.z - n.z * d);
+}
+
+// Returns a unit vector perpendicular to the unit vector n.
+Point3D AnyPerpendicular(const Point3D& n) {
+    Point3D axis = std::fabs(n.x) < 0.9f ? Point3D(1.0f, 0.0f, 0.0f)
+                                         : Point3D(0.0f, 1.0f, 0.0f);
+    Point3D result = Cross(n, axis);
+    Normalise(&result);
+    return result;
+}
+
+uint32_t FloatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/**
+ * Identifies the corners that share a tangent: MikkTSpace only merges
+ * corners with identical position, normal and texture coordinate whose
+ * triangles have the same texture space orientation.
+ */
+struct CornerKey {
+    int vertex;
+    int texture;
+    uint32_t normal[3];
+    bool orientationPreserving;
+
+    bool operator==(const CornerKey& other) const {
+        return vertex == other.vertex && texture == other.texture &&
+               normal[0] == other.normal[0] &&
+               normal[1] == other.normal[1] &&
+               normal[2] == other.normal[2] &&
+               orientationPreserving == other.orientationPreserving;
+    }
+};
+
+struct CornerKeyHash {
+    size_t operator()(const CornerKey& key) const {
+        uint64_t hash = 1469598103934665603ull;
+        auto mix = [&hash](uint64_t value) {
+            hash = (hash ^ value) * 1099511628211ull;
+        };
+
+        mix(static_cast<uint32_t>(key.vertex));
+        mix(static_cast<uint32_t>(key.texture));
+        mix(key.normal[0]);
+        mix(key.normal[1]);
+        mix(key.normal[2]);
+        mix(key.orientationPreserving);
+        return static_cast<size_t>(hash);
+    }
+};
+
+struct Triangle {
+    size_t corners[3];
+};
+
+}   // namespace
+
+TangentGenerator::TangentGenerator() {
+}
+
+TangentGenerator::TangentGenerator(const TangentGenerationOptions& options)
+    : options_(options) {
+}
+
+/**
+ * Generates tangents for the meshes of a model.
+ *
+ * Unless bumpMappedOnly is cleared, only meshes whose material has a bump
+ * map are processed, as tangent space is only needed to apply those maps.
+ * The selected meshes are spread across worker threads.
+ *
+ * @param model Pointer to the model whose meshes are updated.
+ * @return true on success, false if any mesh could not be processed.
+ */
+bool TangentGenerator::Generate(Model *model) {
+    if (!model) {
+        LOG(Logger::LogLevel::Critical,
+            "Invalid model passed to TangentGenerator");
+        return false;
+    }
+
+    std::vector<Mesh *> meshes;
+
+    for (auto& mesh : model->meshes) {
+        if (options_.bumpMappedOnly) {
+            auto material = model->materials.find(mesh.material);
+            std::string bumpMap;
+
+            if (material == model->materials.end() ||
+                !material->second->GetBumpMap(&bumpMap)) {
+                continue;
+            }
+        }
+
+        meshes.push_back(&mesh);
+    }
+
+    std::atomic<bool> status = true;
+
+    ParallelFor(meshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (!Generate(meshes[i])) {
+                status = false;
+            }
+        }
+    }, options_.threadCount);
+
+    return status;
+}
+
+/**
+ * Generates tangents for a single finalised mesh.
+ *
+ * Faces are split into triangles (fans for n-gons), the unnormalised
+ * texture space tangent of each triangle is projected onto the plane of
+ * each corner's normal and summed, weighted by the corner angle, over every
+ * corner sharing the same CornerKey. Corners whose tangent cannot be derived
+ * (e.g. degenerate texture coordinates) receive an arbitrary tangent that is
+ * perpendicular to the normal.
+ *
+ * @param mesh Pointer to the mesh to update; its vertices must have been
+ *             finalised from its faces.
+ * @return true on success, false if the mesh is invalid.
+ */
+bool TangentGenerator::Generate(Mesh *mesh) {
+    if (!mesh) {
+        LOG(Logger::LogLevel::Critical,
+            "Invalid mesh passed to TangentGenerator");
+        return false;
+    }
+
+    const auto& faces = mesh->faces;
+    const auto& vertices = mesh->vertices;
+
+    std::vector<const PolygonalFaceElement *> elements;
+    bool hasTextureCoordinates = false;
+
+    elements.reserve(vertices.size());
+
+    for (const auto& face : faces) {
+        for (const auto& element : face.elements) {
+            hasTextureCoordinates |= element.texture >= 1;
+            elements.push_back(&element);
+        }
+    }
+
+    if (elements.size() != vertices.size()) {
+        LOG(Logger::LogLevel::Critical, std::format(
+            "Mesh '{}' has not been finalised, unable to generate tangents",
+            mesh->name));
+        return false;
+    }
+
+    if (!hasTextureCoordinates) {
+        LOG(Logger::LogLevel::Warning, std::format(
+            "Mesh '{}' has no texture coordinates, tangents not generated",
+            mesh->name));
+        return true;
+    }
+
+    std::vector<Triangle> triangles;
+    triangles.reserve(vertices.size() / 3);
+    size_t first = 0;
+
+    for (const auto& face : faces) {
+        const size_t count = face.elements.size();
+
+        if (count == 4) {
+            // Split along the shorter diagonal in texture space, falling
+            // back to position space when both are the same length.
+            auto distance = [&](size_t a, size_t b) {
+                const auto& ta = vertices[first + a].textureCoordinates;
+                const auto& tb = vertices[first + b].textureCoordinates;
+                float du = ta.u - tb.u;
+                float dv = ta.v - tb.v;
+                return du * du + dv * dv;
+            };
+
+            float distance02 = distance(0, 2);
+            float distance13 = distance(1, 3);
+
+            if (distance02 == distance13) {
+                Point3D d02 = Subtract(vertices[first + 2].position,
+                                       vertices[first].position);
+                Point3D d13 = Subtract(vertices[first + 3].position,
+                                       vertices[first + 1].position);
+                distance02 = Dot(d02, d02);
+                distance13 = Dot(d13, d13);
+            }
+
+            if (distance02 < distance13) {
+                triangles.push_back({{ first, first + 1, first + 2 }});
+                triangles.push_back({{ first, first + 2, first + 3 }});
+            } else {
+                triangles.push_back({{ first, first + 1, first + 3 }});
+                triangles.push_back({{ first + 1, first + 2, first + 3 }});
+            }
+        } else {
+            for (size_t i = 1; i + 1 < count; ++i) {
+                triangles.push_back({{ first, first + i, first + i + 1 }});
+            }
+        }
+
+        first += count;
+    }
+
+    const size_t noGroup = SIZE_MAX;
+    std::vector<size_t> cornerGroup(vertices.size(), noGroup);
+    std::vector<bool> cornerOrientation(vertices.size(), true);
+    std::vector<Point3D> groupTangents;
+    std::unordered_map<CornerKey, size_t, CornerKeyHash> groups;
+
+    // Normal used for a corner, falling back to the triangle normal when the
+    // vertex has none.
+    auto cornerNormal = [&](size_t corner, const Point3D& faceNormal) {
+        Point3D normal = vertices[corner].normal;
+        return Normalise(&normal) ? normal : faceNormal;
+    };
+
+    for (const auto& triangle : triangles) {
+        const Vertex& v0 = vertices[triangle.corners[0]];
+        const Vertex& v1 = vertices[triangle.corners[1]];
+        const Vertex& v2 = vertices[triangle.corners[2]];
+
+        Point3D edge1 = Subtract(v1.position, v0.position);
+        Point3D edge2 = Subtract(v2.position, v0.position);
+        float s1 = v1.textureCoordinates.u - v0.textureCoordinates.u;
+        float t1 = v1.textureCoordinates.v - v0.textureCoordinates.v;
+        float s2 = v2.textureCoordinates.u - v0.textureCoordinates.u;
+        float t2 = v2.textureCoordinates.v - v0.textureCoordinates.v;
+
+        // Twice the signed area of the triangle in texture space.
+        float signedArea = s1 * t2 - t1 * s2;
+        bool orientationPreserving = signedArea > 0.0f;
+
+        // Dividing by the area, as MikkTSpace does, flips the tangent of
+        // mirrored triangles so that it points along +u; only its direction
+        // is used, so the sign of the area is enough.
+        const float sign = signedArea < 0.0f ? -1.0f : 1.0f;
+        Point3D tangent(sign * (t2 * edge1.x - t1 * edge2.x),
+                        sign * (t2 * edge1.y - t1 * edge2.y),
+                        sign * (t2 * edge1.z - t1 * edge2.z));
+
+        Point3D faceNormal = Cross(edge1, edge2);
+        Normalise(&faceNormal);
+
+        for (size_t i = 0; i < 3; ++i) {
+            const size_t corner = triangle.corners[i];
+            const size_t previous = triangle.corners[(i + 2) % 3];
+            const size_t next = triangle.corners[(i + 1) % 3];
+            const PolygonalFaceElement& element = *elements[corner];
+            Point3D normal = cornerNormal(corner, faceNormal);
+
+            CornerKey key;
+            key.vertex = element.vertex;
+            key.texture = element.texture;
+            key.normal[0] = FloatBits(normal.x);
+            key.normal[1] = FloatBits(normal.y);
+            key.normal[2] = FloatBits(normal.z);
+            key.orientationPreserving = orientationPreserving;
+
+            auto [it, inserted] = groups.try_emplace(key,
+                                                     groupTangents.size());
+            if (inserted) {
+                groupTangents.emplace_back(0.0f, 0.0f, 0.0f);
+            }
+
+            // A quad corner shared by both of its triangles takes the group
+            // of the first one.
+            if (cornerGroup[corner] == noGroup) {
+                cornerGroup[corner] = it->second;
+                cornerOrientation[corner] = orientationPreserving;
+            }
+
+            if (signedArea == 0.0f) {
+                continue;
+            }
+
+            Point3D projected = Project(tangent, normal);
+            if (!Normalise(&projected)) {
+                continue;
+            }
+
+            Point3D toNext = Project(Subtract(vertices[next].position,
+                                              vertices[corner].position),
+                                     normal);
+            Point3D toPrevious = Project(Subtract(vertices[previous].position,
+                                                  vertices[corner].position),
+                                         normal);
+
+            if (!Normalise(&toNext) || !Normalise(&toPrevious)) {
+                continue;
+            }
+
+            float angle = std::acos(std::clamp(Dot(toNext, toPrevious),
+                                               -1.0f, 1.0f));
+
+            Point3D& sum = groupTangents[it->second];
+            sum.x += projected.x * angle;
+            sum.y += projected.y * angle;
+            sum.z += projected.z * angle;
+        }
+    }
+
+    mesh->tangents.assign(vertices.size(), Point4D(0.0f, 0.0f, 0.0f, 1.0f));
+
+    for (size_t corner = 0; corner < vertices.size(); ++corner) {
+        // Corners of faces with fewer than three elements have no triangle.
+        if (cornerGroup[corner] == noGroup) {
+            continue;
+        }
+
+        Point3D normal = vertices[corner].normal;
+        Point3D tangent = groupTangents[cornerGroup[corner]];
+
+        if (!Normalise(&tangent)) {
+            tangent = Normalise(&normal) ? AnyPerpendicular(normal)
+                                         : Point3D(1.0f, 0.0f, 0.0f);
+        }
+
+        mesh->tangents[corner] = Point4D(tangent.x, tangent.y, tangent.z,
+            cornerOrientation[corner] ? 1.0f : -1.0f);
+    }
+
+    return true;
+}
+
+}   // namespace Meshborn
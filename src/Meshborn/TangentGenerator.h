@@ -0,0 +1,63 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef TANGENTGENERATOR_H_
+#define TANGENTGENERATOR_H_
+#include "Mesh.h"
+#include "Model.h"
+
+namespace Meshborn {
+
+/**
+ * Settings controlling tangent frame generation.
+ */
+struct TangentGenerationOptions {
+    TangentGenerationOptions() : bumpMappedOnly(true), threadCount(0) {}
+
+    // Only generate tangents for meshes whose material has a bump map.
+    bool bumpMappedOnly;
+
+    // Maximum worker threads, 0 selects the hardware default.
+    unsigned int threadCount;
+};
+
+/**
+ * Generates per-vertex tangent frames following the MikkTSpace conventions.
+ *
+ * Tangents are derived from the texture coordinates of each triangle,
+ * projected onto the plane of the vertex normal and accumulated with angle
+ * weighting over the corners that share a position, normal, texture
+ * coordinate and handedness. Quads are split along the shorter texture
+ * space diagonal as MikkTSpace does.
+ */
+class TangentGenerator {
+ public:
+    TangentGenerator();
+
+    explicit TangentGenerator(const TangentGenerationOptions& options);
+
+    bool Generate(Model *model);
+
+    bool Generate(Mesh *mesh);
+
+ private:
+    TangentGenerationOptions options_;
+};
+
+}   // namespace Meshborn
+
+#endif  // TANGENTGENERATOR_H_
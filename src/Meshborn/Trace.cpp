@@ -0,0 +1,352 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <atomic>
+#include <chrono>   // NOLINT
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>    // NOLINT
+#include <string>
+#include <vector>
+#include "LoggerManager.h"
+#include "Trace.h"
+#include "TraceRecorder.h"
+
+namespace Meshborn {
+
+namespace {
+
+// Spans held by each block of a thread's buffer.
+const size_t TRACE_BLOCK_EVENTS = 4096;
+
+struct TraceEvent {
+    const char *name;
+    const char *category;
+    int64_t start;
+    int64_t duration;
+};
+
+/**
+ * Fixed-size run of events. Only the owning thread appends, publishing each
+ * event through count, so the writer can read a block while it fills.
+ */
+struct TraceBlock {
+    TraceBlock() : count(0), next(nullptr) {}
+
+    TraceEvent events[TRACE_BLOCK_EVENTS];
+    std::atomic<size_t> count;
+    std::atomic<TraceBlock *> next;
+};
+
+/**
+ * Events recorded by one thread at a time. Buffers outlive their threads
+ * and are handed on to new threads, which then share the thread id shown
+ * in the trace.
+ */
+class TraceBuffer {
+ public:
+    explicit TraceBuffer(uint32_t threadId)
+        : threadId_(threadId), generation_(0),
+          head_(std::make_unique<TraceBlock>()), tail_(head_.get()) {}
+
+    ~TraceBuffer() {
+        Clear();
+    }
+
+    void Append(const TraceEvent& event, uint32_t generation) {
+        // Spans from an earlier trace are discarded by the owning thread
+        // itself, so no other thread ever has to modify the buffer.
+        if (generation_.load(std::memory_order_relaxed) != generation) {
+            Clear();
+            generation_.store(generation, std::memory_order_release);
+        }
+
+        size_t count = tail_->count.load(std::memory_order_relaxed);
+
+        if (count == TRACE_BLOCK_EVENTS) {
+            TraceBlock *block = new TraceBlock();
+            tail_->next.store(block, std::memory_order_release);
+            tail_ = block;
+            count = 0;
+        }
+
+        tail_->events[count] = event;
+        tail_->count.store(count + 1, std::memory_order_release);
+    }
+
+    template <typename Visitor>
+    void ForEach(uint32_t generation, const Visitor& visitor) const {
+        if (generation_.load(std::memory_order_acquire) != generation) {
+            return;
+        }
+
+        for (const TraceBlock *block = head_.get(); block;
+             block = block->next.load(std::memory_order_acquire)) {
+            const size_t count = block->count.load(
+                std::memory_order_acquire);
+
+            for (size_t i = 0; i < count; ++i) {
+                visitor(block->events[i]);
+            }
+        }
+    }
+
+    uint32_t GetThreadId() const {
+        return threadId_;
+    }
+
+ private:
+    void Clear() {
+        TraceBlock *block = head_->next.load(std::memory_order_relaxed);
+
+        while (block) {
+            TraceBlock *next = block->next.load(std::memory_order_relaxed);
+            delete block;
+            block = next;
+        }
+
+        head_->next.store(nullptr, std::memory_order_relaxed);
+        head_->count.store(0, std::memory_order_relaxed);
+        tail_ = head_.get();
+    }
+
+    uint32_t threadId_;
+    std::atomic<uint32_t> generation_;
+    std::unique_ptr<TraceBlock> head_;
+    TraceBlock *tail_;
+};
+
+/**
+ * Owns every thread's buffer. The mutex is only taken when a thread
+ * records its first span, when it exits and when the trace is written.
+ */
+class TraceRegistry {
+ public:
+    TraceRegistry() : enabled(false), generation(1), startTime(0),
+                      listener(nullptr) {}
+
+    TraceBuffer *Acquire() {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (!freeBuffers.empty()) {
+            TraceBuffer *buffer = freeBuffers.back();
+            freeBuffers.pop_back();
+            return buffer;
+        }
+
+        buffers.push_back(std::make_unique<TraceBuffer>(
+            static_cast<uint32_t>(buffers.size() + 1)));
+        return buffers.back().get();
+    }
+
+    void Release(TraceBuffer *buffer) {
+        std::lock_guard<std::mutex> lock(mutex);
+        freeBuffers.push_back(buffer);
+    }
+
+    std::atomic<bool> enabled;
+    std::atomic<uint32_t> generation;
+    std::atomic<int64_t> startTime;
+
+    // Owned by ownedListener, read without the mutex on every span.
+    std::atomic<ITraceListener *> listener;
+    std::unique_ptr<ITraceListener> ownedListener;
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<TraceBuffer>> buffers;
+    std::vector<TraceBuffer *> freeBuffers;
+};
+
+TraceRegistry& GetRegistry() {
+    // Never destroyed, so threads still running at exit can record safely.
+    static TraceRegistry *registry = new TraceRegistry();
+    return *registry;
+}
+
+/**
+ * Hands the thread's buffer back to the registry when the thread exits.
+ */
+struct ThreadTraceBuffer {
+    ThreadTraceBuffer() : buffer(nullptr) {}
+
+    ~ThreadTraceBuffer() {
+        if (buffer) {
+            GetRegistry().Release(buffer);
+        }
+    }
+
+    TraceBuffer *buffer;
+};
+
+thread_local ThreadTraceBuffer threadBuffer;
+
+int64_t GetTraceClock() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}   // namespace
+
+TraceScope::TraceScope(const char *name, const char *category)
+    : name_(nullptr), category_(category), start_(0), recorded_(false) {
+    TraceRegistry& registry = GetRegistry();
+    ITraceListener *listener = registry.listener.load(
+        std::memory_order_acquire);
+
+    recorded_ = registry.enabled.load(std::memory_order_relaxed);
+
+    if (recorded_ || listener) {
+        name_ = name;
+    }
+
+    if (listener) {
+        listener->OnSpanBegin(name_, category_);
+    }
+
+    // Read last, so the span does not include the listener.
+    if (recorded_) {
+        start_ = GetTraceClock();
+    }
+}
+
+/**
+ * Ends the span, once, recording it in the calling thread's buffer and
+ * reporting it to the trace listener.
+ */
+void TraceScope::End() {
+    if (!name_) {
+        return;
+    }
+
+    TraceRegistry& registry = GetRegistry();
+    const TraceEvent event = {
+        name_, category_, start_, recorded_ ? GetTraceClock() - start_ : 0
+    };
+    ITraceListener *listener = registry.listener.load(
+        std::memory_order_acquire);
+    name_ = nullptr;
+
+    if (listener) {
+        listener->OnSpanEnd(event.name, event.category);
+    }
+
+    if (!recorded_) {
+        return;
+    }
+
+    if (!threadBuffer.buffer) {
+        threadBuffer.buffer = registry.Acquire();
+    }
+
+    threadBuffer.buffer->Append(
+        event, registry.generation.load(std::memory_order_relaxed));
+}
+
+void StartTrace() {
+    TraceRegistry& registry = GetRegistry();
+    registry.generation.fetch_add(1, std::memory_order_relaxed);
+    registry.startTime.store(GetTraceClock(), std::memory_order_relaxed);
+    registry.enabled.store(true, std::memory_order_release);
+}
+
+void StopTrace() {
+    GetRegistry().enabled.store(false, std::memory_order_release);
+}
+
+bool IsTracing() {
+    return GetRegistry().enabled.load(std::memory_order_relaxed);
+}
+
+void SetTraceListener(std::unique_ptr<ITraceListener> listener) {
+    TraceRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    registry.listener.store(listener.get(), std::memory_order_release);
+    registry.ownedListener = std::move(listener);
+}
+
+/**
+ * Writes the recorded spans as Chrome trace-event JSON.
+ *
+ * Each span becomes a complete ('X') event with its start and duration in
+ * microseconds from StartTrace(), on the lane of the thread buffer that
+ * recorded it. Spans may still be recorded while the file is written;
+ * those that complete afterwards are left out.
+ *
+ * @param filename Path of the file to write.
+ * @return true if the file was written, false if it could not be.
+ */
+bool WriteTrace(const std::string& filename) {
+    std::ofstream file(filename, std::ios::binary);
+
+    if (!file.is_open()) {
+        LOG(Logger::LogLevel::Critical, std::format(
+            "Cannot open trace file '{}'", filename));
+        return false;
+    }
+
+    TraceRegistry& registry = GetRegistry();
+    const uint32_t generation = registry.generation.load(
+        std::memory_order_relaxed);
+    const int64_t startTime = registry.startTime.load(
+        std::memory_order_relaxed);
+    std::string json = "{\"traceEvents\":[\n";
+    size_t events = 0;
+
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    for (const auto& buffer : registry.buffers) {
+        const uint32_t threadId = buffer->GetThreadId();
+
+        json += std::format(
+            "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+            "\"tid\":{},\"args\":{{\"name\":\"Meshborn thread {}\"}}}},\n",
+            threadId, threadId);
+
+        buffer->ForEach(generation, [&](const TraceEvent& event) {
+            json += std::format(
+                "{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\","
+                "\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{}}},\n",
+                event.name, event.category,
+                (event.start - startTime) / 1000.0,
+                event.duration / 1000.0, threadId);
+            events++;
+        });
+    }
+
+    // JSON has no trailing commas.
+    if (json.ends_with(",\n")) {
+        json.resize(json.size() - 2);
+        json += "\n";
+    }
+
+    json += "],\"displayTimeUnit\":\"ms\"}\n";
+    file.write(json.data(), static_cast<std::streamsize>(json.size()));
+
+    if (!file) {
+        LOG(Logger::LogLevel::Critical, std::format(
+            "Failed to write trace file '{}'", filename));
+        return false;
+    }
+
+    LOG(Logger::LogLevel::Debug, std::format(
+        "TRACE => {} spans written to {}", events, filename));
+    return true;
+}
+
+}   // namespace Meshborn
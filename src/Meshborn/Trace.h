@@ -0,0 +1,76 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef TRACE_H_
+#define TRACE_H_
+#include <memory>
+#include <string>
+
+namespace Meshborn {
+
+/**
+ * Receives the begin and end of every trace span, on the thread running
+ * it, e.g. to read hardware counters around each stage of a load. Spans
+ * nest, and those named "ParallelChunk" run on worker threads.
+ */
+class ITraceListener {
+ public:
+    virtual ~ITraceListener() = default;
+    virtual void OnSpanBegin(const char *name, const char *category) = 0;
+    virtual void OnSpanEnd(const char *name, const char *category) = 0;
+};
+
+/**
+ * Starts recording trace spans, discarding any recorded earlier.
+ *
+ * Spans cover file reads, material libraries, line parsing, finalisation,
+ * each post-processing step and the chunks run on worker threads. They are
+ * kept in per-thread buffers, so recording does not take locks. Call this
+ * between loads, not while another thread is parsing.
+ */
+void StartTrace();
+
+/**
+ * Stops recording trace spans. Spans already recorded are kept.
+ */
+void StopTrace();
+
+/**
+ * @return true if trace spans are being recorded.
+ */
+bool IsTracing();
+
+/**
+ * Writes the recorded spans as Chrome trace-event JSON, which can be opened
+ * in Perfetto or chrome://tracing.
+ *
+ * @param filename Path of the file to write.
+ * @return true if the file was written, false if it could not be.
+ */
+bool WriteTrace(const std::string& filename);
+
+/**
+ * Sets the listener told about each span, whether or not a trace is being
+ * recorded, or removes it when null. Call this between loads.
+ *
+ * @param listener The new listener, or nullptr.
+ */
+void SetTraceListener(std::unique_ptr<ITraceListener> listener);
+
+}   // namespace Meshborn
+
+#endif  // TRACE_H_
@@ -0,0 +1,55 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef TRACERECORDER_H_
+#define TRACERECORDER_H_
+#include <cstdint>
+
+namespace Meshborn {
+
+/**
+ * Records the span from construction to End(), or the end of the scope,
+ * while tracing is enabled, and reports it to any trace listener. Names
+ * and categories must be string literals, as only the pointers are stored.
+ */
+class TraceScope {
+ public:
+    TraceScope(const char *name, const char *category);
+
+    ~TraceScope() {
+        End();
+    }
+
+    void End();
+
+ private:
+    const char *name_;
+    const char *category_;
+    int64_t start_;
+    bool recorded_;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+// Traces the rest of the enclosing scope.
+#define TRACE_SCOPE(name, category)                                     \
+    TraceScope TRACE_CONCAT(traceScope, __LINE__)((name), (category))
+
+}   // namespace Meshborn
+
+#endif  // TRACERECORDER_H_
@@ -0,0 +1,570 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <mutex>
+#include <vector>
+#include "LoggerManager.h"
+#include "Parallel.h"
+#include "VertexEncoder.h"
+
+namespace Meshborn {
+
+namespace {
+
+// Number of vertices handed to a worker thread in one chunk.
+const size_t ENCODE_GRAIN_SIZE = 16384;
+
+// Largest finite half float.
+const float HALF_MAX = 65504.0f;
+
+const float UNORM16_MAX = 65535.0f;
+const float SNORM16_MAX = 32767.0f;
+
+const float DEGREES_PER_RADIAN = 57.2957795f;
+
+/**
+ * Converts a float to a half float, rounding to nearest even. Values too
+ * large for a half become infinity.
+ */
+uint16_t FloatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t exponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if (exponent == 0xFFu) {
+        return static_cast<uint16_t>(sign | 0x7C00u |
+                                     (mantissa ? 0x200u : 0u));
+    }
+
+    const int halfExponent = static_cast<int>(exponent) - 127 + 15;
+
+    if (halfExponent >= 31) {
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+
+    if (halfExponent <= 0) {
+        if (halfExponent < -10) {
+            return static_cast<uint16_t>(sign);
+        }
+
+        // Subnormal half, shift in the implicit leading bit.
+        mantissa |= 0x800000u;
+        const int shift = 14 - halfExponent;
+        uint32_t half = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+
+        if (remainder > halfway || (remainder == halfway && (half & 1u))) {
+            ++half;
+        }
+
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    uint32_t half = (static_cast<uint32_t>(halfExponent) << 10) |
+                    (mantissa >> 13);
+    const uint32_t remainder = mantissa & 0x1FFFu;
+
+    // A carry out of the mantissa correctly bumps the exponent.
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+        ++half;
+    }
+
+    return static_cast<uint16_t>(sign | half);
+}
+
+float HalfToFloat(uint16_t half) {
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1Fu;
+    const uint32_t mantissa = half & 0x3FFu;
+
+    if (exponent == 0) {
+        float value = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -value : value;
+    }
+
+    uint32_t bits;
+    if (exponent == 31) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint16_t EncodeUnorm16(float value, float offset, float scale) {
+    if (!(scale > 0.0f)) {
+        return 0;
+    }
+
+    float normalised = std::clamp((value - offset) / scale, 0.0f, 1.0f);
+    return static_cast<uint16_t>(std::lround(normalised * UNORM16_MAX));
+}
+
+float DecodeUnorm16(uint16_t value, float offset, float scale) {
+    return offset + static_cast<float>(value) / UNORM16_MAX * scale;
+}
+
+float SignNotZero(float value) {
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+/**
+ * Maps a normal onto the octahedron, unfolding the lower half over the
+ * corners, and stores it as two signed normalised 16-bit values. A zero
+ * normal decodes as +Z.
+ */
+void EncodeOctahedral(const Point3D& normal, int16_t encoded[2]) {
+    const float length = std::fabs(normal.x) + std::fabs(normal.y) +
+                         std::fabs(normal.z);
+
+    if (!(length > 0.0f)) {
+        encoded[0] = 0;
+        encoded[1] = 0;
+        return;
+    }
+
+    float x = normal.x / length;
+    float y = normal.y / length;
+
+    if (normal.z < 0.0f) {
+        const float foldedX = (1.0f - std::fabs(y)) * SignNotZero(x);
+        const float foldedY = (1.0f - std::fabs(x)) * SignNotZero(y);
+        x = foldedX;
+        y = foldedY;
+    }
+
+    encoded[0] = static_cast<int16_t>(
+        std::lround(std::clamp(x, -1.0f, 1.0f) * SNORM16_MAX));
+    encoded[1] = static_cast<int16_t>(
+        std::lround(std::clamp(y, -1.0f, 1.0f) * SNORM16_MAX));
+}
+
+Point3D DecodeOctahedral(const int16_t encoded[2]) {
+    float x = std::max(static_cast<float>(encoded[0]) / SNORM16_MAX, -1.0f);
+    float y = std::max(static_cast<float>(encoded[1]) / SNORM16_MAX, -1.0f);
+    const float z = 1.0f - std::fabs(x) - std::fabs(y);
+
+    if (z < 0.0f) {
+        const float unfoldedX = (1.0f - std::fabs(y)) * SignNotZero(x);
+        const float unfoldedY = (1.0f - std::fabs(x)) * SignNotZero(y);
+        x = unfoldedX;
+        y = unfoldedY;
+    }
+
+    const float length = std::sqrt(x * x + y * y + z * z);
+    return Point3D(x / length, y / length, z / length);
+}
+
+void EncodeVertex(const Vertex& vertex, const VertexEncodingOptions& options,
+                  const EncodedVertexLayout& layout, const EncodedMesh& mesh,
+                  uint8_t *output) {
+    const float position[3] = {
+        vertex.position.x, vertex.position.y, vertex.position.z
+    };
+    const float offset[3] = {
+        mesh.positionOffset.x, mesh.positionOffset.y, mesh.positionOffset.z
+    };
+    const float scale[3] = {
+        mesh.positionScale.x, mesh.positionScale.y, mesh.positionScale.z
+    };
+
+    uint8_t *target = output + layout.positionOffset;
+
+    if (options.position == PositionEncoding::FLOAT32) {
+        std::memcpy(target, position, sizeof(position));
+    } else {
+        uint16_t encoded[3];
+        for (int i = 0; i < 3; ++i) {
+            encoded[i] = options.position == PositionEncoding::HALF ?
+                FloatToHalf(position[i] - offset[i]) :
+                EncodeUnorm16(position[i], offset[i], scale[i]);
+        }
+        std::memcpy(target, encoded, sizeof(encoded));
+    }
+
+    target = output + layout.normalOffset;
+
+    if (options.normal == NormalEncoding::FLOAT32) {
+        const float normal[3] = {
+            vertex.normal.x, vertex.normal.y, vertex.normal.z
+        };
+        std::memcpy(target, normal, sizeof(normal));
+    } else {
+        int16_t encoded[2];
+        EncodeOctahedral(vertex.normal, encoded);
+        std::memcpy(target, encoded, sizeof(encoded));
+    }
+
+    const float coordinates[2] = {
+        vertex.textureCoordinates.u, vertex.textureCoordinates.v
+    };
+    target = output + layout.textureCoordinatesOffset;
+
+    if (options.textureCoordinates == TextureCoordinateEncoding::FLOAT32) {
+        std::memcpy(target, coordinates, sizeof(coordinates));
+    } else if (options.textureCoordinates ==
+               TextureCoordinateEncoding::HALF) {
+        const uint16_t encoded[2] = {
+            FloatToHalf(coordinates[0]), FloatToHalf(coordinates[1])
+        };
+        std::memcpy(target, encoded, sizeof(encoded));
+    } else {
+        const uint16_t encoded[2] = {
+            EncodeUnorm16(coordinates[0], mesh.textureCoordinatesOffset.u,
+                          mesh.textureCoordinatesScale.u),
+            EncodeUnorm16(coordinates[1], mesh.textureCoordinatesOffset.v,
+                          mesh.textureCoordinatesScale.v)
+        };
+        std::memcpy(target, encoded, sizeof(encoded));
+    }
+}
+
+void DecodeVertex(const uint8_t *input, const VertexEncodingOptions& options,
+                  const EncodedVertexLayout& layout, const EncodedMesh& mesh,
+                  Vertex *vertex) {
+    const uint8_t *source = input + layout.positionOffset;
+    float position[3];
+
+    if (options.position == PositionEncoding::FLOAT32) {
+        std::memcpy(position, source, sizeof(position));
+    } else {
+        const float offset[3] = {
+            mesh.positionOffset.x, mesh.positionOffset.y,
+            mesh.positionOffset.z
+        };
+        const float scale[3] = {
+            mesh.positionScale.x, mesh.positionScale.y, mesh.positionScale.z
+        };
+        uint16_t encoded[3];
+        std::memcpy(encoded, source, sizeof(encoded));
+
+        for (int i = 0; i < 3; ++i) {
+            position[i] = options.position == PositionEncoding::HALF ?
+                offset[i] + HalfToFloat(encoded[i]) :
+                DecodeUnorm16(encoded[i], offset[i], scale[i]);
+        }
+    }
+
+    vertex->position = Point4D(position[0], position[1], position[2], 1.0f);
+
+    source = input + layout.normalOffset;
+
+    if (options.normal == NormalEncoding::FLOAT32) {
+        float normal[3];
+        std::memcpy(normal, source, sizeof(normal));
+        vertex->normal = Point3D(normal[0], normal[1], normal[2]);
+    } else {
+        int16_t encoded[2];
+        std::memcpy(encoded, source, sizeof(encoded));
+        vertex->normal = DecodeOctahedral(encoded);
+    }
+
+    source = input + layout.textureCoordinatesOffset;
+    float coordinates[2];
+
+    if (options.textureCoordinates == TextureCoordinateEncoding::FLOAT32) {
+        std::memcpy(coordinates, source, sizeof(coordinates));
+    } else {
+        uint16_t encoded[2];
+        std::memcpy(encoded, source, sizeof(encoded));
+
+        if (options.textureCoordinates == TextureCoordinateEncoding::HALF) {
+            coordinates[0] = HalfToFloat(encoded[0]);
+            coordinates[1] = HalfToFloat(encoded[1]);
+        } else {
+            coordinates[0] = DecodeUnorm16(encoded[0],
+                                           mesh.textureCoordinatesOffset.u,
+                                           mesh.textureCoordinatesScale.u);
+            coordinates[1] = DecodeUnorm16(encoded[1],
+                                           mesh.textureCoordinatesOffset.v,
+                                           mesh.textureCoordinatesScale.v);
+        }
+    }
+
+    vertex->textureCoordinates = TextureCoordinates(coordinates[0],
+                                                    coordinates[1], 0.0f);
+}
+
+float Distance(const Point4D& a, const Point4D& b) {
+    const float dx = a.x - b.x;
+    const float dy = a.y - b.y;
+    const float dz = a.z - b.z;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+float AngleDegrees(const Point3D& a, const Point3D& b) {
+    const float lengths = std::sqrt((a.x * a.x + a.y * a.y + a.z * a.z) *
+                                    (b.x * b.x + b.y * b.y + b.z * b.z));
+    if (!(lengths > 0.0f)) {
+        return 0.0f;
+    }
+
+    const float cosine = (a.x * b.x + a.y * b.y + a.z * b.z) / lengths;
+    return std::acos(std::clamp(cosine, -1.0f, 1.0f)) * DEGREES_PER_RADIAN;
+}
+
+}   // namespace
+
+VertexEncoder::VertexEncoder() {
+}
+
+VertexEncoder::VertexEncoder(const VertexEncodingOptions& options)
+    : options_(options) {
+}
+
+/**
+ * Returns the vertex layout produced by a set of encodings.
+ */
+EncodedVertexLayout VertexEncoder::GetLayout(
+    const VertexEncodingOptions& options) {
+    EncodedVertexLayout layout;
+
+    layout.positionOffset = 0;
+    layout.normalOffset =
+        options.position == PositionEncoding::FLOAT32 ? 12 : 8;
+    layout.textureCoordinatesOffset = layout.normalOffset +
+        (options.normal == NormalEncoding::FLOAT32 ? 12 : 4);
+    layout.stride = layout.textureCoordinatesOffset +
+        (options.textureCoordinates ==
+            TextureCoordinateEncoding::FLOAT32 ? 8 : 4);
+
+    return layout;
+}
+
+/**
+ * Encodes the vertices of every mesh in a model.
+ *
+ * Meshes are written in model order, reading the shared vertex buffer when
+ * the model has been consolidated. Quantisation ranges are taken per mesh:
+ * positions from the mesh bounding box and, for unorm16, texture
+ * coordinates from their range in the mesh. Every vertex is decoded again
+ * to measure the largest error of each attribute, which is stored in the
+ * buffer and logged.
+ *
+ * @param model The model to encode; its meshes must be finalised.
+ * @param buffer Receives the encoded vertices.
+ * @return true on success, false if a value is out of range for a half
+ *         float encoding.
+ */
+bool VertexEncoder::Encode(const Model& model, EncodedVertexBuffer *buffer) {
+    if (!buffer) {
+        LOG(Logger::LogLevel::Critical,
+            "Invalid buffer passed to VertexEncoder");
+        return false;
+    }
+
+    const size_t meshCount = model.meshes.size();
+    std::vector<const Vertex *> sources(meshCount);
+
+    buffer->encoding = options_;
+    buffer->layout = GetLayout(options_);
+    buffer->meshes.assign(meshCount, EncodedMesh());
+    buffer->error = VertexEncodingError();
+
+    size_t vertexCount = 0;
+
+    for (size_t m = 0; m < meshCount; ++m) {
+        const Mesh& mesh = model.meshes[m];
+        EncodedMesh& encoded = buffer->meshes[m];
+
+        if (model.consolidated) {
+            if (mesh.vertexOffset + mesh.vertexCount >
+                model.vertexBuffer.size()) {
+                LOG(Logger::LogLevel::Critical, std::format(
+                    "Mesh '{}' does not match its vertex range, unable to "
+                    "encode it", mesh.name));
+                return false;
+            }
+
+            sources[m] = model.vertexBuffer.data() + mesh.vertexOffset;
+            encoded.vertexCount = mesh.vertexCount;
+        } else {
+            sources[m] = mesh.vertices.data();
+            encoded.vertexCount = mesh.vertices.size();
+        }
+
+        encoded.vertexOffset = vertexCount;
+        vertexCount += encoded.vertexCount;
+
+        const AxisAlignedBoundingBox box =
+            ComputeBoundingBox(sources[m], encoded.vertexCount);
+
+        if (box.IsEmpty()) {
+            encoded.positionOffset = Point3D(0.0f, 0.0f, 0.0f);
+            encoded.positionScale = Point3D(0.0f, 0.0f, 0.0f);
+        } else if (options_.position == PositionEncoding::HALF) {
+            encoded.positionOffset = box.Centre();
+            encoded.positionScale = Point3D(1.0f, 1.0f, 1.0f);
+        } else if (options_.position == PositionEncoding::UNORM16) {
+            encoded.positionOffset = box.min;
+            encoded.positionScale = Point3D(box.max.x - box.min.x,
+                                            box.max.y - box.min.y,
+                                            box.max.z - box.min.z);
+        } else {
+            encoded.positionOffset = Point3D(0.0f, 0.0f, 0.0f);
+            encoded.positionScale = Point3D(1.0f, 1.0f, 1.0f);
+        }
+
+        if (options_.textureCoordinates ==
+                TextureCoordinateEncoding::UNORM16 &&
+            encoded.vertexCount > 0) {
+            TextureCoordinates low = sources[m][0].textureCoordinates;
+            TextureCoordinates high = low;
+
+            for (size_t i = 1; i < encoded.vertexCount; ++i) {
+                const TextureCoordinates& uv =
+                    sources[m][i].textureCoordinates;
+                low.u = std::min(low.u, uv.u);
+                low.v = std::min(low.v, uv.v);
+                high.u = std::max(high.u, uv.u);
+                high.v = std::max(high.v, uv.v);
+            }
+
+            encoded.textureCoordinatesOffset =
+                TextureCoordinates(low.u, low.v, 0.0f);
+            encoded.textureCoordinatesScale =
+                TextureCoordinates(high.u - low.u, high.v - low.v, 0.0f);
+        }
+    }
+
+    const EncodedVertexLayout layout = buffer->layout;
+    buffer->data.assign(vertexCount * layout.stride, 0);
+
+    std::vector<size_t> meshStarts(meshCount);
+    for (size_t m = 0; m < meshCount; ++m) {
+        meshStarts[m] = buffer->meshes[m].vertexOffset;
+    }
+
+    std::atomic<bool> inRange = true;
+    std::mutex errorMutex;
+
+    ParallelFor(vertexCount, ENCODE_GRAIN_SIZE,
+                [&](size_t begin, size_t end) {
+        // Find the mesh holding the first vertex of the chunk, skipping
+        // empty meshes that share its start.
+        size_t m = std::upper_bound(meshStarts.begin(), meshStarts.end(),
+                                    begin) - meshStarts.begin() - 1;
+        VertexEncodingError error;
+
+        for (size_t i = begin; i < end; ++i) {
+            while (i >= buffer->meshes[m].vertexOffset +
+                        buffer->meshes[m].vertexCount) {
+                ++m;
+            }
+
+            const EncodedMesh& mesh = buffer->meshes[m];
+            const Vertex& source = sources[m][i - mesh.vertexOffset];
+            uint8_t *output = buffer->data.data() + i * layout.stride;
+
+            EncodeVertex(source, options_, layout, mesh, output);
+
+            Vertex decoded;
+            DecodeVertex(output, options_, layout, mesh, &decoded);
+
+            const float positionError = Distance(source.position,
+                                                 decoded.position);
+            const float uvError = std::max(
+                std::fabs(source.textureCoordinates.u -
+                          decoded.textureCoordinates.u),
+                std::fabs(source.textureCoordinates.v -
+                          decoded.textureCoordinates.v));
+
+            // Comparisons are written so that NaN and infinite errors
+            // from half float overflow are caught.
+            if (!(positionError <= HALF_MAX) || !(uvError <= HALF_MAX)) {
+                inRange = false;
+            }
+
+            error.position = std::max(error.position, positionError);
+            error.textureCoordinates = std::max(error.textureCoordinates,
+                                                uvError);
+
+            const Point3D& normal = source.normal;
+            if (normal.x != 0.0f || normal.y != 0.0f || normal.z != 0.0f) {
+                error.normalDegrees = std::max(
+                    error.normalDegrees,
+                    AngleDegrees(normal, decoded.normal));
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(errorMutex);
+        buffer->error.position = std::max(buffer->error.position,
+                                          error.position);
+        buffer->error.normalDegrees = std::max(buffer->error.normalDegrees,
+                                               error.normalDegrees);
+        buffer->error.textureCoordinates = std::max(
+            buffer->error.textureCoordinates, error.textureCoordinates);
+    }, options_.threadCount);
+
+    if (!inRange) {
+        LOG(Logger::LogLevel::Critical,
+            "Vertex values are out of range for a half float encoding");
+        return false;
+    }
+
+    LOG(Logger::LogLevel::Debug, std::format(
+        "ENCODED => {} vertices, stride {} | max error: position {}, "
+        "normal {} degrees, texture coordinates {}",
+        vertexCount, layout.stride, buffer->error.position,
+        buffer->error.normalDegrees, buffer->error.textureCoordinates));
+
+    return true;
+}
+
+/**
+ * Decodes a single vertex from an encoded buffer.
+ *
+ * @param buffer The encoded buffer.
+ * @param mesh Index of the mesh in the buffer.
+ * @param vertex Index of the vertex within the mesh.
+ * @param decoded Receives the vertex. Position w is 1 and the third texture
+ *                coordinate is 0.
+ * @return true on success, false if the mesh or vertex does not exist.
+ */
+bool VertexEncoder::Decode(const EncodedVertexBuffer& buffer, size_t mesh,
+                           size_t vertex, Vertex *decoded) {
+    if (mesh >= buffer.meshes.size() ||
+        vertex >= buffer.meshes[mesh].vertexCount) {
+        return false;
+    }
+
+    const EncodedMesh& encoded = buffer.meshes[mesh];
+    const size_t offset = (encoded.vertexOffset + vertex) *
+                          buffer.layout.stride;
+
+    if (offset + buffer.layout.stride > buffer.data.size()) {
+        return false;
+    }
+
+    DecodeVertex(buffer.data.data() + offset, buffer.encoding, buffer.layout,
+                 encoded, decoded);
+    return true;
+}
+
+}   // namespace Meshborn
@@ -0,0 +1,168 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef VERTEXENCODER_H_
+#define VERTEXENCODER_H_
+#include <cstdint>
+#include <vector>
+#include "Model.h"
+#include "Structures.h"
+
+namespace Meshborn {
+
+enum class PositionEncoding {
+    // Three 32-bit floats, 12 bytes.
+    FLOAT32,
+
+    // Three half floats relative to the mesh bounding box centre, padded to
+    // 8 bytes.
+    HALF,
+
+    // Three unsigned normalised 16-bit values across the mesh bounding box,
+    // padded to 8 bytes.
+    UNORM16
+};
+
+enum class NormalEncoding {
+    // Three 32-bit floats, 12 bytes.
+    FLOAT32,
+
+    // Octahedral mapping stored as two signed normalised 16-bit values,
+    // 4 bytes.
+    OCTAHEDRAL32
+};
+
+enum class TextureCoordinateEncoding {
+    // Two 32-bit floats, 8 bytes.
+    FLOAT32,
+
+    // Two half floats, 4 bytes.
+    HALF,
+
+    // Two unsigned normalised 16-bit values across the mesh texture
+    // coordinate range, 4 bytes.
+    UNORM16
+};
+
+/**
+ * Settings selecting the encoding of each vertex attribute.
+ */
+struct VertexEncodingOptions {
+    VertexEncodingOptions() : position(PositionEncoding::UNORM16),
+                              normal(NormalEncoding::OCTAHEDRAL32),
+                              textureCoordinates(
+                                  TextureCoordinateEncoding::HALF),
+                              threadCount(0) {}
+
+    PositionEncoding position;
+    NormalEncoding normal;
+    TextureCoordinateEncoding textureCoordinates;
+
+    // Maximum worker threads, 0 selects the hardware default.
+    unsigned int threadCount;
+};
+
+/**
+ * Byte layout of one encoded vertex. Every attribute starts on a 4-byte
+ * boundary.
+ */
+struct EncodedVertexLayout {
+    EncodedVertexLayout() : stride(0), positionOffset(0), normalOffset(0),
+                            textureCoordinatesOffset(0) {}
+
+    uint32_t stride;
+    uint32_t positionOffset;
+    uint32_t normalOffset;
+    uint32_t textureCoordinatesOffset;
+};
+
+/**
+ * The range of an encoded buffer holding one mesh, and the values needed to
+ * dequantise it: value = offset + encoded * scale, per component, where
+ * encoded is the unorm16 value divided by 65535 or the half float value.
+ * Attributes stored as 32-bit floats have an offset of 0 and scale of 1.
+ */
+struct EncodedMesh {
+    EncodedMesh() : vertexOffset(0), vertexCount(0),
+                    textureCoordinatesOffset(0.0f, 0.0f, 0.0f),
+                    textureCoordinatesScale(1.0f, 1.0f, 0.0f) {}
+
+    size_t vertexOffset;
+    size_t vertexCount;
+
+    Point3D positionOffset;
+    Point3D positionScale;
+
+    TextureCoordinates textureCoordinatesOffset;
+    TextureCoordinates textureCoordinatesScale;
+};
+
+/**
+ * The largest differences between the source and decoded vertices.
+ */
+struct VertexEncodingError {
+    VertexEncodingError() : position(0.0f), normalDegrees(0.0f),
+                            textureCoordinates(0.0f) {}
+
+    // Largest distance between a source and decoded position.
+    float position;
+
+    // Largest angle between a source and decoded normal. Unset (zero)
+    // normals are ignored.
+    float normalDegrees;
+
+    // Largest per-component texture coordinate difference.
+    float textureCoordinates;
+};
+
+/**
+ * Vertices of every mesh in a model, packed with the selected encodings.
+ */
+struct EncodedVertexBuffer {
+    VertexEncodingOptions encoding;
+    EncodedVertexLayout layout;
+    std::vector<EncodedMesh> meshes;
+    std::vector<uint8_t> data;
+    VertexEncodingError error;
+};
+
+/**
+ * Packs model vertices into compact, GPU friendly attribute encodings.
+ *
+ * Position w and the third texture coordinate are dropped. With the
+ * default encodings a 40 byte Vertex becomes 16 bytes.
+ */
+class VertexEncoder {
+ public:
+    VertexEncoder();
+
+    explicit VertexEncoder(const VertexEncodingOptions& options);
+
+    bool Encode(const Model& model, EncodedVertexBuffer *buffer);
+
+    static EncodedVertexLayout GetLayout(const VertexEncodingOptions& options);
+
+    static bool Decode(const EncodedVertexBuffer& buffer, size_t mesh,
+                       size_t vertex, Vertex *decoded);
+
+ private:
+    VertexEncodingOptions options_;
+};
+
+}   // namespace Meshborn
+
+#endif  // VERTEXENCODER_H_
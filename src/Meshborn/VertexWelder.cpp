@@ -0,0 +1,374 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <vector>
+#include "LoggerManager.h"
+#include "Parallel.h"
+#include "VertexWelder.h"
+
+namespace Meshborn {
+
+namespace {
+
+// Number of positions handed to a worker thread in one chunk.
+const size_t WELD_GRAIN_SIZE = 16384;
+
+// Cell coordinates are clamped so that extreme positions or a tiny
+// tolerance cannot overflow when neighbouring cells are computed.
+const double WELD_CELL_LIMIT = 4.0e18;
+
+int64_t GetCell(float value, double inverseCellSize) {
+    double cell = std::floor(static_cast<double>(value) * inverseCellSize);
+    return static_cast<int64_t>(std::clamp(cell, -WELD_CELL_LIMIT,
+                                           WELD_CELL_LIMIT));
+}
+
+uint64_t HashCell(int64_t x, int64_t y, int64_t z) {
+    uint64_t hash = static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ull;
+    hash ^= static_cast<uint64_t>(y) * 0xC2B2AE3D27D4EB4Full;
+    hash ^= static_cast<uint64_t>(z) * 0x165667B19E3779F9ull;
+    return hash ^ (hash >> 29);
+}
+
+struct CellEntry {
+    uint64_t key;
+    uint32_t index;
+
+    bool operator<(const CellEntry& other) const {
+        return key < other.key || (key == other.key && index < other.index);
+    }
+};
+
+/**
+ * Open addressing table from a cell key to the run of sorted entries that
+ * hold the cell's positions, so a neighbouring cell is found in constant
+ * time rather than by searching the whole entry array.
+ */
+class CellTable {
+ public:
+    explicit CellTable(const std::vector<CellEntry>& entries) {
+        size_t cellCount = 0;
+
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (i == 0 || entries[i].key != entries[i - 1].key) {
+                ++cellCount;
+            }
+        }
+
+        size_t tableSize = 16;
+        while (tableSize < cellCount * 2) {
+            tableSize *= 2;
+        }
+
+        slots_.resize(tableSize);
+        mask_ = tableSize - 1;
+
+        size_t begin = 0;
+
+        while (begin < entries.size()) {
+            size_t end = begin + 1;
+
+            while (end < entries.size() &&
+                   entries[end].key == entries[begin].key) {
+                ++end;
+            }
+
+            size_t slot = static_cast<size_t>(entries[begin].key) & mask_;
+
+            while (slots_[slot].end != 0) {
+                slot = (slot + 1) & mask_;
+            }
+
+            slots_[slot].key = entries[begin].key;
+            slots_[slot].begin = static_cast<uint32_t>(begin);
+            slots_[slot].end = static_cast<uint32_t>(end);
+            begin = end;
+        }
+    }
+
+    /**
+     * Finds the entries of a cell, an empty range if it holds no positions.
+     */
+    void Find(uint64_t key, uint32_t *begin, uint32_t *end) const {
+        size_t slot = static_cast<size_t>(key) & mask_;
+
+        while (slots_[slot].end != 0) {
+            if (slots_[slot].key == key) {
+                *begin = slots_[slot].begin;
+                *end = slots_[slot].end;
+                return;
+            }
+
+            slot = (slot + 1) & mask_;
+        }
+
+        *begin = *end = 0;
+    }
+
+ private:
+    // A slot is empty while its range ends at 0, as no cell's run can.
+    struct Slot {
+        Slot() : key(0), begin(0), end(0) {}
+
+        uint64_t key;
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    std::vector<Slot> slots_;
+    size_t mask_;
+};
+
+bool WithinTolerance(const Point4D& a, const Point4D& b,
+                     float toleranceSquared) {
+    const float ex = a.x - b.x;
+    const float ey = a.y - b.y;
+    const float ez = a.z - b.z;
+    const float ew = a.w - b.w;
+    return ex * ex + ey * ey + ez * ez + ew * ew <= toleranceSquared;
+}
+
+/**
+ * The positions being welded, bucketed by cell.
+ */
+class WeldGrid {
+ public:
+    WeldGrid(const Point4DList& positions,
+             const std::vector<CellEntry>& entries,
+             double inverseCellSize,
+             float toleranceSquared)
+        : positions_(positions), entries_(entries), cells_(entries),
+          inverseCellSize_(inverseCellSize),
+          toleranceSquared_(toleranceSquared),
+          reach_(toleranceSquared > 0.0f ? 1 : 0) {}
+
+    /**
+     * Finds the lowest indexed position before index that is within
+     * tolerance of it.
+     *
+     * @param index The position to search around.
+     * @param clusters When not null, only positions that represent their
+     *        own cluster in this table are considered.
+     * @return The position found, or index if there is none.
+     */
+    uint32_t FindFirst(uint32_t index,
+                       const std::vector<uint32_t> *clusters) const {
+        const Point4D& p = positions_[index];
+        const int64_t cx = GetCell(p.x, inverseCellSize_);
+        const int64_t cy = GetCell(p.y, inverseCellSize_);
+        const int64_t cz = GetCell(p.z, inverseCellSize_);
+        uint32_t best = index;
+
+        for (int64_t dz = -reach_; dz <= reach_; ++dz) {
+            for (int64_t dy = -reach_; dy <= reach_; ++dy) {
+                for (int64_t dx = -reach_; dx <= reach_; ++dx) {
+                    uint32_t first, last;
+                    cells_.Find(HashCell(cx + dx, cy + dy, cz + dz),
+                                &first, &last);
+
+                    // Hash collisions only add candidates; the distance
+                    // test below decides what is merged.
+                    for (uint32_t e = first;
+                         e < last && entries_[e].index < best; ++e) {
+                        const uint32_t candidate = entries_[e].index;
+
+                        if (clusters && (*clusters)[candidate] != candidate) {
+                            continue;
+                        }
+
+                        if (WithinTolerance(p, positions_[candidate],
+                                            toleranceSquared_)) {
+                            best = candidate;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        return best;
+    }
+
+ private:
+    const Point4DList& positions_;
+    const std::vector<CellEntry>& entries_;
+    const CellTable cells_;
+    double inverseCellSize_;
+    float toleranceSquared_;
+
+    // Cells searched either side of a position's own. Equal positions
+    // always share a cell, so exact welding only searches one.
+    int64_t reach_;
+};
+
+}   // namespace
+
+VertexWelder::VertexWelder() {
+}
+
+VertexWelder::VertexWelder(const VertexWeldOptions& options)
+    : options_(options) {
+}
+
+/**
+ * Welds a pool of vertex positions and remaps the faces that reference it.
+ *
+ * The first occurrence of each group of merged positions is kept, so the
+ * surviving positions stay in file order. Face indices outside the pool are
+ * left unchanged for FinaliseVertices to report.
+ *
+ * @param positions The position pool to weld in place.
+ * @param meshes Meshes whose face vertex indices refer to the pool.
+ * @return true on success, false if the pool is too large to weld.
+ */
+bool VertexWelder::Weld(Point4DList *positions, std::vector<Mesh> *meshes) {
+    std::vector<uint32_t> remap;
+    size_t uniqueCount;
+
+    if (!BuildRemap(*positions, &remap, &uniqueCount)) {
+        return false;
+    }
+
+    LOG(Logger::LogLevel::Debug, std::format(
+        "WELD => {} positions merged into {}",
+        positions->size(), uniqueCount));
+
+    if (uniqueCount == positions->size()) {
+        return true;
+    }
+
+    // Kept positions are numbered in order, so the first position with each
+    // new index is the one that survives. Its new index is never above its
+    // old one, so the pool is compacted in place and keeps its capacity.
+    size_t next = 0;
+    for (size_t i = 0; i < remap.size(); ++i) {
+        if (remap[i] == next) {
+            (*positions)[next++] = (*positions)[i];
+        }
+    }
+
+    const int positionCount = static_cast<int>(positions->size());
+
+    ParallelFor(meshes->size(), 1, [&](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; ++m) {
+            for (auto& face : (*meshes)[m].faces) {
+                for (auto& element : face.elements) {
+                    if (element.vertex >= 1 &&
+                        element.vertex <= positionCount) {
+                        element.vertex = static_cast<int>(
+                            remap[element.vertex - 1]) + 1;
+                    }
+                }
+            }
+        }
+    }, options_.threadCount);
+
+    positions->resize(uniqueCount);
+    return true;
+}
+
+/**
+ * Builds a table mapping each position to its index after welding.
+ *
+ * Cell keys are computed in parallel and sorted so that each cell's
+ * positions are contiguous and in index order, and a hash table maps each
+ * cell to its run of entries. Each position then searches its 27
+ * neighbouring cells, again in parallel, for the lowest indexed position
+ * within the tolerance. Finally a single ordered pass assigns each
+ * position to the first earlier cluster representative within tolerance,
+ * or makes it a new representative. Merging never follows a chain of
+ * nearby positions, so the result is deterministic and bounded by the
+ * tolerance. The w component counts towards the distance.
+ *
+ * @param positions The positions to weld.
+ * @param remap Receives the welded index of every position.
+ * @param uniqueCount Receives the number of positions left after welding.
+ * @return true on success, false if there are too many positions.
+ */
+bool VertexWelder::BuildRemap(const Point4DList& positions,
+                              std::vector<uint32_t> *remap,
+                              size_t *uniqueCount) {
+    const size_t count = positions.size();
+
+    if (count >= UINT32_MAX) {
+        LOG(Logger::LogLevel::Critical, std::format(
+            "Too many positions ({}) to weld", count));
+        return false;
+    }
+
+    const float tolerance = std::max(options_.tolerance, 0.0f);
+    const float toleranceSquared = tolerance * tolerance;
+    const double inverseCellSize = tolerance > 0.0f ? 1.0 / tolerance : 1.0;
+
+    std::vector<CellEntry> entries(count);
+
+    ParallelFor(count, WELD_GRAIN_SIZE, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            entries[i].key = HashCell(
+                GetCell(positions[i].x, inverseCellSize),
+                GetCell(positions[i].y, inverseCellSize),
+                GetCell(positions[i].z, inverseCellSize));
+            entries[i].index = static_cast<uint32_t>(i);
+        }
+    }, options_.threadCount);
+
+    std::sort(entries.begin(), entries.end());
+    const WeldGrid grid(positions, entries, inverseCellSize,
+                        toleranceSquared);
+
+    // The lowest indexed earlier position within tolerance of each one.
+    std::vector<uint32_t> cluster(count);
+
+    ParallelFor(count, WELD_GRAIN_SIZE, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            cluster[i] = grid.FindFirst(static_cast<uint32_t>(i), nullptr);
+        }
+    }, options_.threadCount);
+
+    remap->resize(count);
+    size_t unique = 0;
+
+    // Each position joins the first cluster whose representative is within
+    // tolerance of it, so no two merged positions are further apart than
+    // twice the tolerance. Clusters before i are final by the time it is
+    // reached, and the parallel pass already answers most positions: one
+    // with no earlier neighbour starts a cluster, and one whose nearest
+    // earlier neighbour is a representative joins it.
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t nearest = cluster[i];
+
+        if (nearest != i && cluster[nearest] != nearest) {
+            nearest = grid.FindFirst(static_cast<uint32_t>(i), &cluster);
+        }
+
+        cluster[i] = nearest;
+
+        if (nearest == i) {
+            (*remap)[i] = static_cast<uint32_t>(unique++);
+        } else {
+            (*remap)[i] = (*remap)[nearest];
+        }
+    }
+
+    *uniqueCount = unique;
+    return true;
+}
+
+}   // namespace Meshborn
@@ -0,0 +1,71 @@
+/*
+Meshborn
+Copyright (C) 2025 SwatKat1977
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef VERTEXWELDER_H_
+#define VERTEXWELDER_H_
+#include <cstdint>
+#include <vector>
+#include "Mesh.h"
+#include "Structures.h"
+
+namespace Meshborn {
+
+/**
+ * Settings controlling vertex welding.
+ */
+struct VertexWeldOptions {
+    VertexWeldOptions() : tolerance(1.0e-5f), threadCount(0) {}
+
+    // A position is merged into the first earlier kept position within
+    // this distance of it, measured over x, y, z and w. 0 only merges
+    // positions that are exactly equal.
+    float tolerance;
+
+    // Maximum worker threads, 0 selects the hardware default.
+    unsigned int threadCount;
+};
+
+/**
+ * Merges near-duplicate vertex positions, such as those left by seams and
+ * split exports, and remaps face indices to the merged positions.
+ *
+ * Positions are bucketed in a spatial hash grid with cells the size of the
+ * tolerance, so only the 27 surrounding cells are searched for each one.
+ *
+ * Welding works on the position pool and face indices only. Meshes are
+ * still finalised with one vertex per face corner; the merged corners are
+ * shared once the buffers are consolidated.
+ */
+class VertexWelder {
+ public:
+    VertexWelder();
+
+    explicit VertexWelder(const VertexWeldOptions& options);
+
+    bool Weld(Point4DList *positions, std::vector<Mesh> *meshes);
+
+    bool BuildRemap(const Point4DList& positions,
+                    std::vector<uint32_t> *remap,
+                    size_t *uniqueCount);
+
+ private:
+    VertexWeldOptions options_;
+};
+
+}   // namespace Meshborn
+
+#endif  // VERTEXWELDER_H_
@@ -15,14 +15,19 @@ GNU General Public License for more details.
 You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include <cstdint>
 #include <format>
 #include <fstream>
 #include <iostream>         /// TEMPORARY - TO BE DELETED!!!
+#include <span>
 #include <sstream>
+#include <unordered_map>
 #include <utility>
 #include "LoggerManager.h"
 #include "WaveFrontObjParser.h"
 #include "MaterialLibraryParser.h"
+#include "ParseStatsRecorder.h"
+#include "TraceRecorder.h"
 
 namespace Meshborn {
 
@@ -30,22 +35,77 @@ const char KEYWORD_GROUP[] = "g ";
 const char KEYWORD_MATERIAL_LIBRARY[] = "mtllib ";
 const char KEYWORD_OBJECT[] = "o ";
 const char KEYWORD_POLYGONAL_FACE[] = "f ";
+const char KEYWORD_SMOOTHING_GROUP[] = "s ";
 const char KEYWORD_TEXTURE_COORDINATE[] = "vt ";
 const char KEYWORD_USE_MATERIAL[] = "usemtl ";
 const char KEYWORD_VECTOR[] = "v ";
 const char KEYWORD_VECTOR_NORMAL[] = "vn ";
 
+namespace {
+
+/**
+ * Applies a context's thread count to the options of every post-processing
+ * step.
+ */
+void ApplyThreadCount(ParseOptions *options, unsigned int count) {
+    if (!count) {
+        return;
+    }
+
+    options->weldOptions.threadCount = count;
+    options->cleanupOptions.threadCount = count;
+    options->instanceOptions.threadCount = count;
+    options->spatialSortOptions.threadCount = count;
+    options->normalOptions.threadCount = count;
+    options->tangentOptions.threadCount = count;
+    options->consolidationOptions.threadCount = count;
+    options->splitOptions.threadCount = count;
+}
+
+/**
+ * Frees a context's buffers when a parse returns if they have grown past
+ * its high-water mark.
+ */
+class BufferLimitGuard {
+ public:
+    explicit BufferLimitGuard(ParseContext *context) : context_(context) {}
+
+    ~BufferLimitGuard() {
+        if (context_->buffers.GetReservedBytes() > context_->bufferLimit) {
+            context_->buffers.Release();
+        }
+    }
+
+ private:
+    ParseContext *context_;
+};
+
+}   // namespace
+
 WaveFrontObjParser::WaveFrontObjParser() {
 }
 
+WaveFrontObjParser::WaveFrontObjParser(const ParseOptions& options)
+    : context_(options) {
+}
+
 /**
  * Parses a Wavefront .obj file and fills the provided model object with data.
  *
  * Reads the specified .obj file, parsing vertex positions, normals,
  * texture coordinates, faces, groups, and objects. Meshes are created
- * based on object/group/material changes. Material libraries may also
+ * based on object/group/material changes, or with coalesceMeshes set, one
+ * per distinct object/group/material combination. Material libraries may also
  * be parsed if specified. This parser supports triangle, quad, and
- * n-gon polygonal faces.
+ * n-gon polygonal faces. Meshes are finalised once the whole file has
+ * been read, after optional vertex welding, and any further processing
+ * enabled in the parser's ParseOptions is then applied to the model.
+ * Timings and counters of the load are available from GetStats() when
+ * the library is built with MESHBORN_PARSE_STATS.
+ *
+ * The parser keeps its working buffers between calls, up to the limit set
+ * with SetBufferLimit(), so reusing one parser for many files avoids
+ * growing new buffers for each of them.
  *
  * @param filename The path to the .obj file to be parsed.
  * @param model Pointer to the Model object to populate.
@@ -53,30 +113,88 @@ WaveFrontObjParser::WaveFrontObjParser() {
  * @throws std::runtime_error if the file cannot be read.
  */
 std::unique_ptr<Model> WaveFrontObjParser::ParseObj(std::string filename) {
+    context_.stats.Reset();
+    return ParseObj(filename, &context_);
+}
+
+/**
+ * Parses a Wavefront .obj file as ParseObj(filename) does, but with the
+ * options of a context rather than the parser's, logging to the context's
+ * logger and adding timings and counters to its statistics.
+ *
+ * The parser itself is not modified, so one parser can load several files
+ * at once from different threads, each with its own context.
+ *
+ * @param filename The path to the .obj file to be parsed.
+ * @param context The options, logger and statistics of this parse.
+ * @return The parsed model, or nullptr if the context is null or any
+ *         error occurs.
+ * @throws std::runtime_error if the file cannot be read.
+ */
+std::unique_ptr<Model> WaveFrontObjParser::ParseObj(
+    std::string filename, ParseContext *context) const {
+    if (!context) {
+        LOG(Logger::LogLevel::Critical,
+            "Invalid parse context passed to ParseObj");
+        return nullptr;
+    }
+
+    Logger::ScopedThreadLogger scopedLogger(context->logger);
+    TRACE_SCOPE("ParseObj", "load");
     auto model = std::make_unique<Model>();
-    std::vector<std::string> rawLines;
+    BufferLimitGuard bufferLimit(context);
+    ParseBuffers& buffers = context->buffers;
+
+    ParseOptions options = context->options;
+    ApplyThreadCount(&options, context->threadCount);
+
+    buffers.Clear();
+    uint64_t bytesRead = 0;
 
     try {
-        rawLines = ReadFile(filename);
+        PARSE_STATS_PHASE(&context->stats, ParsePhase::READ_FILE);
+        buffers.lineCount = ReadFile(filename, &buffers.lines, &bytesRead);
     }
     catch (std::runtime_error ex) {
         throw std::runtime_error(ex.what());
     }
 
-    std::vector<Point4D> vertexPositions;
-    std::vector<Point3D> vertexNormals;
-    std::vector<TextureCoordinates> textureCoordinates;
+    const std::span<const std::string> rawLines(buffers.lines.data(),
+                                                buffers.lineCount);
+
+    PARSE_STATS(context->stats.bytesRead += bytesRead);
+
+    Point4DList& vertexPositions = buffers.positions;
+    Point3DList& vertexNormals = buffers.normals;
+    TextureCoordinatesList& textureCoordinates = buffers.textureCoordinates;
 
     std::string currentObjectName = "default";
     std::string currentGroupName = "default";
     std::string currentMaterial = "";
     std::string currentMeshName = "default:default";
+    unsigned int currentSmoothingGroup = 0;
     Mesh* currentMesh = nullptr;
 
+    // When coalescing, mesh names and materials are interned and each
+    // (name, material) pair of ids is mapped to the mesh holding its faces.
+    auto& internedStrings = buffers.internedStrings;
+    auto& meshesByKey = buffers.meshesByKey;
+    auto intern = [&internedStrings](const std::string& value) {
+        return internedStrings.try_emplace(
+            value, static_cast<uint32_t>(internedStrings.size()))
+            .first->second;
+    };
+
+    PARSE_STATS_NAMED_PHASE(parseTimer, &context->stats,
+                            ParsePhase::PARSE_LINES);
+    TraceScope parseTrace("ParseLines", "parse");
+
     for (const auto& line : rawLines) {
         std::string_view view(line);
+        PARSE_STATS_LINE_TIMER(&context->stats);
 
         if (view.starts_with(KEYWORD_GROUP)) {
+            PARSE_STATS_LINE(ParseKeyword::GROUP);
             std::string groupName;
             if (!ParseGroupElement(view, &groupName)) {
                 return nullptr;
@@ -88,6 +206,7 @@ std::unique_ptr<Model> WaveFrontObjParser::ParseObj(std::string filename) {
                 std::format("GROUP => {}", currentGroupName));
 
         } else if (view.starts_with(KEYWORD_OBJECT)) {
+            PARSE_STATS_LINE(ParseKeyword::OBJECT);
             std::string objectName;
             if (!ParseObjectElement(view, &objectName)) {
                 return nullptr;
@@ -100,35 +219,53 @@ std::unique_ptr<Model> WaveFrontObjParser::ParseObj(std::string filename) {
 
         // Polygonal face
         } else if (view.starts_with(KEYWORD_POLYGONAL_FACE)) {
+            PARSE_STATS_LINE(ParseKeyword::POLYGONAL_FACE);
+
             if (!currentMesh ||
                 currentMesh->name != currentMeshName ||
                 currentMesh->material != currentMaterial) {
-                if (currentMesh) {
-                    if (!FinaliseVertices(currentMesh,
-                        vertexPositions,
-                        vertexNormals,
-                        textureCoordinates)) {
-                        LOG(Logger::LogLevel::Debug,
-                            "Failed to finalise a mesh");
-                        return nullptr;
-                    }
+                uint64_t meshKey = 0;
+                auto existing = meshesByKey.end();
+
+                if (options.coalesceMeshes) {
+                    meshKey = (static_cast<uint64_t>(
+                        intern(currentMeshName)) << 32) |
+                        intern(currentMaterial);
+                    existing = meshesByKey.find(meshKey);
                 }
 
-                // Create an instance of Mesh class for object/group/material
-                // change.
-                Mesh newMesh;
-                newMesh.name = currentMeshName;
-                newMesh.material = currentMaterial;
+                if (existing != meshesByKey.end()) {
+                    // Resume the earlier mesh; faces are appended so they
+                    // stay in file order within it.
+                    currentMesh = &model->meshes[existing->second];
 
-                // Add the new meshes to the the model and the set the current
-                // mesh to it by getting the last element in the array.
-                model->meshes.push_back(std::move(newMesh));
-                currentMesh = &model->meshes.back();
+                    LOG(Logger::LogLevel::Debug,
+                        std::format("RESUME MESH => name: {}, material: {}",
+                            currentMesh->name,
+                            currentMesh->material));
+                } else {
+                    // Create an instance of Mesh class for
+                    // object/group/material change.
+                    Mesh newMesh;
+                    newMesh.name = currentMeshName;
+                    newMesh.material = currentMaterial;
+
+                    // Add the new meshes to the the model and the set the
+                    // current mesh to it by getting the last element in the
+                    // array.
+                    model->meshes.push_back(std::move(newMesh));
+                    currentMesh = &model->meshes.back();
+                    PARSE_STATS(context->stats.meshesCreated++);
+
+                    if (options.coalesceMeshes) {
+                        meshesByKey[meshKey] = model->meshes.size() - 1;
+                    }
 
-                LOG(Logger::LogLevel::Debug,
-                    std::format("NEW MESH => name: {}, material: {}",
-                        currentMesh->name,
-                        currentMesh->material));
+                    LOG(Logger::LogLevel::Debug,
+                        std::format("NEW MESH => name: {}, material: {}",
+                            currentMesh->name,
+                            currentMesh->material));
+                }
             }
 
             PolygonalFace face;
@@ -136,6 +273,10 @@ std::unique_ptr<Model> WaveFrontObjParser::ParseObj(std::string filename) {
                 return nullptr;
             }
 
+            face.smoothingGroup = currentSmoothingGroup;
+            PARSE_STATS(context->stats.faces[
+                static_cast<size_t>(face.faceType)]++);
+
             if (face.faceType == PolygonalFaceType::TRIANGE) {
                 LOG(Logger::LogLevel::Debug, std::format(
                     "POLYGONAL FACE [triangle] => 1 = {}/{}/{} | 2 = {}/{}/{} "
@@ -174,6 +315,7 @@ std::unique_ptr<Model> WaveFrontObjParser::ParseObj(std::string filename) {
 
         // Vertex position
         } else if (view.starts_with(KEYWORD_VECTOR)) {
+            PARSE_STATS_LINE(ParseKeyword::VECTOR);
             Point4D vertexPosition;
 
             if (!ParseVectorElement(view, &vertexPosition)) {
@@ -190,6 +332,7 @@ std::unique_ptr<Model> WaveFrontObjParser::ParseObj(std::string filename) {
 
         // Vertex normal
         } else if (view.starts_with(KEYWORD_VECTOR_NORMAL)) {
+            PARSE_STATS_LINE(ParseKeyword::VECTOR_NORMAL);
             Point3D vertexNormal;
 
             if (!ParseVertexNormalElement(view, &vertexNormal)) {
@@ -205,6 +348,7 @@ std::unique_ptr<Model> WaveFrontObjParser::ParseObj(std::string filename) {
 
         // Texture coordinate [NOT IMPLEMENTED YET!]
         } else if (view.starts_with(KEYWORD_TEXTURE_COORDINATE)) {
+            PARSE_STATS_LINE(ParseKeyword::TEXTURE_COORDINATE);
             TextureCoordinates coordinates;
             if (!ParseTextureCoordinate(view, &coordinates)) {
                 return nullptr;
@@ -219,6 +363,7 @@ std::unique_ptr<Model> WaveFrontObjParser::ParseObj(std::string filename) {
 
         // Use material
         } else if (view.starts_with(KEYWORD_USE_MATERIAL)) {
+            PARSE_STATS_LINE(ParseKeyword::USE_MATERIAL);
             std::string useMaterialName;
             if (!ParseUseMaterial(view, &useMaterialName)) {
                 return nullptr;
@@ -229,8 +374,20 @@ std::unique_ptr<Model> WaveFrontObjParser::ParseObj(std::string filename) {
             LOG(Logger::LogLevel::Debug, std::format(
                 "USE MATERIAL => {}", currentMaterial));
 
+        // Smoothing group
+        } else if (view.starts_with(KEYWORD_SMOOTHING_GROUP)) {
+            PARSE_STATS_LINE(ParseKeyword::SMOOTHING_GROUP);
+
+            if (!ParseSmoothingGroup(view, &currentSmoothingGroup)) {
+                return nullptr;
+            }
+
+            LOG(Logger::LogLevel::Debug, std::format(
+                "SMOOTHING GROUP => {}", currentSmoothingGroup));
+
         // Material library
         } else if (view.starts_with(KEYWORD_MATERIAL_LIBRARY)) {
+            PARSE_STATS_LINE(ParseKeyword::MATERIAL_LIBRARY);
             std::string materialLibrary;
 
             if (!ParseMaterials(view, &materialLibrary)) {
@@ -241,8 +398,16 @@ std::unique_ptr<Model> WaveFrontObjParser::ParseObj(std::string filename) {
             }
 
             if (!materialLibrary.empty()) {
-                if (!MaterialLibraryParser().ParseLibrary(materialLibrary,
-                                                          &model->materials)) {
+                // Material libraries are timed as their own phase.
+                PARSE_STATS(parseTimer.Pause());
+
+                MaterialLibraryParser libraryParser;
+                const bool parsed = libraryParser.ParseLibrary(
+                    materialLibrary, &model->materials, context);
+
+                PARSE_STATS(parseTimer.Resume());
+
+                if (!parsed) {
                     std::cout << "ERR parsing material library\n";
                     return nullptr;
                 }
@@ -260,12 +425,128 @@ std::unique_ptr<Model> WaveFrontObjParser::ParseObj(std::string filename) {
         }
     }
 
-    if (currentMesh) {
-        FinaliseVertices(currentMesh, vertexPositions, vertexNormals,
-                         textureCoordinates);
+    parseTrace.End();
+
+    PARSE_STATS(parseTimer.Stop());
+    PARSE_STATS(context->stats.bytesAllocated +=
+        GetLinesAllocation(buffers.lines) +
+        vertexPositions.capacity() * sizeof(Point4D) +
+        vertexNormals.capacity() * sizeof(Point3D) +
+        textureCoordinates.capacity() * sizeof(TextureCoordinates) +
+        GetFacesAllocation(model->meshes));
+
+    // Welding rewrites face indices across every mesh, so meshes are only
+    // finalised once the whole file has been read.
+    if (options.weldVertices) {
+        PARSE_STATS_PHASE(&context->stats, ParsePhase::WELD_VERTICES);
+        TRACE_SCOPE("WeldVertices", "postprocess");
+
+        if (!VertexWelder(options.weldOptions).Weld(&vertexPositions,
+                                                     &model->meshes)) {
+            LOG(Logger::LogLevel::Critical, "Failed to weld vertices");
+            return nullptr;
+        }
+    }
+
+    if (options.cleanMeshes) {
+        PARSE_STATS_PHASE(&context->stats, ParsePhase::CLEAN_MESHES);
+        TRACE_SCOPE("CleanMeshes", "postprocess");
+
+        if (!MeshCleaner(options.cleanupOptions).Clean(&vertexPositions,
+                                                        &vertexNormals,
+                                                        &textureCoordinates,
+                                                        &model->meshes)) {
+            LOG(Logger::LogLevel::Critical, "Failed to clean meshes");
+            return nullptr;
+        }
+    }
+
+    // Copies are found from their face elements and removed before
+    // finalisation, so they are never expanded into vertices and the
+    // remaining steps only process the unique geometry.
+    if (options.detectInstances) {
+        PARSE_STATS_PHASE(&context->stats, ParsePhase::DETECT_INSTANCES);
+        TRACE_SCOPE("DetectInstances", "postprocess");
+
+        InstanceDetector detector(options.instanceOptions);
+
+        if (!detector.Detect(model.get(), vertexPositions, vertexNormals,
+                             textureCoordinates)) {
+            LOG(Logger::LogLevel::Critical, "Failed to detect instances");
+            return nullptr;
+        }
+    }
+
+    PARSE_STATS_NAMED_PHASE(finaliseTimer, &context->stats,
+                            ParsePhase::FINALISE_VERTICES);
+    TraceScope finaliseTrace("FinaliseVertices", "finalise");
+
+    for (auto& mesh : model->meshes) {
+        if (!FinaliseVertices(&mesh, vertexPositions, vertexNormals,
+                              textureCoordinates)) {
+            LOG(Logger::LogLevel::Debug, "Failed to finalise a mesh");
+            return nullptr;
+        }
+    }
+
+    finaliseTrace.End();
+    PARSE_STATS(finaliseTimer.Stop());
+    PARSE_STATS(context->stats.bytesAllocated +=
+        GetVerticesAllocation(model->meshes));
+
+    if (options.spatialSort) {
+        PARSE_STATS_PHASE(&context->stats, ParsePhase::SPATIAL_SORT);
+        TRACE_SCOPE("SpatialSort", "postprocess");
+
+        if (!SpatialSorter(options.spatialSortOptions).Sort(model.get())) {
+            LOG(Logger::LogLevel::Critical, "Failed to sort the model");
+            return nullptr;
+        }
     }
 
     model->totalMeshes = model->meshes.size();
+    model->UpdateBounds();
+
+    if (options.generateNormals) {
+        PARSE_STATS_PHASE(&context->stats, ParsePhase::GENERATE_NORMALS);
+        TRACE_SCOPE("GenerateNormals", "postprocess");
+
+        if (!NormalGenerator(options.normalOptions).Generate(model.get())) {
+            LOG(Logger::LogLevel::Critical, "Failed to generate normals");
+            return nullptr;
+        }
+    }
+
+    if (options.generateTangents) {
+        PARSE_STATS_PHASE(&context->stats, ParsePhase::GENERATE_TANGENTS);
+        TRACE_SCOPE("GenerateTangents", "postprocess");
+
+        if (!TangentGenerator(options.tangentOptions).Generate(model.get())) {
+            LOG(Logger::LogLevel::Critical, "Failed to generate tangents");
+            return nullptr;
+        }
+    }
+
+    if (options.consolidateBuffers || options.splitMeshes) {
+        PARSE_STATS_PHASE(&context->stats, ParsePhase::CONSOLIDATE_BUFFERS);
+        TRACE_SCOPE("ConsolidateBuffers", "postprocess");
+
+        if (!BufferConsolidator(options.consolidationOptions).Consolidate(
+                model.get())) {
+            LOG(Logger::LogLevel::Critical, "Failed to consolidate buffers");
+            return nullptr;
+        }
+    }
+
+    if (options.splitMeshes) {
+        PARSE_STATS_PHASE(&context->stats, ParsePhase::SPLIT_MESHES);
+        TRACE_SCOPE("SplitMeshes", "postprocess");
+
+        if (!MeshSplitter(options.splitOptions).Split(model.get())) {
+            LOG(Logger::LogLevel::Critical, "Failed to split meshes");
+            return nullptr;
+        }
+    }
 
     return model;
 }
@@ -281,7 +562,7 @@ std::unique_ptr<Model> WaveFrontObjParser::ParseObj(std::string filename) {
  * @return true on success, false if input format is invalid.
  */
 bool WaveFrontObjParser::ParseGroupElement(std::string_view element,
-                                           std::string* groupName) {
+                                           std::string* groupName) const {
     auto words = SplitElementString(std::string(element));
     if (words.size() < 2) {
         LOG(Logger::LogLevel::Critical, std::format(
@@ -304,7 +585,7 @@ bool WaveFrontObjParser::ParseGroupElement(std::string_view element,
  * @return true on success, false if input format is invalid.
  */
 bool WaveFrontObjParser::ParseObjectElement(std::string_view element,
-                                            std::string* objectName) {
+                                            std::string* objectName) const {
     auto words = SplitElementString(std::string(element));
     if (words.size() < 2) {
         LOG(Logger::LogLevel::Critical, std::format(
@@ -343,7 +624,7 @@ bool WaveFrontObjParser::ParseObjectElement(std::string_view element,
  *         false otherwise.
  */
 bool WaveFrontObjParser::ParsePolygonalFaceElement(std::string_view element,
-                                                   PolygonalFace* face) {
+                                                   PolygonalFace* face) const {
     auto words = SplitElementString(std::string(element));
     if (words.size() < 4) {
         LOG(Logger::LogLevel::Critical, std::format(
@@ -423,7 +704,7 @@ bool WaveFrontObjParser::ParsePolygonalFaceElement(std::string_view element,
  * @return true on success, false if parsing fails or input is invalid.
  */
 bool WaveFrontObjParser::ParseVectorElement(std::string_view element,
-                                            Point4D* vectorElement) {
+                                            Point4D* vectorElement) const {
     auto words = SplitElementString(std::string(element));
     if ((words.size() == 4) || (words.size() == 5)) {
         float x;
@@ -470,7 +751,7 @@ bool WaveFrontObjParser::ParseVectorElement(std::string_view element,
  * @return true on success, false if parsing fails or input is invalid.
  */
 bool WaveFrontObjParser::ParseVertexNormalElement(
-    std::string_view element, Point3D* vectorNormalElement) {
+    std::string_view element, Point3D* vectorNormalElement) const {
     float x;
     float y;
     float z;
@@ -514,7 +795,7 @@ bool WaveFrontObjParser::ParseVertexNormalElement(
  *         succeeds; false otherwise.
  */
 bool WaveFrontObjParser::ParseMaterials(std::string_view element,
-                                        std::string *materialLibrary) {
+                                        std::string *materialLibrary) const {
     auto words = SplitElementString(std::string(element));
 
     // Requires 2 words (keyword and material_file)
@@ -546,7 +827,7 @@ bool WaveFrontObjParser::ParseMaterials(std::string_view element,
  * @return true on successful parse, false on format or parse error.
  */
 bool WaveFrontObjParser::ParseTextureCoordinate(
-    std::string_view element, TextureCoordinates *coordinates) {
+    std::string_view element, TextureCoordinates *coordinates) const {
     auto words = SplitElementString(std::string(element));
 
     // Requires 4 words (keyword, u, v, w)
@@ -584,7 +865,7 @@ bool WaveFrontObjParser::ParseTextureCoordinate(
  * @return true if parsing succeeds; false if the line is malformed.
  */
 bool WaveFrontObjParser::ParseUseMaterial(std::string_view element,
-                                          std::string* material) {
+                                          std::string* material) const {
     auto words = SplitElementString(std::string(element));
 
     if (words.size() != 2) {
@@ -597,12 +878,53 @@ bool WaveFrontObjParser::ParseUseMaterial(std::string_view element,
     return true;
 }
 
+/**
+ * Parses an 's' line from a Wavefront .obj file and extracts the smoothing
+ * group number.
+ *
+ * Expects the 's' keyword followed by a group number, 'on' or 'off'. Both
+ * 'off' and 0 switch smoothing off, and 'on' selects group 1. Exporters
+ * write other forms too, so a missing or unrecognised value is logged as
+ * a warning and switches smoothing off rather than failing the parse.
+ *
+ * @param element The line from the .obj file (e.g., "s 1" or "s off").
+ * @param smoothingGroup Pointer to where the group number will be stored.
+ * @return true, as every smoothing group line is accepted.
+ */
+bool WaveFrontObjParser::ParseSmoothingGroup(
+    std::string_view element, unsigned int *smoothingGroup) const {
+    auto words = SplitElementString(std::string(element));
+    int group = 0;
+
+    if (words.size() == 2 && words[1] == "off") {
+        *smoothingGroup = 0;
+        return true;
+    }
+
+    if (words.size() == 2 && words[1] == "on") {
+        *smoothingGroup = 1;
+        return true;
+    }
+
+    if (words.size() != 2 || !ParseInt(words[1].c_str(), &group) ||
+        group < 0) {
+        LOG(Logger::LogLevel::Warning, std::format(
+            "Smoothing group '{}' is invalid, smoothing is switched off",
+            element));
+        group = 0;
+    }
+
+    *smoothingGroup = static_cast<unsigned int>(group);
+    return true;
+}
+
 /**
  * Finalises the mesh by converting face data into vertex attributes.
  *
  * This function populates the mesh's vertex list using face indices and the
  * provided lists of positions, normals, and texture coordinates. Returns
- * false if any indices are out of bounds or the mesh is null.
+ * false if any indices are out of bounds or the mesh is null. The mesh
+ * bounds are computed once its vertices are in place.
  *
  * @param mesh Pointer to the mesh to populate.
  * @param positions List of 4D vertex positions.
@@ -614,7 +936,7 @@ bool WaveFrontObjParser::FinaliseVertices(
     Mesh *mesh,
     const Point4DList& positions,
     const Point3DList& normals,
-    const TextureCoordinatesList& textureCoordinates) {
+    const TextureCoordinatesList& textureCoordinates) const {
 
     LOG(Logger::LogLevel::Debug, std::format("Finalizing mesh '{}'",
                                              mesh->name));
@@ -660,6 +982,8 @@ bool WaveFrontObjParser::FinaliseVertices(
         }
     }
 
+    mesh->UpdateBounds();
+
     return true;
 }
 
@@ -24,6 +24,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "Structures.h"
 #include "Mesh.h"
 #include "Model.h"
+#include "ParseContext.h"
+#include "ParseOptions.h"
+#include "ParseStats.h"
 
 namespace Meshborn {
 
@@ -31,37 +34,63 @@ class WaveFrontObjParser : public BaseWavefrontParser {
  public:
     WaveFrontObjParser();
 
+    explicit WaveFrontObjParser(const ParseOptions& options);
+
     std::unique_ptr<Model> ParseObj(std::string filename);
 
+    // Parses with the options, logger, statistics and buffers of a context
+    // instead of the parser's own. Safe to call from several threads at
+    // once, each with its own context.
+    std::unique_ptr<Model> ParseObj(std::string filename,
+                                    ParseContext *context) const;
+
+    // Statistics of the last ParseObj(filename) call, see ParseStats.
+    const ParseStats& GetStats() const { return context_.stats; }
+
+    // Sets the high-water mark of the buffers kept between ParseObj calls,
+    // see ParseContext::bufferLimit.
+    void SetBufferLimit(size_t bytes) { context_.bufferLimit = bytes; }
+
  private:
+    // Times the private parsing functions in isolation.
+    friend class ParserMicroBenchmark;
+
      bool ParseGroupElement(std::string_view element,
-                            std::string* face);
+                            std::string* face) const;
 
     bool ParseObjectElement(std::string_view element,
-                            std::string* face);
+                            std::string* face) const;
 
     bool ParseVectorElement(std::string_view element,
-                            Point4D* vectorElement);
+                            Point4D* vectorElement) const;
 
     bool ParsePolygonalFaceElement(std::string_view element,
-                                   PolygonalFace* face);
+                                   PolygonalFace* face) const;
 
     bool ParseVertexNormalElement(std::string_view element,
-                                  Point3D* vectorNormalElement);
+                                  Point3D* vectorNormalElement) const;
 
     bool ParseMaterials(std::string_view element,
-                        std::string *materialLibrary);
+                        std::string *materialLibrary) const;
 
     bool ParseTextureCoordinate(std::string_view element,
-                                TextureCoordinates *coordinates);
+                                TextureCoordinates *coordinates) const;
 
     bool ParseUseMaterial(std::string_view element,
-                          std::string *material);
+                          std::string *material) const;
+
+    bool ParseSmoothingGroup(std::string_view element,
+                             unsigned int *smoothingGroup) const;
+
+    bool FinaliseVertices(
+        Mesh *mesh,
+        const Point4DList& positions,
+        const Point3DList& normals,
+        const TextureCoordinatesList& textureCoordinates) const;
 
-    bool FinaliseVertices(Mesh *mesh,
-                          const Point4DList& positions,
-                          const Point3DList& normals,
-                          const TextureCoordinatesList& textureCoordinates);
+    // Options, statistics and buffers of ParseObj(filename), kept so
+    // that a parser reused for many files reuses its memory.
+    ParseContext context_;
 };
 
 }   // namespace Meshborn